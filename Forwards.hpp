@@ -276,6 +276,7 @@ namespace Indexing
 {
 class Index;
 class IndexManager;
+struct IndexStatistics;
 class LiteralIndex;
 class LiteralIndexingStructure;
 class TermIndex;
@@ -306,6 +307,7 @@ class ClauseCodeTree;
 class CodeTreeTIS;
 class CodeTreeLIS;
 class CodeTreeSubsumptionIndex;
+class FeatureVectorIndex;
 
 class ArithmeticIndex;
 class ConstraintDatabase;
@@ -324,6 +326,8 @@ typedef Lib::SmartPtr<PassiveClauseContainer> PassiveClauseContainerSP;
 
 class ActiveClauseContainer;
 
+class ClauseRecipe;
+
 class Splitter;
 class ConsequenceFinder;
 class LabelFinder;
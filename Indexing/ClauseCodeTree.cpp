@@ -62,17 +62,40 @@ ClauseCodeTree::ClauseCodeTree()
 {
   _clauseCodeTree=true;
   _onCodeOpDestroying = onCodeOpDestroying;
+  _onPostponedModification = onPostponedModification;
 #if VDEBUG
   _clauseMatcherCounter=0;
 #endif
 }
 
+/**
+ * Perform the insertion or removal of the clause @b obj
+ * postponed while there were readers
+ */
+void ClauseCodeTree::onPostponedModification(CodeTree* tree, void* obj, bool insert)
+{
+  CALL("ClauseCodeTree::onPostponedModification");
+
+  ClauseCodeTree* cct=static_cast<ClauseCodeTree*>(tree);
+  Clause* cl=static_cast<Clause*>(obj);
+  if(insert) {
+    cct->insert(cl);
+  }
+  else {
+    cct->remove(cl);
+  }
+}
+
 //////////////// insertion ////////////////////
 
 void ClauseCodeTree::insert(Clause* cl)
 {
   CALL("ClauseCodeTree::insert");
 
+  if(postponeModification(cl, true)) {
+    return;
+  }
+
   unsigned clen=cl->length();
   static DArray<Literal*> lits;
   lits.initFromArray(clen, *cl);
@@ -241,6 +264,10 @@ void ClauseCodeTree::remove(Clause* cl)
 {
   CALL("ClauseCodeTree::remove");
 
+  if(postponeModification(cl, false)) {
+    return;
+  }
+
   static DArray<LitInfo> lInfos;
   static Stack<CodeOp*> firstsInBlocks;
   static Stack<RemovingLiteralMatcher*> rlms;
@@ -257,6 +284,7 @@ void ClauseCodeTree::remove(Clause* cl)
       ASSERTION_VIOLATION;
       INVALID_OPERATION("empty clause to be removed was not found");
     }
+    compactAfterRemoval();
     return;
   }
 
@@ -315,6 +343,7 @@ void ClauseCodeTree::remove(Clause* cl)
   for(unsigned i=0;i<clen;i++) {
     lInfos[i].dispose();
   }
+  compactAfterRemoval();
 }
 
 void ClauseCodeTree::RemovingLiteralMatcher::init(CodeOp* entry_, LitInfo* linfos_,
@@ -515,6 +544,7 @@ void ClauseCodeTree::ClauseMatcher::init(ClauseCodeTree* tree_, Clause* query_,
   ASS_EQ(tree->_clauseMatcherCounter,0);
   tree->_clauseMatcherCounter++;
 #endif
+  tree->readerStarted();
 
   //init LitInfo records
   unsigned clen=query->length();
@@ -585,6 +615,7 @@ void ClauseCodeTree::ClauseMatcher::deinit()
   ASS_EQ(tree->_clauseMatcherCounter,1);
   tree->_clauseMatcherCounter--;
 #endif
+  tree->readerFinished();
 }
 
 /**
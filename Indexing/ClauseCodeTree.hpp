@@ -45,6 +45,7 @@ class ClauseCodeTree : public CodeTree
 {
 protected:
   static void onCodeOpDestroying(CodeOp* op);
+  static void onPostponedModification(CodeTree* tree, void* obj, bool insert);
   
 public:
   ClauseCodeTree();
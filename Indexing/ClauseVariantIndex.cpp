@@ -29,6 +29,7 @@
 #include "Kernel/Clause.hpp"
 #include "Kernel/LiteralComparators.hpp"
 #include "Kernel/MLVariant.hpp"
+#include "Kernel/Matcher.hpp"
 #include "Kernel/Term.hpp"
 
 #include "LiteralMiniIndex.hpp"
@@ -558,4 +559,205 @@ unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned
 }
 
 
+//-------------------//-------------------//-------------------//-------------------
+//-------------------//-------------------//-------------------//-------------------
+
+void FingerprintClauseVariantIndex::insert(Clause* cl)
+{
+  CALL("FingerprintClauseVariantIndex::insert");
+
+  TimeCounter tc(TC_HCVI_INSERT);
+
+  Fingerprint fp=fingerprint(cl->literals(), cl->length());
+  if(2*(_size+1)>_table.size()) {
+    grow();
+  }
+  size_t mask=_table.size()-1;
+  size_t pos=fp&mask;
+  while(_table[pos].clause) {
+    pos=(pos+1)&mask;
+  }
+  _table[pos]=Entry(fp, cl);
+  _size++;
+}
+
+ClauseIterator FingerprintClauseVariantIndex::retrieveVariants(Literal* const * lits, unsigned length)
+{
+  CALL("FingerprintClauseVariantIndex::retrieveVariants/2");
+
+  TimeCounter tc(TC_HCVI_RETRIEVE);
+
+  if(!_size) {
+    return ClauseIterator::getEmpty();
+  }
+
+  Fingerprint fp=fingerprint(lits, length);
+  size_t mask=_table.size()-1;
+  ClauseList* res=0;
+  for(size_t pos=fp&mask; _table[pos].clause; pos=(pos+1)&mask) {
+    if(_table[pos].fingerprint!=fp) {
+      continue;
+    }
+    //only the clauses with equal fingerprints are checked to be variants
+    Clause* cl=_table[pos].clause;
+    if(cl->length()!=length) {
+      continue;
+    }
+    if(length==1 ? MatchingUtils::isVariant(lits[0], (*cl)[0]) : MLVariant::isVariant(lits, cl)) {
+      ClauseList::push(cl, res);
+    }
+  }
+  if(!res) {
+    return ClauseIterator::getEmpty();
+  }
+  return pvi( getPersistentIterator(ClauseList::DestructiveIterator(res)) );
+}
+
+/**
+ * Double the capacity of the table and insert the clauses again
+ */
+void FingerprintClauseVariantIndex::grow()
+{
+  CALL("FingerprintClauseVariantIndex::grow");
+
+  static Stack<Entry> entries;
+  entries.reset();
+  for(size_t i=0;i<_table.size();i++) {
+    if(_table[i].clause) {
+      entries.push(_table[i]);
+    }
+  }
+
+  _table.init(max(static_cast<size_t>(16), 2*_table.size()), Entry());
+  size_t mask=_table.size()-1;
+  while(entries.isNonEmpty()) {
+    Entry e=entries.pop();
+    size_t pos=e.fingerprint&mask;
+    while(_table[pos].clause) {
+      pos=(pos+1)&mask;
+    }
+    _table[pos]=e;
+  }
+}
+
+/**
+ * Return the fingerprint of the clause with literals @b lits.
+ *
+ * The fingerprint is the sum of hashes of the literals and of the
+ * numbers of occurrences of each variable, so it depends on neither
+ * the order of the literals nor the names of the variables. A literal's
+ * hash is computed with its variables numbered by first occurrence.
+ */
+FingerprintClauseVariantIndex::Fingerprint FingerprintClauseVariantIndex::fingerprint(Literal* const * lits, unsigned length)
+{
+  CALL("FingerprintClauseVariantIndex::fingerprint");
+
+  TimeCounter tc(TC_HCVI_COMPUTE_HASH);
+
+  static Stack<pair<unsigned,unsigned> > varCnts;
+  varCnts.reset();
+
+  Fingerprint res=mix(length);
+  for(unsigned i=0;i<length;i++) {
+    Literal* lit=lits[i];
+    Fingerprint litFp=literalFingerprint(lit, false, &varCnts);
+    if(lit->isEquality() && !lit->ground()) {
+      litFp=min(litFp, literalFingerprint(lit, true, 0));
+    }
+    res+=mix(litFp);
+  }
+
+  for(unsigned i=0;i<varCnts.size();i++) {
+    //distinguished from the literal hashes by the top bit
+    res+=mix(varCnts[i].second | (1ull<<63));
+  }
+  return res;
+}
+
+/**
+ * Hash of @b lit with its arguments taken in the reverse order
+ * if @b reversed is true. If @b varCnts is nonzero, the occurrences
+ * of variables are counted in it.
+ */
+FingerprintClauseVariantIndex::Fingerprint FingerprintClauseVariantIndex::literalFingerprint(Literal* lit, bool reversed,
+    Stack<pair<unsigned,unsigned> >* varCnts)
+{
+  CALL("FingerprintClauseVariantIndex::literalFingerprint");
+
+  if(lit->ground()) {
+    //shared ground literals are equal iff they are the same object
+    return mix(reinterpret_cast<size_t>(lit));
+  }
+
+  static Stack<unsigned> vars;
+  vars.reset();
+
+  Fingerprint h=mix(lit->header());
+  if(reversed) {
+    ASS_EQ(lit->arity(),2);
+    h=termFingerprint(lit->nthArgument(1), h, vars, varCnts);
+    h=termFingerprint(lit->nthArgument(0), h, vars, varCnts);
+  } else {
+    for(TermList* arg=lit->args(); arg->isNonEmpty(); arg=arg->next()) {
+      h=termFingerprint(arg, h, vars, varCnts);
+    }
+  }
+  return h;
+}
+
+/**
+ * Extend the hash @b h by the term @b t. The variables met so far in
+ * the literal are in @b vars, numbered by their positions. If @b varCnts
+ * is nonzero, the occurrences of variables are counted in it.
+ */
+FingerprintClauseVariantIndex::Fingerprint FingerprintClauseVariantIndex::termFingerprint(TermList* t, Fingerprint h,
+    Stack<unsigned>& vars, Stack<pair<unsigned,unsigned> >* varCnts)
+{
+  if(t->isVar()) {
+    unsigned var=t->var();
+    unsigned num=0;
+    while(num<vars.size() && vars[num]!=var) {
+      num++;
+    }
+    if(num==vars.size()) {
+      vars.push(var);
+    }
+    if(varCnts) {
+      unsigned i=0;
+      while(i<varCnts->size() && (*varCnts)[i].first!=var) {
+        i++;
+      }
+      if(i==varCnts->size()) {
+        varCnts->push(make_pair(var,0u));
+      }
+      (*varCnts)[i].second++;
+    }
+    return mix(h+((num<<2)|1));
+  }
+
+  Term* trm=t->term();
+  if(trm->ground()) {
+    return mix(h+reinterpret_cast<size_t>(trm));
+  }
+  h=mix(h+((trm->functor()<<2)|2));
+  for(TermList* arg=trm->args(); arg->isNonEmpty(); arg=arg->next()) {
+    h=termFingerprint(arg, h, vars, varCnts);
+  }
+  return h;
+}
+
+/**
+ * The finalizer of the SplitMix64 generator, a bijection on 64-bit
+ * values whose every output bit depends on all input bits
+ */
+FingerprintClauseVariantIndex::Fingerprint FingerprintClauseVariantIndex::mix(Fingerprint h)
+{
+  h^=h>>30;
+  h*=0xbf58476d1ce4e5b9ull;
+  h^=h>>27;
+  h*=0x94d049bb133111ebull;
+  h^=h>>31;
+  return h;
+}
+
 }
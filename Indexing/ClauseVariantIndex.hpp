@@ -28,8 +28,10 @@
 #include "Forwards.hpp"
 
 #include "Lib/Array.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/List.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
 
 namespace Indexing {
 
@@ -128,6 +130,55 @@ private:
   DHMap<unsigned, ClauseList*> _entries;
 };
 
+/**
+ * Clause variant index keyed by 64-bit fingerprints of the clauses.
+ *
+ * The fingerprint of a clause does not change when its variables are
+ * renamed or its literals reordered, so variants have equal fingerprints.
+ * The clauses are kept in an open-addressing hash table with linear
+ * probing, and only the clauses with the fingerprint of the query are
+ * checked to be its variants.
+ */
+class FingerprintClauseVariantIndex : public ClauseVariantIndex
+{
+public:
+  CLASS_NAME(FingerprintClauseVariantIndex);
+  USE_ALLOCATOR(FingerprintClauseVariantIndex);
+
+  FingerprintClauseVariantIndex() : _size(0) {}
+
+  virtual void insert(Clause* cl) override;
+
+  ClauseIterator retrieveVariants(Literal* const * lits, unsigned length) override;
+
+  typedef unsigned long long Fingerprint;
+
+  static Fingerprint fingerprint(Literal* const * lits, unsigned length);
+
+private:
+  struct Entry
+  {
+    Entry() : fingerprint(0), clause(0) {}
+    Entry(Fingerprint fp, Clause* cl) : fingerprint(fp), clause(cl) {}
+
+    Fingerprint fingerprint;
+    /** The clause, zero if the slot is free */
+    Clause* clause;
+  };
+
+  static Fingerprint mix(Fingerprint h);
+  static Fingerprint literalFingerprint(Literal* lit, bool reversed, Stack<pair<unsigned,unsigned> >* varCnts);
+  static Fingerprint termFingerprint(TermList* t, Fingerprint h, Stack<unsigned>& vars,
+      Stack<pair<unsigned,unsigned> >* varCnts);
+
+  void grow();
+
+  /** The table, its capacity is zero or a power of two */
+  DArray<Entry> _table;
+  /** Number of clauses in the table */
+  unsigned _size;
+};
+
 };
 
 #endif /* __ClauseVariantIndex__ */
@@ -27,6 +27,7 @@
 
 #include "Lib/BitUtils.hpp"
 #include "Lib/Comparison.hpp"
+#include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Portability.hpp"
 #include "Lib/Sort.hpp"
@@ -36,10 +37,23 @@
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
 
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
 #include "CodeTree.hpp"
 
 #define GROUND_TERM_CHECK 0
 
+/**
+ * The threaded interpreter needs labels as values, a GNU extension
+ * (supported also by clang and the Intel compiler)
+ */
+#ifdef __GNUC__
+#define THREADED_DISPATCH 1
+#else
+#define THREADED_DISPATCH 0
+#endif
+
 #undef RSTAT_COLLECTION
 #define RSTAT_COLLECTION 0
 
@@ -349,6 +363,7 @@ CodeTree::CodeOp CodeTree::CodeOp::getTermOp(InstructionSuffix i, unsigned num)
   res.setAlternative(0);
   res.setLongInstr(i);
   res.setArg(num);
+  ASS_EQ(res.opcode(), static_cast<unsigned>(SUFFIX_INSTR|(i<<2)));
   return res;
 }
 
@@ -633,13 +648,18 @@ inline bool CodeTree::BaseMatcher::doCheckGroundTerm()
 //////////////// auxiliary ////////////////////
 
 CodeTree::CodeTree()
-: _onCodeOpDestroying(0), _curTimeStamp(0), _maxVarCnt(1), _entryPoint(0)
+: _onCodeOpDestroying(0), _onPostponedModification(0),
+  _threadedDispatch(THREADED_DISPATCH && env.options->threadedCodeTrees()),
+  _curTimeStamp(0), _maxVarCnt(1), _entryPoint(0), _readerCnt(0),
+  _blockCnt(0), _deadBlockCnt(0), _compactionRatio(env.options->codeTreeCompactionRatio()),
+  _compacting(false)
 {
 }
 
 CodeTree::~CodeTree()
 {
   CALL("CodeTree::~CodeTree");
+  ASS_EQ(_readerCnt,0);
       
   static Stack<CodeOp*> top_ops; 
   // each top_op is either a first op of a Block or a SearchStruct
@@ -680,6 +700,9 @@ CodeTree::~CodeTree()
       cb->deallocate();
     }
   }
+
+  env.statistics->codeTreeBlocks-=_blockCnt;
+  env.statistics->codeTreeDeadBlocks-=_deadBlockCnt;
 }
 
 /**
@@ -747,6 +770,25 @@ void CodeTree::visitAllOps(Visitor visitor)
   }
 }
 
+/**
+ * Return the memory taken by the operations of the tree and the
+ * arrays of its search structures
+ */
+size_t CodeTree::memoryUsage()
+{
+  CALL("CodeTree::memoryUsage");
+
+  size_t res=0;
+  visitAllOps([&res](CodeOp* op) {
+    res+=sizeof(CodeOp);
+    if(op->isSearchStruct()) {
+      FixedSearchStruct* ss=static_cast<FixedSearchStruct*>(op->getSearchStruct());
+      res+=ss->length*(sizeof(CodeOp*)+sizeof(void*));
+    }
+  });
+  return res;
+}
+
 //////////////// insertion ////////////////////
 
 void CodeTree::CompileContext::init()
@@ -892,6 +934,8 @@ void CodeTree::incorporate(CodeStack& code)
 
   if(isEmpty()) {
     _entryPoint=buildBlock(code, code.length(), 0);
+    _blockCnt++;
+    env.statistics->codeTreeBlocks++;
     code.reset();
     return;
   }
@@ -1002,6 +1046,8 @@ matching_done:
 
   CodeBlock* rem=buildBlock(code, clen-matchedCnt, lastMatchedILS);
   *tailTarget=&(*rem)[0];
+  _blockCnt++;
+  env.statistics->codeTreeBlocks++;
   LOG_OP(rem->toString()<<" incorporated, mismatch caused by "<<code[matchedCnt].toString());
 
   //truncate the part that was used and thus does not need disposing
@@ -1020,6 +1066,10 @@ void CodeTree::compressCheckOps(CodeOp* chainStart, SearchStruct::Kind kind)
   CALL("CodeTree::compressCheckOps");
   ASS(chainStart->alternative());
 
+  //SearchStructs merged into the new one are destroyed, and some of them
+  //may be waiting to be visited by the compaction
+  abortCompaction();
+
   static Stack<CodeOp*> toDo;
   static Stack<CodeOp*> chfOps;
   static Stack<CodeOp*> otherOps;
@@ -1116,6 +1166,8 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
     ASS_LE(firstOp, op);
     ASS_G(firstOp+firstOpToCodeBlock(firstOp)->length(), op);
 
+    bool wasDead=hasDeadTail(firstOp);
+
     while(op>firstOp && !op->alternative()) { ASS(!op->isSuccess()); op--; }
 
     ASS(!op->isSuccess());
@@ -1124,6 +1176,10 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
       ASS(op->alternative());
       //we only change the instruction, the alternative must remain unchanged
       op->makeFail();
+      if(!wasDead && hasDeadTail(firstOp)) {
+        _deadBlockCnt++;
+        env.statistics->codeTreeDeadBlocks++;
+      }
       return;
     }
     CodeOp* alt=firstOp->alternative();
@@ -1137,6 +1193,10 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
       //the first operation to fail.
       ASS_EQ(cb,_entryPoint);
       firstOp->makeFail();
+      if(!wasDead && hasDeadTail(firstOp)) {
+        _deadBlockCnt++;
+        env.statistics->codeTreeDeadBlocks++;
+      }
       return;
     }
 
@@ -1151,7 +1211,14 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
 	}
       }
     }
+    compactionBlockReleased(firstOp, alt);
     cb->deallocate(); //from now on we mustn't dereference firstOp
+    _blockCnt--;
+    env.statistics->codeTreeBlocks--;
+    if(wasDead) {
+      _deadBlockCnt--;
+      env.statistics->codeTreeDeadBlocks--;
+    }
 
     if(firstsInBlocks->isEmpty()) {
       ASS(!alt || !alt->isSearchStruct());
@@ -1191,6 +1258,7 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
       //if we're at this point, the SEARCH_STRUCT will be deleted
       firstOp=&ss->landingOp;
       alt=ss->landingOp.alternative();
+      compactionBlockReleased(firstOp, alt);
       ss->destroy();
 
       //now let's continue as if there wasn't any SEARCH_STRUCT operation:)
@@ -1236,6 +1304,195 @@ void CodeTree::optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp
   }
 }
 
+//////////// compaction //////////////
+
+/**
+ * Return true iff the CodeBlock starting at @b firstOp contains
+ * operations after a FAIL operation
+ *
+ * These operations can never be reached. They are left there by
+ * @b optimizeMemoryAfterRemoval(), which makes an operation with
+ * an alternative FAIL instead of releasing the code after it.
+ */
+bool CodeTree::hasDeadTail(CodeOp* firstOp)
+{
+  CALL("CodeTree::hasDeadTail");
+  ASS(!firstOp->isSearchStruct());
+
+  CodeBlock* cb=firstOpToCodeBlock(firstOp);
+  size_t len=cb->length();
+  for(size_t i=0;i+1<len;i++) {
+    if((*cb)[i].isFail()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Start a compaction if the tree has too many blocks with dead tails,
+ * and do a slice of the compaction in progress
+ *
+ * The compaction replaces each such block by a copy without the
+ * unreachable operations. It visits the tree from the entry point in
+ * slices of bounded size, one after each removal, so that no removal
+ * is delayed by much. The operations that can be reached stay the same,
+ * so the compaction does not change the results of retrieval.
+ *
+ * Must be called only when there are no readers.
+ */
+void CodeTree::compactAfterRemoval()
+{
+  CALL("CodeTree::compactAfterRemoval");
+  ASS_EQ(_readerCnt,0);
+
+  if(!_compacting) {
+    //small trees are not worth the trouble
+    static const unsigned minDeadBlocks=64;
+    if(!_compactionRatio || _deadBlockCnt<minDeadBlocks ||
+	_deadBlockCnt<=_compactionRatio*(_blockCnt-_deadBlockCnt)) {
+      return;
+    }
+    ASS(!isEmpty());
+    _compacting=true;
+    _compactionToDo.reset();
+    CodeOp* entry=getEntryPoint();
+    compactTarget(entry);
+    _entryPoint=firstOpToCodeBlock(entry);
+    _compactionToDo.push(entry);
+  }
+  compactionSlice();
+}
+
+/**
+ * Visit a bounded number of blocks and SearchStructs of the compaction
+ * in progress, compacting the blocks they point to
+ */
+void CodeTree::compactionSlice()
+{
+  CALL("CodeTree::compactionSlice");
+  ASS(_compacting);
+
+  static const unsigned sliceLength=64;
+
+  for(unsigned visited=0; visited<sliceLength; visited++) {
+    if(_compactionToDo.isEmpty()) {
+      _compacting=false;
+      env.statistics->codeTreeCompactions++;
+      return;
+    }
+    CodeOp* top=_compactionToDo.pop();
+
+    if(top->isSearchStruct()) {
+      FixedSearchStruct* ss=static_cast<FixedSearchStruct*>(top->getSearchStruct());
+      ASS(ss->isFixedSearchStruct());
+      for(size_t i=0;i<ss->length;i++) {
+	if(ss->targets[i]) {
+	  compactTarget(ss->targets[i]);
+	  _compactionToDo.push(ss->targets[i]);
+	}
+      }
+      if(top->alternative()) {
+	compactTarget(top->alternative());
+	_compactionToDo.push(top->alternative());
+      }
+      continue;
+    }
+
+    CodeBlock* cb=firstOpToCodeBlock(top);
+    size_t len=cb->length();
+    for(size_t i=0;i<len;i++) {
+      CodeOp& op=(*cb)[i];
+      if(op.alternative()) {
+	compactTarget(op.alternative());
+	_compactionToDo.push(op.alternative());
+      }
+    }
+  }
+}
+
+/**
+ * If @b target points to a block with a dead tail, replace the block
+ * by a copy without the tail and make @b target point to the copy
+ */
+void CodeTree::compactTarget(CodeOp*& target)
+{
+  CALL("CodeTree::compactTarget");
+
+  if(target->isSearchStruct() || !hasDeadTail(target)) {
+    return;
+  }
+
+  CodeBlock* cb=firstOpToCodeBlock(target);
+  size_t len=cb->length();
+  size_t liveLen=0;
+  while(!(*cb)[liveLen].isFail()) {
+    liveLen++;
+  }
+  liveLen++;
+  ASS_L(liveLen,len);
+
+  CodeBlock* res=CodeBlock::allocate(liveLen);
+  for(size_t i=0;i<liveLen;i++) {
+    (*res)[i]=(*cb)[i];
+  }
+  for(size_t i=liveLen;i<len;i++) {
+    CodeOp* op=&(*cb)[i];
+    //nothing can hang on the unreachable operations
+    ASS(!op->alternative());
+    ASS(!op->isSuccess());
+    if(_onCodeOpDestroying) {
+      (*_onCodeOpDestroying)(op);
+    }
+  }
+  cb->deallocate();
+  target=&(*res)[0];
+
+  _deadBlockCnt--;
+  env.statistics->codeTreeDeadBlocks--;
+  env.statistics->codeTreeCompactedBlocks++;
+}
+
+/**
+ * Called before the CodeBlock or SearchStruct starting at @b firstOp is
+ * released by a removal and replaced in the tree by its alternative
+ * @b alt, so that the compaction in progress does not visit it
+ */
+void CodeTree::compactionBlockReleased(CodeOp* firstOp, CodeOp* alt)
+{
+  CALL("CodeTree::compactionBlockReleased");
+
+  if(!_compacting) {
+    return;
+  }
+  for(size_t i=0;i<_compactionToDo.size();i++) {
+    if(_compactionToDo[i]!=firstOp) {
+      continue;
+    }
+    if(alt) {
+      //the alternative was not visited as it is reached only through firstOp
+      _compactionToDo[i]=alt;
+    }
+    else {
+      _compactionToDo[i]=_compactionToDo.top();
+      _compactionToDo.pop();
+    }
+    return;
+  }
+}
+
+/**
+ * Give up the compaction in progress, if there is one
+ *
+ * This is done when SearchStructs are rebuilt, as the compaction
+ * might be about to visit some of those that are destroyed.
+ */
+void CodeTree::abortCompaction()
+{
+  _compacting=false;
+  _compactionToDo.reset();
+}
+
 void CodeTree::RemovingMatcher::init(CodeOp* entry_, LitInfo* linfos_,
     size_t linfoCnt_, CodeTree* tree_, Stack<CodeOp*>* firstsInBlocks_)
 {
@@ -1438,6 +1695,45 @@ void CodeTree::incTimeStamp()
   }
 }
 
+/**
+ * If there are matchers retrieving from the tree, record the insertion
+ * (if @b insert is true) or removal of @b obj to be performed when the
+ * last of them finishes and return true; otherwise return false.
+ *
+ * This way each matcher traverses the version of the tree at the time
+ * it was initialized, and no code it can still reach is released.
+ */
+bool CodeTree::postponeModification(void* obj, bool insert)
+{
+  CALL("CodeTree::postponeModification");
+
+  if(!_readerCnt) {
+    return false;
+  }
+  _postponed.push(std::make_pair(obj, insert));
+  return true;
+}
+
+/**
+ * Unregister a matcher, and if it was the last one, perform
+ * the postponed insertions and removals in their order
+ */
+void CodeTree::readerFinished()
+{
+  CALL("CodeTree::readerFinished");
+  ASS_G(_readerCnt,0);
+
+  _readerCnt--;
+  if(_readerCnt || _postponed.isEmpty()) {
+    return;
+  }
+  ASS(_onPostponedModification);
+  for(unsigned i=0;i<_postponed.size();i++) {
+    _onPostponedModification(this, _postponed[i].first, _postponed[i].second);
+  }
+  _postponed.reset();
+}
+
 void CodeTree::Matcher::init(CodeTree* tree_, CodeOp* entry_)
 {
   CALL("CodeTree::Matcher::init");
@@ -1452,9 +1748,22 @@ void CodeTree::Matcher::init(CodeTree* tree_, CodeOp* entry_)
   bindings.ensure(tree->_maxVarCnt);
 }
 
+/**
+ * Execute the code until a LIT_END operation or a yielded SUCCESS
+ * operation is reached, and return true, or until there is nothing
+ * more to try, and return false.
+ */
 bool CodeTree::Matcher::execute()
 {
-  CALL("CodeTree::Matcher::execute");
+  if(tree->_threadedDispatch) {
+    return executeThreaded();
+  }
+  return executeSwitch();
+}
+
+bool CodeTree::Matcher::executeSwitch()
+{
+  CALL("CodeTree::Matcher::executeSwitch");
 
   if(_fresh) {
     _fresh=false;
@@ -1532,6 +1841,131 @@ bool CodeTree::Matcher::execute()
   }
 }
 
+/**
+ * The same as executeSwitch(), but each operation jumps directly to
+ * the code of the next one, through a table indexed by CodeOp::opcode().
+ *
+ * The operations of a CodeBlock follow each other in memory, so apart
+ * from the SEARCH_STRUCT operations and backtracking, the code is
+ * executed in one pass over an array, and the indirect jump after each
+ * operation is predicted separately for each kind of operation. The
+ * current operation and position in the flat term are kept in local
+ * variables, and stored in @b op and @b tp only when the execution
+ * stops or backtracks.
+ */
+bool CodeTree::Matcher::executeThreaded()
+{
+  CALL("CodeTree::Matcher::executeThreaded");
+
+#if THREADED_DISPATCH
+  static void* const dispatch[16] = {
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkFun,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&assignVar,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkVar,
+    &&successOrFail, &&checkGroundTerm, &&litEnd, &&searchStruct
+  };
+
+  CodeOp* cop;
+  size_t pos;
+  const FlatTerm::Entry* fte;
+
+#define DISPATCH \
+  if(cop->alternative()) { \
+    btStack.push(BTPoint(pos, cop->alternative())); \
+  } \
+  goto *dispatch[cop->opcode()]
+
+  if(_fresh) {
+    _fresh=false;
+  }
+  else if(!backtrack()) {
+    return false;
+  }
+  cop=op;
+  pos=tp;
+  DISPATCH;
+
+successOrFail:
+  //yield successes only in the first round (we don't want to yield the
+  //same thing for each query literal)
+  if(!cop->isFail() && curLInfo==0) {
+    op=cop;
+    tp=pos;
+    return true;
+  }
+  goto fail;
+litEnd:
+  op=cop;
+  tp=pos;
+  return true;
+checkGroundTerm:
+  fte=&(*ft)[pos];
+  if(!fte->isFun() || fte[1].ptr()!=cop->getTargetTerm()) {
+    goto fail;
+  }
+  ASS_EQ(fte[2].tag(), FlatTerm::FUN_RIGHT_OFS);
+  pos+=fte[2].number();
+  cop++;
+  DISPATCH;
+checkFun:
+  if(!(*ft)[pos].isFun(cop->arg())) {
+    goto fail;
+  }
+  pos+=FlatTerm::functionEntryCount;
+  cop++;
+  DISPATCH;
+assignVar:
+  fte=&(*ft)[pos];
+  if(fte->tag()==FlatTerm::VAR) {
+    bindings[cop->arg()]=TermList(fte->number(),false);
+    pos++;
+  }
+  else {
+    ASS_EQ(fte->tag(), FlatTerm::FUN);
+    ASS_EQ(fte[1].tag(), FlatTerm::FUN_TERM_PTR);
+    bindings[cop->arg()]=TermList(fte[1].ptr());
+    pos+=fte[2].number();
+  }
+  cop++;
+  DISPATCH;
+checkVar:
+  fte=&(*ft)[pos];
+  if(fte->tag()==FlatTerm::VAR) {
+    if(bindings[cop->arg()]!=TermList(fte->number(),false)) {
+      goto fail;
+    }
+    pos++;
+  }
+  else {
+    ASS_EQ(fte->tag(), FlatTerm::FUN);
+    ASS_EQ(fte[1].tag(), FlatTerm::FUN_TERM_PTR);
+    if(bindings[cop->arg()]!=TermList(fte[1].ptr())) {
+      goto fail;
+    }
+    pos+=fte[2].number();
+  }
+  cop++;
+  DISPATCH;
+searchStruct:
+  cop=cop->getSearchStruct()->getTargetOp(&(*ft)[pos]);
+  if(!cop) {
+    goto fail;
+  }
+  DISPATCH;
+fail:
+  if(!backtrack()) {
+    return false;
+  }
+  cop=op;
+  pos=tp;
+  DISPATCH;
+
+#undef DISPATCH
+#else
+  return executeSwitch();
+#endif
+}
+
 /**
  * Is called when we need to retrieve a new result.
  * It does not only backtrack to the next alternative to try,
@@ -24,6 +24,8 @@
 #ifndef __CodeTree__
 #define __CodeTree__
 
+#include <utility>
+
 #include "Forwards.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -66,6 +68,14 @@ protected:
   * (the details are expected to be descendant specific)
   */
   void (*_onCodeOpDestroying)(CodeOp* op);
+
+  /**
+  * When the last reader of the tree finishes,
+  * onPostponedModification is called on each insertion
+  * or removal of the object @b obj postponed while there
+  * were readers (the object is descendant specific)
+  */
+  void (*_onPostponedModification)(CodeTree* tree, void* obj, bool insert);
       
 public:
   CodeTree();
@@ -224,6 +234,14 @@ public:
 
     SearchStruct* getSearchStruct();
 
+    /**
+     * Index of the operation in the dispatch table of the threaded
+     * interpreter: the instruction prefix is in the lowest two bits
+     * and, for SUFFIX_INSTR, the suffix in the next two (the other
+     * operations have bits of their pointers there)
+     */
+    inline unsigned opcode() const { return _data&15; }
+
     inline InstructionPrefix instrPrefix() const { return static_cast<InstructionPrefix>(_info.prefix); }
     inline InstructionSuffix instrSuffix() const
     {
@@ -397,6 +415,15 @@ public:
 
   void optimizeMemoryAfterRemoval(Stack<CodeOp*>* firstsInBlocks, CodeOp* removedOp);
 
+  //////////// compaction //////////////
+
+  static bool hasDeadTail(CodeOp* firstOp);
+  void compactAfterRemoval();
+  void compactionSlice();
+  void compactTarget(CodeOp*& target);
+  void compactionBlockReleased(CodeOp* firstOp, CodeOp* alt);
+  void abortCompaction();
+
   struct RemovingMatcher
   : public BaseMatcher
   {
@@ -486,6 +513,9 @@ public:
 
 
   private:
+    bool executeSwitch();
+    bool executeThreaded();
+
     bool backtrack();
     bool doSearchStruct();
     bool doCheckFun();
@@ -535,10 +565,21 @@ public:
 
   void incTimeStamp();
 
+  size_t memoryUsage();
+
+  //////// readers //////////
+
+  /** Register a matcher that retrieves from the tree */
+  inline void readerStarted() { _readerCnt++; }
+  void readerFinished();
+  bool postponeModification(void* obj, bool insert);
+
   //////// member variables //////////
 
 
   bool _clauseCodeTree;
+  /** Execute the code with the threaded interpreter instead of the switch one */
+  bool _threadedDispatch;
   unsigned _curTimeStamp;
 
   /** maximal number of local variables in a stored term/literal (always at least 1) */
@@ -546,6 +587,28 @@ public:
 
   CodeBlock* _entryPoint;
 
+  /** Number of matchers currently retrieving from the tree */
+  unsigned _readerCnt;
+  /** Insertions and removals postponed until there are no readers */
+  Stack<std::pair<void*,bool> > _postponed;
+
+  /** Number of CodeBlocks in the tree */
+  unsigned _blockCnt;
+  /**
+   * Number of CodeBlocks with operations after a FAIL operation
+   * (which removals leave there and which can never be reached)
+   */
+  unsigned _deadBlockCnt;
+  /** Compaction starts when _deadBlockCnt exceeds this multiple of the live blocks, zero means never */
+  float _compactionRatio;
+  /** True while a compaction is in progress */
+  bool _compacting;
+  /**
+   * First operations of CodeBlocks and landing operations of SearchStructs
+   * yet to be visited by the compaction in progress
+   */
+  Stack<CodeOp*> _compactionToDo;
+
 };
 
 }
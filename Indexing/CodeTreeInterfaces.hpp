@@ -58,6 +58,8 @@ public:
   TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
   bool generalizationExists(TermList t);
 
+  size_t memoryUsage() { return _ct.memoryUsage(); }
+
 #if VDEBUG
   virtual void markTagged(){ NOT_IMPLEMENTED; } 
 #endif
@@ -0,0 +1,832 @@
+/*
+ * File CompactSubstitutionTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompactSubstitutionTree.cpp
+ * Implements class CompactSubstitutionTree and the term and literal
+ * indexing structures that use it.
+ */
+
+#include "Lib/Metaiterators.hpp"
+
+#include "Kernel/Matcher.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "CompactSubstitutionTree.hpp"
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+#define QRS_QUERY_BANK 0
+#define QRS_RESULT_BANK 1
+
+void CompactSubstitutionTree::FlatKey::reset()
+{
+  symbols.reset();
+  arities.reset();
+  ends.reset();
+}
+
+/**
+ * Append the symbols of @b t in prefix order.
+ */
+void CompactSubstitutionTree::FlatKey::pushTerm(TermList t)
+{
+  CALL("CompactSubstitutionTree::FlatKey::pushTerm");
+
+  static Stack<TermList*> todo;
+  //positions of the unfinished terms and the numbers of their unfinished arguments
+  static Stack<unsigned> open;
+  static Stack<unsigned> remaining;
+  ASS(todo.isEmpty());
+  ASS(open.isEmpty());
+
+  todo.push(&t);
+  while(todo.isNonEmpty()) {
+    TermList* ts=todo.pop();
+    unsigned pos=symbols.size();
+    if(ts->isVar()) {
+      symbols.push(VAR_SYMBOL);
+      arities.push(0);
+      ends.push(pos+1);
+    }
+    else {
+      Term* trm=ts->term();
+      unsigned arity=trm->arity();
+      symbols.push(trm->functor()+1);
+      arities.push(arity);
+      ends.push(pos+1);
+      if(arity) {
+	open.push(pos);
+	remaining.push(arity);
+	for(unsigned i=arity; i>0; i--) {
+	  todo.push(trm->nthArgument(i-1));
+	}
+	continue;
+      }
+    }
+    //a subterm is finished, so are the terms whose last argument it was
+    while(open.isNonEmpty() && --remaining.top()==0) {
+      ends[open.pop()]=symbols.size();
+      remaining.pop();
+    }
+  }
+}
+
+/**
+ * Append the symbols of @b lit in prefix order. The top symbol is
+ * the header of the literal or of its complement. If @b reversed is
+ * true, the arguments of the binary literal are swapped.
+ */
+void CompactSubstitutionTree::FlatKey::pushLiteral(Literal* lit, bool complementary, bool reversed)
+{
+  CALL("CompactSubstitutionTree::FlatKey::pushLiteral");
+  ASS(!reversed || lit->arity()==2);
+
+  unsigned pos=symbols.size();
+  symbols.push((complementary ? lit->complementaryHeader() : lit->header())+1);
+  arities.push(lit->arity());
+  ends.push(0);
+  if(reversed) {
+    pushTerm(*lit->nthArgument(1));
+    pushTerm(*lit->nthArgument(0));
+  }
+  else {
+    for(unsigned i=0; i<lit->arity(); i++) {
+      pushTerm(*lit->nthArgument(i));
+    }
+  }
+  ends[pos]=symbols.size();
+}
+
+CompactSubstitutionTree::CompactSubstitutionTree()
+: _size(0)
+{
+  CALL("CompactSubstitutionTree::CompactSubstitutionTree");
+
+  ALWAYS(newNode(0)==0);
+}
+
+CompactSubstitutionTree::~CompactSubstitutionTree()
+{
+  CALL("CompactSubstitutionTree::~CompactSubstitutionTree");
+
+  Stack<Stack<LeafData>*>::Iterator lit(_leaves);
+  while(lit.hasNext()) {
+    delete lit.next();
+  }
+}
+
+/**
+ * Return the memory taken by the arrays of the tree and its leaves,
+ * counting only their used parts
+ */
+size_t CompactSubstitutionTree::memoryUsage() const
+{
+  CALL("CompactSubstitutionTree::memoryUsage");
+
+  size_t res=sizeof(CompactSubstitutionTree);
+  res+=(_arity.size()+_childStart.size()+_childCount.size()+_childCapacity.size()+_leaf.size())*sizeof(unsigned);
+  res+=(_childSymbols.size()+_childNodes.size())*sizeof(unsigned);
+  for(unsigned i=0;i<_leaves.size();i++) {
+    res+=sizeof(Stack<LeafData>*)+sizeof(Stack<LeafData>)+_leaves[i]->size()*sizeof(LeafData);
+  }
+  return res;
+}
+
+/** Binary logarithm of a power of two */
+static unsigned capacityClass(unsigned capacity)
+{
+  ASS_G(capacity,0);
+  ASS_EQ(capacity&(capacity-1),0);
+
+  unsigned res=0;
+  while(capacity>1) {
+    capacity>>=1;
+    res++;
+  }
+  return res;
+}
+
+/**
+ * Return the start of an unused block of the arena of size @b capacity.
+ */
+unsigned CompactSubstitutionTree::allocateBlock(unsigned capacity)
+{
+  CALL("CompactSubstitutionTree::allocateBlock");
+
+  Stack<unsigned>& free=_freeBlocks[capacityClass(capacity)];
+  if(free.isNonEmpty()) {
+    return free.pop();
+  }
+  unsigned res=_childSymbols.size();
+  for(unsigned i=0; i<capacity; i++) {
+    _childSymbols.push(0);
+    _childNodes.push(0);
+  }
+  return res;
+}
+
+void CompactSubstitutionTree::releaseBlock(unsigned start, unsigned capacity)
+{
+  _freeBlocks[capacityClass(capacity)].push(start);
+}
+
+unsigned CompactSubstitutionTree::newNode(unsigned arity)
+{
+  CALL("CompactSubstitutionTree::newNode");
+
+  if(_freeNodes.isNonEmpty()) {
+    unsigned res=_freeNodes.pop();
+    _arity[res]=arity;
+    _childStart[res]=0;
+    _childCount[res]=0;
+    _childCapacity[res]=0;
+    _leaf[res]=0;
+    return res;
+  }
+  unsigned res=_arity.size();
+  _arity.push(arity);
+  _childStart.push(0);
+  _childCount.push(0);
+  _childCapacity.push(0);
+  _leaf.push(0);
+  return res;
+}
+
+/**
+ * Return the child of @b node with top symbol @b symbol,
+ * or zero if there is none.
+ */
+unsigned CompactSubstitutionTree::findChild(unsigned node, unsigned symbol) const
+{
+  unsigned lo=_childStart[node];
+  unsigned hi=lo+_childCount[node];
+  while(lo<hi) {
+    unsigned mid=(lo+hi)/2;
+    unsigned s=_childSymbols[mid];
+    if(s==symbol) {
+      return _childNodes[mid];
+    }
+    if(s<symbol) {
+      lo=mid+1;
+    }
+    else {
+      hi=mid;
+    }
+  }
+  return 0;
+}
+
+unsigned CompactSubstitutionTree::getOrCreateChild(unsigned node, unsigned symbol, unsigned arity)
+{
+  CALL("CompactSubstitutionTree::getOrCreateChild");
+
+  unsigned start=_childStart[node];
+  unsigned cnt=_childCount[node];
+  unsigned lo=start;
+  unsigned hi=start+cnt;
+  while(lo<hi) {
+    unsigned mid=(lo+hi)/2;
+    if(_childSymbols[mid]<symbol) {
+      lo=mid+1;
+    }
+    else {
+      hi=mid;
+    }
+  }
+  if(lo<start+cnt && _childSymbols[lo]==symbol) {
+    return _childNodes[lo];
+  }
+
+  unsigned child=newNode(arity);
+  if(cnt==_childCapacity[node]) {
+    unsigned capacity=cnt ? 2*cnt : 1;
+    unsigned newStart=allocateBlock(capacity);
+    for(unsigned i=0; i<cnt; i++) {
+      _childSymbols[newStart+i]=_childSymbols[start+i];
+      _childNodes[newStart+i]=_childNodes[start+i];
+    }
+    if(cnt) {
+      releaseBlock(start, cnt);
+    }
+    lo=newStart+(lo-start);
+    start=newStart;
+    _childStart[node]=start;
+    _childCapacity[node]=capacity;
+  }
+  for(unsigned i=start+cnt; i>lo; i--) {
+    _childSymbols[i]=_childSymbols[i-1];
+    _childNodes[i]=_childNodes[i-1];
+  }
+  _childSymbols[lo]=symbol;
+  _childNodes[lo]=child;
+  _childCount[node]=cnt+1;
+  return child;
+}
+
+/**
+ * Remove the child of @b node with top symbol @b symbol. The child
+ * must have no children and no leaf.
+ */
+void CompactSubstitutionTree::removeChild(unsigned node, unsigned symbol)
+{
+  CALL("CompactSubstitutionTree::removeChild");
+
+  unsigned start=_childStart[node];
+  unsigned end=start+_childCount[node];
+  unsigned pos=start;
+  while(_childSymbols[pos]!=symbol) {
+    pos++;
+    ASS_L(pos,end);
+  }
+  unsigned child=_childNodes[pos];
+  ASS_EQ(_childCount[child],0);
+  ASS_EQ(_leaf[child],0);
+
+  for(unsigned i=pos+1; i<end; i++) {
+    _childSymbols[i-1]=_childSymbols[i];
+    _childNodes[i-1]=_childNodes[i];
+  }
+  _childCount[node]--;
+  if(_childCount[node]==0) {
+    releaseBlock(start, _childCapacity[node]);
+    _childCapacity[node]=0;
+  }
+  _freeNodes.push(child);
+}
+
+void CompactSubstitutionTree::insert(const FlatKey& key, const LeafData& ld)
+{
+  CALL("CompactSubstitutionTree::insert");
+
+  unsigned node=0;
+  for(unsigned i=0; i<key.size(); i++) {
+    node=getOrCreateChild(node, key.symbols[i], key.arities[i]);
+  }
+  if(!_leaf[node]) {
+    unsigned leaf;
+    if(_freeLeaves.isNonEmpty()) {
+      leaf=_freeLeaves.pop();
+    }
+    else {
+      leaf=_leaves.size();
+      _leaves.push(new Stack<LeafData>());
+    }
+    _leaf[node]=leaf+1;
+  }
+  _leaves[_leaf[node]-1]->push(ld);
+  _size++;
+}
+
+void CompactSubstitutionTree::remove(const FlatKey& key, const LeafData& ld)
+{
+  CALL("CompactSubstitutionTree::remove");
+
+  static Stack<unsigned> path;
+  path.reset();
+
+  unsigned node=0;
+  for(unsigned i=0; i<key.size(); i++) {
+    path.push(node);
+    node=findChild(node, key.symbols[i]);
+    if(!node) {
+      ASSERTION_VIOLATION;
+      return;
+    }
+  }
+  ASS(_leaf[node]);
+  Stack<LeafData>& leaf=*_leaves[_leaf[node]-1];
+  unsigned pos=0;
+  while(!(leaf[pos]==ld)) {
+    pos++;
+    if(pos==leaf.size()) {
+      ASSERTION_VIOLATION;
+      return;
+    }
+  }
+  leaf[pos]=leaf.top();
+  leaf.pop();
+  _size--;
+
+  if(leaf.isNonEmpty()) {
+    return;
+  }
+  _freeLeaves.push(_leaf[node]-1);
+  _leaf[node]=0;
+
+  unsigned depth=key.size();
+  while(node && !_childCount[node] && !_leaf[node]) {
+    node=path.pop();
+    depth--;
+    removeChild(node, key.symbols[depth]);
+  }
+}
+
+/**
+ * Create an iterator over the candidates for @b query. The query may
+ * be zero if @b kind is ALL.
+ */
+CompactSubstitutionTree::CandidateIterator::CandidateIterator(CompactSubstitutionTree* tree,
+    const FlatKey* query, RetrievalKind kind)
+: _tree(tree), _query(query), _kind(kind), _leaf(0), _leafPos(0)
+{
+  CALL("CompactSubstitutionTree::CandidateIterator::CandidateIterator");
+
+  switch(kind) {
+  case ALL:
+    _end=0;
+    //skip the whole indexed term
+    _states.push(State(0, 0, 1));
+    break;
+  case ALL_WITH_TOP:
+  {
+    _end=query->size();
+    unsigned child=tree->findChild(0, query->symbols[0]);
+    if(child) {
+      _states.push(State(child, _end, tree->_arity[child]));
+    }
+    break;
+  }
+  default:
+    _end=query->size();
+    _states.push(State(0, 0, 0));
+  }
+}
+
+bool CompactSubstitutionTree::CandidateIterator::hasNext()
+{
+  CALL("CompactSubstitutionTree::CandidateIterator::hasNext");
+
+  for(;;) {
+    if(_leaf && _leafPos<_leaf->size()) {
+      return true;
+    }
+    _leaf=0;
+    if(_states.isEmpty()) {
+      return false;
+    }
+    State s=_states.pop();
+    unsigned start=_tree->_childStart[s.node];
+    unsigned end=start+_tree->_childCount[s.node];
+
+    if(s.skip) {
+      for(unsigned i=start; i<end; i++) {
+	unsigned child=_tree->_childNodes[i];
+	_states.push(State(child, s.pos, s.skip-1+_tree->_arity[child]));
+      }
+      continue;
+    }
+    if(s.pos==_end) {
+      if(_tree->_leaf[s.node]) {
+	_leaf=_tree->_leaves[_tree->_leaf[s.node]-1];
+	_leafPos=0;
+      }
+      continue;
+    }
+
+    unsigned symbol=_query->symbols[s.pos];
+    bool varChild=start<end && _tree->_childSymbols[start]==VAR_SYMBOL;
+    if(symbol==VAR_SYMBOL) {
+      if(_kind==INSTANCES || _kind==UNIFICATIONS) {
+	//the query variable is matched by any indexed subterm
+	for(unsigned i=start; i<end; i++) {
+	  unsigned child=_tree->_childNodes[i];
+	  _states.push(State(child, s.pos+1, _tree->_arity[child]));
+	}
+      }
+      else if(varChild) {
+	_states.push(State(_tree->_childNodes[start], s.pos+1, 0));
+      }
+      continue;
+    }
+    if(varChild && (_kind==GENERALIZATIONS || _kind==UNIFICATIONS)) {
+      //the indexed variable is matched by the whole query subterm
+      _states.push(State(_tree->_childNodes[start], _query->ends[s.pos], 0));
+    }
+    unsigned child=_tree->findChild(s.node, symbol);
+    if(child) {
+      _states.push(State(child, s.pos+1, 0));
+    }
+  }
+}
+
+///////////////////////////////////////
+
+/**
+ * Iterator over the candidates of a term query that pass the
+ * unification or matching check.
+ */
+class CompactTermSubstitutionTree::ResultIterator
+: public IteratorCore<TermQueryResult>
+{
+public:
+  CLASS_NAME(CompactTermSubstitutionTree::ResultIterator);
+  USE_ALLOCATOR(CompactTermSubstitutionTree::ResultIterator);
+
+  ResultIterator(CompactSubstitutionTree* tree, TermList query,
+      CompactSubstitutionTree::RetrievalKind kind, bool retrieveSubstitutions)
+  : _query(query), _kind(kind), _retrieveSubstitutions(retrieveSubstitutions),
+    _binder(_bindings), _candidates(tree, flatten(_key, query), kind), _found(0)
+  {
+    if(retrieveSubstitutions) {
+      if(kind==CompactSubstitutionTree::UNIFICATIONS) {
+	_subst=ResultSubstitution::fromSubstitution(&_unifier, QRS_QUERY_BANK, QRS_RESULT_BANK);
+      }
+      else {
+	_subst=ResultSubstitutionSP(new MatchingResultSubstitution(&_bindings,
+	    kind==CompactSubstitutionTree::GENERALIZATIONS));
+      }
+    }
+  }
+
+  bool hasNext()
+  {
+    CALL("CompactTermSubstitutionTree::ResultIterator::hasNext");
+
+    while(!_found && _candidates.hasNext()) {
+      LeafData& ld=_candidates.next();
+      if(check(ld)) {
+	_found=&ld;
+      }
+    }
+    return _found;
+  }
+
+  TermQueryResult next()
+  {
+    CALL("CompactTermSubstitutionTree::ResultIterator::next");
+    ASS(_found);
+
+    LeafData* ld=_found;
+    _found=0;
+    if(_retrieveSubstitutions) {
+      return TermQueryResult(ld->term, ld->literal, ld->clause, _subst);
+    }
+    return TermQueryResult(ld->term, ld->literal, ld->clause);
+  }
+
+private:
+  typedef CompactSubstitutionTree::LeafData LeafData;
+  typedef MatchingResultSubstitution::BindingMap BindingMap;
+
+  /** Fill @b key, the candidate iterator is built before the constructor body runs */
+  static const CompactSubstitutionTree::FlatKey* flatten(CompactSubstitutionTree::FlatKey& key, TermList query)
+  {
+    key.pushTerm(query);
+    return &key;
+  }
+
+  bool check(LeafData& ld)
+  {
+    switch(_kind) {
+    case CompactSubstitutionTree::GENERALIZATIONS:
+      _bindings.reset();
+      return MatchingUtils::matchTerms(ld.term, _query, _binder);
+    case CompactSubstitutionTree::INSTANCES:
+      _bindings.reset();
+      return MatchingUtils::matchTerms(_query, ld.term, _binder);
+    case CompactSubstitutionTree::UNIFICATIONS:
+      _unifier.reset();
+      return _unifier.unify(_query, QRS_QUERY_BANK, ld.term, QRS_RESULT_BANK);
+    case CompactSubstitutionTree::ALL_WITH_TOP:
+      return true;
+    default:
+      ASSERTION_VIOLATION;
+    }
+    return false;
+  }
+
+  TermList _query;
+  CompactSubstitutionTree::RetrievalKind _kind;
+  bool _retrieveSubstitutions;
+  BindingMap _bindings;
+  MatchingUtils::MapRefBinder<BindingMap> _binder;
+  RobSubstitution _unifier;
+  ResultSubstitutionSP _subst;
+  CompactSubstitutionTree::FlatKey _key;
+  CompactSubstitutionTree::CandidateIterator _candidates;
+  LeafData* _found;
+};
+
+void CompactTermSubstitutionTree::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("CompactTermSubstitutionTree::insert");
+
+  _key.reset();
+  _key.pushTerm(t);
+  _tree.insert(_key, CompactSubstitutionTree::LeafData(cls, lit, t));
+}
+
+void CompactTermSubstitutionTree::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("CompactTermSubstitutionTree::remove");
+
+  _key.reset();
+  _key.pushTerm(t);
+  _tree.remove(_key, CompactSubstitutionTree::LeafData(cls, lit, t));
+}
+
+TermQueryResultIterator CompactTermSubstitutionTree::getUnifications(TermList t, bool retrieveSubstitutions)
+{
+  CALL("CompactTermSubstitutionTree::getUnifications");
+  return vi( new ResultIterator(&_tree, t, CompactSubstitutionTree::UNIFICATIONS, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator CompactTermSubstitutionTree::getGeneralizations(TermList t, bool retrieveSubstitutions)
+{
+  CALL("CompactTermSubstitutionTree::getGeneralizations");
+  return vi( new ResultIterator(&_tree, t, CompactSubstitutionTree::GENERALIZATIONS, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator CompactTermSubstitutionTree::getInstances(TermList t, bool retrieveSubstitutions)
+{
+  CALL("CompactTermSubstitutionTree::getInstances");
+  return vi( new ResultIterator(&_tree, t, CompactSubstitutionTree::INSTANCES, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator CompactTermSubstitutionTree::getAllWithTop(TermList t)
+{
+  CALL("CompactTermSubstitutionTree::getAllWithTop");
+  ASS(t.isTerm());
+  return vi( new ResultIterator(&_tree, t, CompactSubstitutionTree::ALL_WITH_TOP, false) );
+}
+
+bool CompactTermSubstitutionTree::generalizationExists(TermList t)
+{
+  CALL("CompactTermSubstitutionTree::generalizationExists");
+  return ResultIterator(&_tree, t, CompactSubstitutionTree::GENERALIZATIONS, false).hasNext();
+}
+
+///////////////////////////////////////
+
+/**
+ * Iterator over the candidates of a literal query that pass the
+ * unification or matching check. If @b reversed is true, the
+ * arguments of the binary query literal are swapped.
+ */
+class CompactLiteralSubstitutionTree::ResultIterator
+: public IteratorCore<SLQueryResult>
+{
+public:
+  CLASS_NAME(CompactLiteralSubstitutionTree::ResultIterator);
+  USE_ALLOCATOR(CompactLiteralSubstitutionTree::ResultIterator);
+
+  ResultIterator(CompactSubstitutionTree* tree, Literal* query, bool complementary, bool reversed,
+      CompactSubstitutionTree::RetrievalKind kind, bool retrieveSubstitutions)
+  : _query(query), _reversed(reversed), _kind(kind), _retrieveSubstitutions(retrieveSubstitutions),
+    _binder(_bindings), _candidates(tree, flatten(_key, query, complementary, reversed), kind), _found(0)
+  {
+    if(retrieveSubstitutions) {
+      if(kind==CompactSubstitutionTree::UNIFICATIONS || kind==CompactSubstitutionTree::VARIANTS) {
+	_subst=ResultSubstitution::fromSubstitution(&_unifier, QRS_QUERY_BANK, QRS_RESULT_BANK);
+      }
+      else {
+	_subst=ResultSubstitutionSP(new MatchingResultSubstitution(&_bindings,
+	    kind==CompactSubstitutionTree::GENERALIZATIONS));
+      }
+    }
+  }
+
+  bool hasNext()
+  {
+    CALL("CompactLiteralSubstitutionTree::ResultIterator::hasNext");
+
+    while(!_found && _candidates.hasNext()) {
+      LeafData& ld=_candidates.next();
+      if(check(ld.literal)) {
+	_found=&ld;
+      }
+    }
+    return _found;
+  }
+
+  SLQueryResult next()
+  {
+    CALL("CompactLiteralSubstitutionTree::ResultIterator::next");
+    ASS(_found);
+
+    LeafData* ld=_found;
+    _found=0;
+    if(_retrieveSubstitutions) {
+      return SLQueryResult(ld->literal, ld->clause, _subst);
+    }
+    return SLQueryResult(ld->literal, ld->clause);
+  }
+
+private:
+  typedef CompactSubstitutionTree::LeafData LeafData;
+  typedef MatchingResultSubstitution::BindingMap BindingMap;
+
+  static const CompactSubstitutionTree::FlatKey* flatten(CompactSubstitutionTree::FlatKey& key,
+      Literal* query, bool complementary, bool reversed)
+  {
+    if(!query) {
+      return 0;
+    }
+    key.pushLiteral(query, complementary, reversed);
+    return &key;
+  }
+
+  bool match(Literal* base, Literal* instance)
+  {
+    _bindings.reset();
+    if(!_reversed) {
+      return MatchingUtils::matchArgs(base, instance, _binder);
+    }
+    return MatchingUtils::matchTerms(*base->nthArgument(0), *instance->nthArgument(1), _binder) &&
+	MatchingUtils::matchTerms(*base->nthArgument(1), *instance->nthArgument(0), _binder);
+  }
+
+  bool unify(Literal* lit)
+  {
+    _unifier.reset();
+    if(!_reversed) {
+      return _unifier.unifyArgs(_query, QRS_QUERY_BANK, lit, QRS_RESULT_BANK);
+    }
+    return _unifier.unify(*_query->nthArgument(0), QRS_QUERY_BANK, *lit->nthArgument(1), QRS_RESULT_BANK) &&
+	_unifier.unify(*_query->nthArgument(1), QRS_QUERY_BANK, *lit->nthArgument(0), QRS_RESULT_BANK);
+  }
+
+  bool check(Literal* lit)
+  {
+    CALL("CompactLiteralSubstitutionTree::ResultIterator::check");
+
+    if(_kind==CompactSubstitutionTree::ALL) {
+      return true;
+    }
+    if(_query->isEquality() &&
+	SortHelper::getEqualityArgumentSort(_query)!=SortHelper::getEqualityArgumentSort(lit)) {
+      return false;
+    }
+    if(_query->arity()==0) {
+      if(_retrieveSubstitutions) {
+	_bindings.reset();
+	_unifier.reset();
+      }
+      return true;
+    }
+    switch(_kind) {
+    case CompactSubstitutionTree::GENERALIZATIONS:
+      return match(lit, _query);
+    case CompactSubstitutionTree::INSTANCES:
+      return match(_query, lit);
+    case CompactSubstitutionTree::UNIFICATIONS:
+      return unify(lit);
+    case CompactSubstitutionTree::VARIANTS:
+      if(!MatchingUtils::haveVariantArgs(_query, lit)) {
+	return false;
+      }
+      if(_retrieveSubstitutions) {
+	ALWAYS(unify(lit));
+      }
+      return true;
+    default:
+      ASSERTION_VIOLATION;
+    }
+    return false;
+  }
+
+  Literal* _query;
+  bool _reversed;
+  CompactSubstitutionTree::RetrievalKind _kind;
+  bool _retrieveSubstitutions;
+  BindingMap _bindings;
+  MatchingUtils::MapRefBinder<BindingMap> _binder;
+  RobSubstitution _unifier;
+  ResultSubstitutionSP _subst;
+  CompactSubstitutionTree::FlatKey _key;
+  CompactSubstitutionTree::CandidateIterator _candidates;
+  LeafData* _found;
+};
+
+void CompactLiteralSubstitutionTree::insert(Literal* lit, Clause* cls)
+{
+  CALL("CompactLiteralSubstitutionTree::insert");
+
+  _key.reset();
+  _key.pushLiteral(lit, false, false);
+  _tree.insert(_key, CompactSubstitutionTree::LeafData(cls, lit));
+}
+
+void CompactLiteralSubstitutionTree::remove(Literal* lit, Clause* cls)
+{
+  CALL("CompactLiteralSubstitutionTree::remove");
+
+  _key.reset();
+  _key.pushLiteral(lit, false, false);
+  _tree.remove(_key, CompactSubstitutionTree::LeafData(cls, lit));
+}
+
+SLQueryResultIterator CompactLiteralSubstitutionTree::getAll()
+{
+  CALL("CompactLiteralSubstitutionTree::getAll");
+  return vi( new ResultIterator(&_tree, 0, false, false, CompactSubstitutionTree::ALL, false) );
+}
+
+/**
+ * Return the results of a query of kind @b kind. Both argument orders
+ * of commutative literals are tried, except for variants, as in the
+ * LiteralSubstitutionTree.
+ */
+SLQueryResultIterator CompactLiteralSubstitutionTree::getResultIterator(Literal* lit,
+    bool complementary, bool retrieveSubstitutions, CompactSubstitutionTree::RetrievalKind kind)
+{
+  CALL("CompactLiteralSubstitutionTree::getResultIterator");
+
+  SLQueryResultIterator res=vi( new ResultIterator(&_tree, lit, complementary, false, kind, retrieveSubstitutions) );
+  if(lit->commutative() && kind!=CompactSubstitutionTree::VARIANTS) {
+    res=pvi( getConcatenatedIterator(res,
+	vi( new ResultIterator(&_tree, lit, complementary, true, kind, retrieveSubstitutions) )) );
+  }
+  return res;
+}
+
+SLQueryResultIterator CompactLiteralSubstitutionTree::getUnifications(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("CompactLiteralSubstitutionTree::getUnifications");
+  return getResultIterator(lit, complementary, retrieveSubstitutions, CompactSubstitutionTree::UNIFICATIONS);
+}
+
+SLQueryResultIterator CompactLiteralSubstitutionTree::getGeneralizations(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("CompactLiteralSubstitutionTree::getGeneralizations");
+  return getResultIterator(lit, complementary, retrieveSubstitutions, CompactSubstitutionTree::GENERALIZATIONS);
+}
+
+SLQueryResultIterator CompactLiteralSubstitutionTree::getInstances(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("CompactLiteralSubstitutionTree::getInstances");
+  return getResultIterator(lit, complementary, retrieveSubstitutions, CompactSubstitutionTree::INSTANCES);
+}
+
+SLQueryResultIterator CompactLiteralSubstitutionTree::getVariants(Literal* lit,
+    bool complementary, bool retrieveSubstitutions)
+{
+  CALL("CompactLiteralSubstitutionTree::getVariants");
+  return getResultIterator(lit, complementary, retrieveSubstitutions, CompactSubstitutionTree::VARIANTS);
+}
+
+}
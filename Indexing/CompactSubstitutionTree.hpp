@@ -0,0 +1,264 @@
+/*
+ * File CompactSubstitutionTree.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file CompactSubstitutionTree.hpp
+ * Defines class CompactSubstitutionTree and the term and literal
+ * indexing structures that use it.
+ */
+
+#ifndef __CompactSubstitutionTree__
+#define __CompactSubstitutionTree__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/RobSubstitution.hpp"
+
+#include "Index.hpp"
+#include "LiteralIndexingStructure.hpp"
+#include "SubstitutionTree.hpp"
+#include "TermIndexingStructure.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * A substitution tree with a fixed left-to-right order of positions
+ * whose nodes are kept in arrays instead of separately allocated
+ * objects.
+ *
+ * An indexed term is stored as the path of its symbols in prefix
+ * order, variables are not distinguished from each other. The tree
+ * is therefore only a filter, and the retrieved candidates are
+ * checked by the indexing structures below.
+ *
+ * Nodes are numbers, and their data are stored in parallel arrays.
+ * The children of a node occupy a contiguous block of an arena, with
+ * their top symbols stored next to each other and sorted, so that
+ * a child is found without touching the child nodes. When a block
+ * fills up, it is moved to a block of twice the size and the old
+ * block is reused for another node.
+ */
+class CompactSubstitutionTree
+{
+public:
+  CLASS_NAME(CompactSubstitutionTree);
+  USE_ALLOCATOR(CompactSubstitutionTree);
+
+  typedef SubstitutionTree::LeafData LeafData;
+
+  /** Symbol of variables in the tree, other symbols are functors plus one */
+  static const unsigned VAR_SYMBOL = 0;
+
+  /**
+   * A term or literal flattened in prefix order. For each position,
+   * it contains the symbol, the arity, and the position right after
+   * the subterm starting there.
+   */
+  struct FlatKey
+  {
+    void reset();
+    void pushTerm(TermList t);
+    void pushLiteral(Literal* lit, bool complementary, bool reversed);
+
+    unsigned size() const { return symbols.size(); }
+
+    Stack<unsigned> symbols;
+    Stack<unsigned> arities;
+    Stack<unsigned> ends;
+  };
+
+  enum RetrievalKind {
+    GENERALIZATIONS,
+    INSTANCES,
+    UNIFICATIONS,
+    VARIANTS,
+    /** all entries with the top symbol of the query */
+    ALL_WITH_TOP,
+    /** all entries, there is no query */
+    ALL
+  };
+
+  class CandidateIterator;
+
+  CompactSubstitutionTree();
+  ~CompactSubstitutionTree();
+
+  void insert(const FlatKey& key, const LeafData& ld);
+  void remove(const FlatKey& key, const LeafData& ld);
+
+  /** Number of entries in the tree */
+  unsigned size() const { return _size; }
+
+  size_t memoryUsage() const;
+
+private:
+  unsigned findChild(unsigned node, unsigned symbol) const;
+  unsigned getOrCreateChild(unsigned node, unsigned symbol, unsigned arity);
+  void removeChild(unsigned node, unsigned symbol);
+  unsigned newNode(unsigned arity);
+  unsigned allocateBlock(unsigned capacity);
+  void releaseBlock(unsigned start, unsigned capacity);
+
+  /** Arity of the symbol leading to the node */
+  Stack<unsigned> _arity;
+  /** Start of the block of children of the node in the arena */
+  Stack<unsigned> _childStart;
+  /** Number of children of the node */
+  Stack<unsigned> _childCount;
+  /** Size of the block of children of the node, zero or a power of two */
+  Stack<unsigned> _childCapacity;
+  /** Index of the leaf of the node in @b _leaves plus one, or zero */
+  Stack<unsigned> _leaf;
+
+  /** The arena of child blocks: top symbols of the children, sorted in each block */
+  Stack<unsigned> _childSymbols;
+  /** The arena of child blocks: the children */
+  Stack<unsigned> _childNodes;
+
+  /** Leaves of terminal nodes */
+  Stack<Stack<LeafData>*> _leaves;
+
+  /** Unused blocks of the arena, by the binary logarithm of their size */
+  Stack<unsigned> _freeBlocks[32];
+  /** Unused nodes */
+  Stack<unsigned> _freeNodes;
+  /** Unused leaves */
+  Stack<unsigned> _freeLeaves;
+
+  unsigned _size;
+}; // class CompactSubstitutionTree
+
+/**
+ * Iterator over the entries of the tree that may be in the relation
+ * given by the retrieval kind with the query.
+ */
+class CompactSubstitutionTree::CandidateIterator
+{
+public:
+  CLASS_NAME(CompactSubstitutionTree::CandidateIterator);
+  USE_ALLOCATOR(CompactSubstitutionTree::CandidateIterator);
+
+  CandidateIterator(CompactSubstitutionTree* tree, const FlatKey* query, RetrievalKind kind);
+
+  bool hasNext();
+  LeafData& next() { ASS(_leaf); return (*_leaf)[_leafPos++]; }
+
+private:
+  struct State
+  {
+    State() {}
+    State(unsigned node, unsigned pos, unsigned skip) : node(node), pos(pos), skip(skip) {}
+
+    unsigned node;
+    /** next position of the query */
+    unsigned pos;
+    /** number of indexed subterms to be skipped before the query is matched again */
+    unsigned skip;
+  };
+
+  CompactSubstitutionTree* _tree;
+  const FlatKey* _query;
+  RetrievalKind _kind;
+  /** size of the query, a state at this position and with nothing to skip is final */
+  unsigned _end;
+  Stack<State> _states;
+  Stack<LeafData>* _leaf;
+  unsigned _leafPos;
+};
+
+/**
+ * Term indexing structure using a compact substitution tree
+ */
+class CompactTermSubstitutionTree
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(CompactTermSubstitutionTree);
+  USE_ALLOCATOR(CompactTermSubstitutionTree);
+
+  void insert(TermList t, Literal* lit, Clause* cls);
+  void remove(TermList t, Literal* lit, Clause* cls);
+
+  TermQueryResultIterator getUnifications(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getInstances(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getAllWithTop(TermList t);
+
+  bool generalizationExists(TermList t);
+
+  size_t memoryUsage() { return _tree.memoryUsage(); }
+
+#if VDEBUG
+  virtual void markTagged() {}
+#endif
+
+private:
+  class ResultIterator;
+
+  CompactSubstitutionTree::FlatKey _key;
+  CompactSubstitutionTree _tree;
+};
+
+/**
+ * Literal indexing structure using a compact substitution tree
+ */
+class CompactLiteralSubstitutionTree
+: public LiteralIndexingStructure
+{
+public:
+  CLASS_NAME(CompactLiteralSubstitutionTree);
+  USE_ALLOCATOR(CompactLiteralSubstitutionTree);
+
+  void insert(Literal* lit, Clause* cls);
+  void remove(Literal* lit, Clause* cls);
+
+  SLQueryResultIterator getAll();
+  SLQueryResultIterator getUnifications(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+  SLQueryResultIterator getGeneralizations(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+  SLQueryResultIterator getInstances(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+  SLQueryResultIterator getVariants(Literal* lit,
+	  bool complementary, bool retrieveSubstitutions = true);
+
+  size_t memoryUsage() { return _tree.memoryUsage(); }
+
+#if VDEBUG
+  virtual void markTagged() {}
+#endif
+
+private:
+  class ResultIterator;
+
+  SLQueryResultIterator getResultIterator(Literal* lit, bool complementary,
+      bool retrieveSubstitutions, CompactSubstitutionTree::RetrievalKind kind);
+
+  CompactSubstitutionTree::FlatKey _key;
+  CompactSubstitutionTree _tree;
+};
+
+};
+
+#endif /* __CompactSubstitutionTree__ */
@@ -0,0 +1,411 @@
+/*
+ * File DiscriminationTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file DiscriminationTree.cpp
+ * Implements class DiscriminationTree.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Recycler.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+#include "Kernel/FlatTerm.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/TermIterators.hpp"
+
+#include "DiscriminationTree.hpp"
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+struct DiscriminationTree::Node
+{
+  CLASS_NAME(DiscriminationTree::Node);
+  USE_ALLOCATOR(DiscriminationTree::Node);
+
+  ~Node()
+  {
+    while (funChildren.isNonEmpty()) {
+      delete funChildren.pop().second;
+    }
+    while (varChildren.isNonEmpty()) {
+      delete varChildren.pop().second;
+    }
+  }
+
+  bool isEmpty() const { return funChildren.isEmpty() && varChildren.isEmpty() && leaves.isEmpty(); }
+
+  /** The children for the key @b val, which is a functor or a variable number marked by @b VAR_FLAG */
+  Stack<Child>& children(unsigned val) { return (val & VAR_FLAG) ? varChildren : funChildren; }
+
+  /** Return the index of the child with the key @b val in @b children, or the index where it belongs */
+  static unsigned findChild(const Stack<Child>& children, unsigned val)
+  {
+    unsigned lo = 0;
+    unsigned hi = children.size();
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (children[mid].first < val) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  /** Return the child for the functor @b fn, or zero if there is none */
+  Node* funChild(unsigned fn) const
+  {
+    unsigned pos = findChild(funChildren, fn);
+    return (pos < funChildren.size() && funChildren[pos].first == fn) ? funChildren[pos].second : 0;
+  }
+
+  /** Children for functors ordered by the functors */
+  Stack<Child> funChildren;
+  /** Children for variables ordered by the variable numbers marked by @b VAR_FLAG */
+  Stack<Child> varChildren;
+  /** Entries whose key is the path to this node, which then has no children */
+  Stack<LeafData> leaves;
+};
+
+/**
+ * Iterator over the generalizations of a query term.
+ *
+ * The query is traversed in its flattened form along the paths of the
+ * tree. Where a node has children for variables, they and the child
+ * for the functor of the query subterm are left as backtracking points,
+ * so that the more general entries are tried first; otherwise the child
+ * for the functor is followed directly. A point records the node to
+ * continue with, the position in the query after the subterm of the
+ * node, and the number of indexed variables bound on the path. A point
+ * for a variable bound for the first time also records the binding,
+ * since other branches may overwrite it before the point is reached.
+ */
+class DiscriminationTree::GeneralizationIterator
+: public IteratorCore<TermQueryResult>
+{
+public:
+  CLASS_NAME(DiscriminationTree::GeneralizationIterator);
+  USE_ALLOCATOR(DiscriminationTree::GeneralizationIterator);
+
+  GeneralizationIterator(Node* root, TermList query, bool retrieveSubstitutions)
+  : _retrieveSubstitutions(retrieveSubstitutions), _leaf(0), _leafPos(0)
+  {
+    Recycler::get(_state);
+    _state->points.reset();
+    _state->points.push(Point(root, 0, 0));
+
+    _query = FlatTerm::create(query);
+    _queryLength = query.isVar() ? 1 : (*_query)[2].number();
+  }
+
+  ~GeneralizationIterator()
+  {
+    _query->destroy();
+    Recycler::release(_state);
+  }
+
+  bool hasNext()
+  {
+    CALL("DiscriminationTree::GeneralizationIterator::hasNext");
+
+    Stack<Point>& points = _state->points;
+    while (!_leaf || _leafPos == _leaf->size()) {
+      _leaf = 0;
+      if (points.isEmpty()) {
+        return false;
+      }
+      Point p = points.pop();
+      if (p.binding.isNonEmpty()) {
+        _state->bindings[p.bindingCnt-1] = p.binding;
+      }
+      Node* node = p.node;
+      unsigned pos = p.pos;
+      while (node && pos < _queryLength) {
+        const FlatTerm::Entry& e = (*_query)[pos];
+        if (node->varChildren.isEmpty()) {
+          if (e.isFun()) {
+            node = node->funChild(e.number());
+            pos += FlatTerm::functionEntryCount;
+          } else {
+            node = 0;
+          }
+          continue;
+        }
+        if (e.isFun()) {
+          Node* child = node->funChild(e.number());
+          if (child) {
+            points.push(Point(child, pos+FlatTerm::functionEntryCount, p.bindingCnt));
+          }
+        }
+        pushVariableChildren(node, pos, p.bindingCnt);
+        //continue with the points just pushed
+        node = 0;
+      }
+      if (node) {
+        ASS(node->funChildren.isEmpty());
+        ASS(node->varChildren.isEmpty());
+        _leaf = &node->leaves;
+        _leafPos = 0;
+      }
+    }
+    return true;
+  }
+
+  TermQueryResult next()
+  {
+    CALL("DiscriminationTree::GeneralizationIterator::next");
+    ASS(_leaf);
+
+    LeafData& ld = (*_leaf)[_leafPos++];
+    if (!_retrieveSubstitutions) {
+      return TermQueryResult(ld.term, ld.literal, ld.clause);
+    }
+    //the variables of the entry in the order of their first occurrences
+    //correspond to the numbered variables of the path
+    BindingMap& resultBindings = _state->resultBindings;
+    resultBindings.reset();
+    unsigned idx = 0;
+    VariableIterator& vit = _state->varIterator;
+    vit.reset(ld.term);
+    while (vit.hasNext()) {
+      unsigned var = vit.next().var();
+      if (!resultBindings.find(var)) {
+        resultBindings.insert(var, _state->bindings[idx++]);
+      }
+    }
+    return TermQueryResult(ld.term, ld.literal, ld.clause, ResultSubstitutionSP(&_state->subst, true));
+  }
+
+private:
+  typedef MatchingResultSubstitution::BindingMap BindingMap;
+
+  struct Point
+  {
+    Point() {}
+    Point(Node* node, unsigned pos, unsigned bindingCnt)
+    : node(node), pos(pos), bindingCnt(bindingCnt) { binding.makeEmpty(); }
+    Point(Node* node, unsigned pos, unsigned bindingCnt, TermList binding)
+    : node(node), pos(pos), bindingCnt(bindingCnt), binding(binding) {}
+
+    Node* node;
+    unsigned pos;
+    unsigned bindingCnt;
+    /** Binding of the variable number @b bindingCnt-1 made by this point, or empty */
+    TermList binding;
+  };
+
+  /**
+   * Structures of a retrieval, which are recycled as most retrievals
+   * of forward demodulation finish quickly
+   */
+  struct State
+  {
+    CLASS_NAME(DiscriminationTree::GeneralizationIterator::State);
+    USE_ALLOCATOR(DiscriminationTree::GeneralizationIterator::State);
+
+    State() : subst(&resultBindings, true) {}
+
+    Stack<Point> points;
+    /** Query subterms bound to the numbered variables of the current path */
+    DArray<TermList> bindings;
+    BindingMap resultBindings;
+    MatchingResultSubstitution subst;
+    VariableIterator varIterator;
+  };
+
+  void pushVariableChildren(Node* node, unsigned pos, unsigned bindingCnt)
+  {
+    const FlatTerm::Entry& e = (*_query)[pos];
+    TermList sub;
+    unsigned after;
+    if (e.isVar()) {
+      sub = TermList(e.number(), false);
+      after = pos+1;
+    } else {
+      ASS(e.isFun());
+      sub = TermList((*_query)[pos+1].ptr());
+      after = pos+(*_query)[pos+2].number();
+    }
+
+    Stack<Point>& points = _state->points;
+    DArray<TermList>& bindings = _state->bindings;
+    Stack<Child>& children = node->varChildren;
+    for (unsigned i = 0; i < children.size(); i++) {
+      unsigned var = children[i].first ^ VAR_FLAG;
+      if (var == bindingCnt) {
+        if (bindings.size() <= bindingCnt) {
+          bindings.expand(bindingCnt+1);
+        }
+        points.push(Point(children[i].second, after, bindingCnt+1, sub));
+      } else {
+        ASS_L(var, bindingCnt);
+        if (bindings[var] == sub) {
+          points.push(Point(children[i].second, after, bindingCnt));
+        }
+      }
+    }
+  }
+
+  FlatTerm* _query;
+  unsigned _queryLength;
+  bool _retrieveSubstitutions;
+  State* _state;
+  Stack<LeafData>* _leaf;
+  unsigned _leafPos;
+};
+
+DiscriminationTree::DiscriminationTree()
+: _root(new Node())
+{
+}
+
+DiscriminationTree::~DiscriminationTree()
+{
+  delete _root;
+}
+
+/**
+ * Store the key of @b t into @b _key.
+ */
+void DiscriminationTree::getKey(TermList t)
+{
+  CALL("DiscriminationTree::getKey");
+
+  static DHMap<unsigned,unsigned> varNums;
+  varNums.reset();
+  _key.reset();
+
+  if (t.isVar()) {
+    _key.push(VAR_FLAG);
+    return;
+  }
+  _key.push(t.term()->functor());
+  SubtermIterator sit(t.term());
+  while (sit.hasNext()) {
+    TermList s = sit.next();
+    if (s.isVar()) {
+      unsigned* num;
+      varNums.getValuePtr(s.var(), num, varNums.size());
+      _key.push(*num | VAR_FLAG);
+    } else {
+      _key.push(s.term()->functor());
+    }
+  }
+}
+
+void DiscriminationTree::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("DiscriminationTree::insert");
+
+  getKey(t);
+
+  Node* node = _root;
+  for (unsigned i = 0; i < _key.size(); i++) {
+    unsigned val = _key[i];
+    Stack<Child>& children = node->children(val);
+    unsigned pos = Node::findChild(children, val);
+    if (pos == children.size() || children[pos].first != val) {
+      children.push(Child());
+      for (unsigned j = children.size()-1; j > pos; j--) {
+        children[j] = children[j-1];
+      }
+      children[pos] = Child(val, new Node());
+    }
+    node = children[pos].second;
+  }
+  node->leaves.push(LeafData(cls, lit, t));
+}
+
+void DiscriminationTree::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("DiscriminationTree::remove");
+
+  getKey(t);
+
+  static Stack<std::pair<Node*,unsigned> > path;
+  path.reset();
+  Node* node = _root;
+  for (unsigned i = 0; i < _key.size(); i++) {
+    Stack<Child>& children = node->children(_key[i]);
+    unsigned pos = Node::findChild(children, _key[i]);
+    ASS_L(pos, children.size());
+    ASS_EQ(children[pos].first, _key[i]);
+    path.push(std::make_pair(node, pos));
+    node = children[pos].second;
+  }
+  ALWAYS(node->leaves.remove(LeafData(cls, lit, t)));
+
+  //remove the nodes that became empty
+  while (path.isNonEmpty() && node->isEmpty()) {
+    Node* parent = path.top().first;
+    unsigned pos = path.pop().second;
+    Stack<Child>& children = parent->children(_key[path.size()]);
+    for (unsigned j = pos+1; j < children.size(); j++) {
+      children[j-1] = children[j];
+    }
+    children.pop();
+    delete node;
+    node = parent;
+  }
+}
+
+TermQueryResultIterator DiscriminationTree::getGeneralizations(TermList t, bool retrieveSubstitutions)
+{
+  CALL("DiscriminationTree::getGeneralizations");
+
+  if (_root->isEmpty()) {
+    return TermQueryResultIterator::getEmpty();
+  }
+  return vi( new GeneralizationIterator(_root, t, retrieveSubstitutions) );
+}
+
+bool DiscriminationTree::generalizationExists(TermList t)
+{
+  CALL("DiscriminationTree::generalizationExists");
+  return GeneralizationIterator(_root, t, false).hasNext();
+}
+
+size_t DiscriminationTree::memoryUsage()
+{
+  CALL("DiscriminationTree::memoryUsage");
+
+  size_t res = 0;
+  static Stack<Node*> nodes;
+  nodes.reset();
+  nodes.push(_root);
+  while (nodes.isNonEmpty()) {
+    Node* node = nodes.pop();
+    res += sizeof(Node) + (node->funChildren.size()+node->varChildren.size())*sizeof(Child)
+        + node->leaves.size()*sizeof(LeafData);
+    for (unsigned i = 0; i < node->funChildren.size(); i++) {
+      nodes.push(node->funChildren[i].second);
+    }
+    for (unsigned i = 0; i < node->varChildren.size(); i++) {
+      nodes.push(node->varChildren[i].second);
+    }
+  }
+  return res;
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * File DiscriminationTree.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file DiscriminationTree.hpp
+ * Defines class DiscriminationTree.
+ */
+
+#ifndef __DiscriminationTree__
+#define __DiscriminationTree__
+
+#include <utility>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SubstitutionTree.hpp"
+#include "TermIndexingStructure.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Perfect discrimination tree supporting only the retrieval of
+ * generalizations, as needed by forward demodulation.
+ *
+ * An indexed term is stored as the sequence of its symbols in prefix
+ * order, with its variables numbered by their first occurrences. Each
+ * path of the tree therefore stands for a single term up to variable
+ * renaming, and the retrieval is exact: a query is flattened into a
+ * FlatTerm, and an indexed variable either skips the query subterm at
+ * the current position or, if it occurred before, checks that the
+ * subterm is the one it is bound to.
+ */
+class DiscriminationTree
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(DiscriminationTree);
+  USE_ALLOCATOR(DiscriminationTree);
+
+  DiscriminationTree();
+  ~DiscriminationTree();
+
+  void insert(TermList t, Literal* lit, Clause* cls);
+  void remove(TermList t, Literal* lit, Clause* cls);
+
+  TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
+  bool generalizationExists(TermList t);
+
+  size_t memoryUsage();
+
+#if VDEBUG
+  virtual void markTagged() {}
+#endif
+
+private:
+  typedef SubstitutionTree::LeafData LeafData;
+
+  struct Node;
+  class GeneralizationIterator;
+
+  typedef std::pair<unsigned,Node*> Child;
+
+  void getKey(TermList t);
+
+  Node* _root;
+  /**
+   * The key of the term inserted or removed: functors, and numbers
+   * of variables in the order of their first occurrences marked by
+   * @b VAR_FLAG
+   */
+  Stack<unsigned> _key;
+
+  static const unsigned VAR_FLAG = 0x80000000u;
+};
+
+};
+
+#endif /* __DiscriminationTree__ */
@@ -0,0 +1,337 @@
+/*
+ * File FeatureVectorIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FeatureVectorIndex.cpp
+ * Implements class FeatureVectorIndex.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/TimeCounter.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Term.hpp"
+
+#include "FeatureVectorIndex.hpp"
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Largest number of predicate and of function symbols with their own
+ * features. Each of them adds a level to the trie, so the limit keeps
+ * the paths short.
+ */
+static const unsigned MAX_SYMBOL_FEATURES = 10;
+
+struct FeatureVectorIndex::Node
+{
+  CLASS_NAME(FeatureVectorIndex::Node);
+  USE_ALLOCATOR(FeatureVectorIndex::Node);
+
+  ~Node()
+  {
+    while (children.isNonEmpty()) {
+      delete children.pop().second;
+    }
+  }
+
+  bool isEmpty() const { return children.isEmpty() && clauses.isEmpty(); }
+
+  /** Children ordered by the value of the feature of this level */
+  Stack<Child> children;
+  /** Clauses with the feature vector of the path, only in nodes of the last level */
+  Stack<Clause*> clauses;
+};
+
+/**
+ * Iterator over the clauses whose features are all at most (when
+ * looking for subsuming clauses) or all at least (when looking for
+ * subsumed clauses) the features of the query.
+ */
+class FeatureVectorIndex::CandidateIterator
+: public IteratorCore<Clause*>
+{
+public:
+  CLASS_NAME(FeatureVectorIndex::CandidateIterator);
+  USE_ALLOCATOR(FeatureVectorIndex::CandidateIterator);
+
+  CandidateIterator(Node* root, const Stack<unsigned>& query, bool subsuming)
+  : _query(query), _subsuming(subsuming), _leaf(0), _leafPos(0)
+  {
+    _nodes.push(std::make_pair(root, 0u));
+  }
+
+  bool hasNext()
+  {
+    while (!_leaf || _leafPos == _leaf->size()) {
+      _leaf = 0;
+      if (_nodes.isEmpty()) {
+        return false;
+      }
+      Node* node = _nodes.top().first;
+      unsigned level = _nodes.pop().second;
+      if (level == _query.size()) {
+        _leaf = &node->clauses;
+        _leafPos = 0;
+        continue;
+      }
+
+      unsigned val = _query[level];
+      Stack<Child>& children = node->children;
+      if (_subsuming) {
+        for (unsigned i = 0; i < children.size() && children[i].first <= val; i++) {
+          _nodes.push(std::make_pair(children[i].second, level+1));
+        }
+      } else {
+        for (unsigned i = children.size(); i > 0 && children[i-1].first >= val; i--) {
+          _nodes.push(std::make_pair(children[i-1].second, level+1));
+        }
+      }
+    }
+    return true;
+  }
+
+  Clause* next()
+  {
+    ASS(_leaf);
+    return (*_leaf)[_leafPos++];
+  }
+
+private:
+  Stack<unsigned> _query;
+  bool _subsuming;
+  /** Nodes to be visited with their levels */
+  Stack<std::pair<Node*,unsigned> > _nodes;
+  Stack<Clause*>* _leaf;
+  unsigned _leafPos;
+};
+
+FeatureVectorIndex::FeatureVectorIndex()
+: _root(new Node())
+{
+  CALL("FeatureVectorIndex::FeatureVectorIndex");
+
+  _predicates = std::min(env.signature->predicates(), MAX_SYMBOL_FEATURES);
+  _functions = std::min(env.signature->functions(), MAX_SYMBOL_FEATURES);
+  //literal counts, predicate features, function features and the shared occurrence features
+  _featureCount = 2 + 2*(_predicates+1) + 4*_functions + 2;
+}
+
+FeatureVectorIndex::~FeatureVectorIndex()
+{
+  recordMemoryUsage();
+  delete _root;
+}
+
+unsigned FeatureVectorIndex::predicateFeature(unsigned pred, unsigned polarity) const
+{
+  return 2 + 2*std::min(pred, _predicates) + polarity;
+}
+
+unsigned FeatureVectorIndex::occurrenceFeature(unsigned fun, unsigned polarity) const
+{
+  unsigned base = 4 + 2*_predicates;
+  return fun < _functions ? base + 4*fun + polarity : base + 4*_functions + polarity;
+}
+
+unsigned FeatureVectorIndex::depthFeature(unsigned fun, unsigned polarity) const
+{
+  ASS_L(fun, _functions);
+  return 4 + 2*_predicates + 4*fun + 2 + polarity;
+}
+
+/**
+ * Store the feature vector of @b cl into @b features.
+ */
+void FeatureVectorIndex::getFeatures(Clause* cl, Stack<unsigned>& features)
+{
+  CALL("FeatureVectorIndex::getFeatures");
+
+  features.reset();
+  for (unsigned i = 0; i < _featureCount; i++) {
+    features.push(0);
+  }
+
+  static Stack<std::pair<TermList*,unsigned> > todo;
+  unsigned clen = cl->length();
+  for (unsigned li = 0; li < clen; li++) {
+    Literal* lit = (*cl)[li];
+    unsigned polarity = lit->isPositive() ? 0 : 1;
+    features[polarity]++;
+    features[predicateFeature(lit->functor(), polarity)]++;
+
+    ASS(todo.isEmpty());
+    for (TermList* arg = lit->args(); arg->isNonEmpty(); arg = arg->next()) {
+      todo.push(std::make_pair(arg, 1u));
+    }
+    while (todo.isNonEmpty()) {
+      TermList* ts = todo.top().first;
+      unsigned depth = todo.pop().second;
+      if (!ts->isTerm() || ts->term()->isSpecial()) {
+        //special terms are left out in both the subsuming and the subsumed clause
+        continue;
+      }
+      Term* t = ts->term();
+      unsigned fun = t->functor();
+      features[occurrenceFeature(fun, polarity)]++;
+      if (fun < _functions) {
+        unsigned& maxDepth = features[depthFeature(fun, polarity)];
+        maxDepth = std::max(maxDepth, depth);
+      }
+      for (TermList* arg = t->args(); arg->isNonEmpty(); arg = arg->next()) {
+        todo.push(std::make_pair(arg, depth+1));
+      }
+    }
+  }
+}
+
+void FeatureVectorIndex::insert(Clause* cl)
+{
+  CALL("FeatureVectorIndex::insert");
+
+  getFeatures(cl, _features);
+
+  Node* node = _root;
+  for (unsigned i = 0; i < _featureCount; i++) {
+    unsigned val = _features[i];
+    Stack<Child>& children = node->children;
+    unsigned pos = 0;
+    while (pos < children.size() && children[pos].first < val) {
+      pos++;
+    }
+    if (pos == children.size() || children[pos].first != val) {
+      children.push(Child());
+      for (unsigned j = children.size()-1; j > pos; j--) {
+        children[j] = children[j-1];
+      }
+      children[pos] = Child(val, new Node());
+    }
+    node = children[pos].second;
+  }
+  node->clauses.push(cl);
+}
+
+void FeatureVectorIndex::remove(Clause* cl)
+{
+  CALL("FeatureVectorIndex::remove");
+
+  getFeatures(cl, _features);
+
+  static Stack<Node*> path;
+  path.reset();
+
+  Node* node = _root;
+  for (unsigned i = 0; i < _featureCount; i++) {
+    path.push(node);
+    unsigned val = _features[i];
+    Stack<Child>& children = node->children;
+    unsigned pos = 0;
+    while (children[pos].first != val) {
+      pos++;
+      ASS_L(pos, children.size());
+    }
+    node = children[pos].second;
+  }
+  ALWAYS(node->clauses.remove(cl));
+
+  //remove the nodes that became empty
+  for (unsigned i = _featureCount; i > 0 && node->isEmpty(); i--) {
+    Node* parent = path[i-1];
+    Stack<Child>& children = parent->children;
+    unsigned pos = 0;
+    while (children[pos].second != node) {
+      pos++;
+    }
+    for (unsigned j = pos+1; j < children.size(); j++) {
+      children[j-1] = children[j];
+    }
+    children.pop();
+    delete node;
+    node = parent;
+  }
+}
+
+void FeatureVectorIndex::handleClause(Clause* c, bool adding)
+{
+  CALL("FeatureVectorIndex::handleClause");
+
+  if (c->length() < 2) {
+    return;
+  }
+
+  TimeCounter tc(TC_FEATURE_VECTOR_INDEX_MAINTENANCE);
+
+  if (adding) {
+    insert(c);
+  } else {
+    remove(c);
+  }
+}
+
+/**
+ * Return the indexed clauses that may subsume @b cl, each of them once.
+ * The index must not change while the iterator is used.
+ */
+ClauseIterator FeatureVectorIndex::getSubsumingCandidates(Clause* cl)
+{
+  CALL("FeatureVectorIndex::getSubsumingCandidates");
+
+  long long start = _stats ? IndexStatistics::now() : 0;
+  getFeatures(cl, _features);
+  ClauseIterator res = vi(new CandidateIterator(_root, _features, true));
+  return _stats ? _stats->monitor(res, start) : res;
+}
+
+/**
+ * Return the indexed clauses that may be subsumed by @b cl, each of
+ * them once. The index must not change while the iterator is used.
+ */
+ClauseIterator FeatureVectorIndex::getSubsumedCandidates(Clause* cl)
+{
+  CALL("FeatureVectorIndex::getSubsumedCandidates");
+
+  long long start = _stats ? IndexStatistics::now() : 0;
+  getFeatures(cl, _features);
+  ClauseIterator res = vi(new CandidateIterator(_root, _features, false));
+  return _stats ? _stats->monitor(res, start) : res;
+}
+
+size_t FeatureVectorIndex::memoryUsage()
+{
+  CALL("FeatureVectorIndex::memoryUsage");
+
+  size_t res = 0;
+  static Stack<Node*> nodes;
+  nodes.reset();
+  nodes.push(_root);
+  while (nodes.isNonEmpty()) {
+    Node* node = nodes.pop();
+    res += sizeof(Node) + node->children.size()*sizeof(Child) + node->clauses.size()*sizeof(Clause*);
+    for (unsigned i = 0; i < node->children.size(); i++) {
+      nodes.push(node->children[i].second);
+    }
+  }
+  return res;
+}
+
+}
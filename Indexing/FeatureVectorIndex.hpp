@@ -0,0 +1,108 @@
+/*
+ * File FeatureVectorIndex.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FeatureVectorIndex.hpp
+ * Defines class FeatureVectorIndex.
+ */
+
+#ifndef __FeatureVectorIndex__
+#define __FeatureVectorIndex__
+
+#include <utility>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Index.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Clause index for forward and backward subsumption that stores
+ * clauses by their feature vectors in a trie (see S. Schulz: Simple
+ * and Efficient Clause Subsumption with Feature Vector Indexing).
+ *
+ * The features are the numbers of positive and negative literals,
+ * the numbers of literals with a given predicate symbol, and the
+ * number of occurrences and the largest depth of a function symbol,
+ * both separately for positive and negative literals. Symbols with
+ * numbers beyond the limits fixed when the index is created share
+ * one occurrence feature per polarity.
+ *
+ * None of the features decreases when a substitution is applied to
+ * a clause or when literals are added to it. A clause can therefore
+ * subsume another one only if each of its features is at most the
+ * feature of the other clause.
+ *
+ * Clauses with less than two literals are not indexed, they are
+ * handled by the unit clause indexes.
+ */
+class FeatureVectorIndex
+: public Index
+{
+public:
+  CLASS_NAME(FeatureVectorIndex);
+  USE_ALLOCATOR(FeatureVectorIndex);
+
+  FeatureVectorIndex();
+  ~FeatureVectorIndex();
+
+  ClauseIterator getSubsumingCandidates(Clause* cl);
+  ClauseIterator getSubsumedCandidates(Clause* cl);
+
+  /** Number of features of a clause */
+  unsigned featureCount() const { return _featureCount; }
+  void getFeatures(Clause* cl, Stack<unsigned>& features);
+
+  size_t memoryUsage() override;
+
+protected:
+  void handleClause(Clause* c, bool adding) override;
+
+private:
+  struct Node;
+  class CandidateIterator;
+
+  typedef std::pair<unsigned,Node*> Child;
+
+  void insert(Clause* cl);
+  void remove(Clause* cl);
+
+  unsigned predicateFeature(unsigned pred, unsigned polarity) const;
+  unsigned occurrenceFeature(unsigned fun, unsigned polarity) const;
+  unsigned depthFeature(unsigned fun, unsigned polarity) const;
+
+  /** Number of predicate symbols with their own features */
+  unsigned _predicates;
+  /** Number of function symbols with their own features */
+  unsigned _functions;
+  unsigned _featureCount;
+
+  Node* _root;
+  /** Feature vector used by insert() and remove() */
+  Stack<unsigned> _features;
+};
+
+};
+
+#endif /* __FeatureVectorIndex__ */
@@ -0,0 +1,451 @@
+/*
+ * File FingerprintIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FingerprintIndex.cpp
+ * Implements class FingerprintIndex.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+#include "Kernel/Matcher.hpp"
+#include "Kernel/RobSubstitution.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "FingerprintIndex.hpp"
+
+namespace Indexing
+{
+
+using namespace Lib;
+using namespace Kernel;
+
+#define QRS_QUERY_BANK 0
+#define QRS_RESULT_BANK 1
+
+/**
+ * The sampled positions, as sequences of argument indexes counted
+ * from zero: the top position, the first three arguments, and the
+ * first two arguments of the first two arguments.
+ */
+static const struct {
+  unsigned length;
+  unsigned path[2];
+} POSITIONS[FingerprintIndex::FINGERPRINT_SIZE] = {
+  {0, {0, 0}},
+  {1, {0, 0}},
+  {1, {1, 0}},
+  {1, {2, 0}},
+  {2, {0, 0}},
+  {2, {0, 1}},
+  {2, {1, 0}},
+  {2, {1, 1}}
+};
+
+/**
+ * Store the fingerprint of @b t into the array @b fingerprint of
+ * FINGERPRINT_SIZE elements.
+ *
+ * Special terms are treated as variables, so their fingerprints are
+ * compatible with those of all terms they may unify with.
+ */
+void FingerprintIndex::getFingerprint(TermList t, unsigned* fingerprint)
+{
+  CALL("FingerprintIndex::getFingerprint");
+
+  for (unsigned i = 0; i < FINGERPRINT_SIZE; i++) {
+    unsigned length = POSITIONS[i].length;
+    TermList curr = t;
+    unsigned depth = 0;
+    for (;;) {
+      if (curr.isVar() || curr.term()->isSpecial()) {
+        fingerprint[i] = depth == length ? VARIABLE : BELOW_VARIABLE;
+        break;
+      }
+      Term* trm = curr.term();
+      if (depth == length) {
+        fingerprint[i] = trm->functor() + FUNCTOR_OFFSET;
+        break;
+      }
+      unsigned argIndex = POSITIONS[i].path[depth];
+      if (argIndex >= trm->arity()) {
+        fingerprint[i] = NOT_EXISTING;
+        break;
+      }
+      curr = *trm->nthArgument(argIndex);
+      depth++;
+    }
+  }
+}
+
+/**
+ * Return true if a term with the value @b indexedValue at a position
+ * may be retrieved by a query with the value @b queryValue there.
+ */
+bool FingerprintIndex::compatible(RetrievalKind kind, unsigned queryValue, unsigned indexedValue)
+{
+  switch (kind) {
+  case UNIFICATIONS:
+    if (queryValue == BELOW_VARIABLE || indexedValue == BELOW_VARIABLE) {
+      return true;
+    }
+    if (queryValue == NOT_EXISTING || indexedValue == NOT_EXISTING) {
+      return queryValue == indexedValue;
+    }
+    return queryValue == VARIABLE || indexedValue == VARIABLE || queryValue == indexedValue;
+  case GENERALIZATIONS:
+    if (indexedValue == BELOW_VARIABLE) {
+      return true;
+    }
+    if (indexedValue == VARIABLE) {
+      return queryValue == VARIABLE || queryValue >= FUNCTOR_OFFSET;
+    }
+    return queryValue == indexedValue;
+  case INSTANCES:
+    if (queryValue == BELOW_VARIABLE) {
+      return true;
+    }
+    if (queryValue == VARIABLE) {
+      return indexedValue == VARIABLE || indexedValue >= FUNCTOR_OFFSET;
+    }
+    return queryValue == indexedValue;
+  case ALL_WITH_TOP:
+    return queryValue == indexedValue;
+  }
+  ASSERTION_VIOLATION;
+  return false;
+}
+
+struct FingerprintIndex::Node
+{
+  CLASS_NAME(FingerprintIndex::Node);
+  USE_ALLOCATOR(FingerprintIndex::Node);
+
+  ~Node()
+  {
+    while (children.isNonEmpty()) {
+      delete children.pop().second;
+    }
+  }
+
+  bool isEmpty() const { return children.isEmpty() && leaves.isEmpty(); }
+
+  /** Return the index of the child with the value @b val in @b children, or the index where it belongs */
+  unsigned findChild(unsigned val) const
+  {
+    unsigned lo = 0;
+    unsigned hi = children.size();
+    while (lo < hi) {
+      unsigned mid = (lo + hi) / 2;
+      if (children[mid].first < val) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  /** Children ordered by the value of the position of this level */
+  Stack<Child> children;
+  /** Entries with the fingerprint of the path, only in nodes of the last level */
+  Stack<LeafData> leaves;
+};
+
+/**
+ * Iterator over the entries whose fingerprints are compatible with
+ * the fingerprint of the query.
+ */
+class FingerprintIndex::CandidateIterator
+{
+public:
+  CandidateIterator(Node* root, TermList query, RetrievalKind kind)
+  : _kind(kind), _leaf(0), _leafPos(0)
+  {
+    getFingerprint(query, _query);
+    _nodes.push(std::make_pair(root, 0u));
+  }
+
+  bool hasNext()
+  {
+    while (!_leaf || _leafPos == _leaf->size()) {
+      _leaf = 0;
+      if (_nodes.isEmpty()) {
+        return false;
+      }
+      Node* node = _nodes.top().first;
+      unsigned level = _nodes.pop().second;
+      if (level == FINGERPRINT_SIZE) {
+        _leaf = &node->leaves;
+        _leafPos = 0;
+        continue;
+      }
+      pushChildren(node, level);
+    }
+    return true;
+  }
+
+  LeafData& next()
+  {
+    ASS(_leaf);
+    return (*_leaf)[_leafPos++];
+  }
+
+private:
+  void pushChildren(Node* node, unsigned level)
+  {
+    Stack<Child>& children = node->children;
+    if (_kind == ALL_WITH_TOP && level > 0) {
+      for (unsigned i = 0; i < children.size(); i++) {
+        _nodes.push(std::make_pair(children[i].second, level+1));
+      }
+      return;
+    }
+
+    unsigned val = _query[level];
+    if (val < FUNCTOR_OFFSET) {
+      for (unsigned i = 0; i < children.size(); i++) {
+        if (compatible(_kind, val, children[i].first)) {
+          _nodes.push(std::make_pair(children[i].second, level+1));
+        }
+      }
+      return;
+    }
+
+    //the children with the other values that may be compatible precede the functors
+    for (unsigned i = 0; i < children.size() && children[i].first < FUNCTOR_OFFSET; i++) {
+      if (compatible(_kind, val, children[i].first)) {
+        _nodes.push(std::make_pair(children[i].second, level+1));
+      }
+    }
+    unsigned pos = node->findChild(val);
+    if (pos < children.size() && children[pos].first == val) {
+      _nodes.push(std::make_pair(children[pos].second, level+1));
+    }
+  }
+
+  RetrievalKind _kind;
+  unsigned _query[FINGERPRINT_SIZE];
+  /** Nodes to be visited with their levels */
+  Stack<std::pair<Node*,unsigned> > _nodes;
+  Stack<LeafData>* _leaf;
+  unsigned _leafPos;
+};
+
+/**
+ * Iterator over the candidates of a query that pass the unification
+ * or matching check.
+ */
+class FingerprintIndex::ResultIterator
+: public IteratorCore<TermQueryResult>
+{
+public:
+  CLASS_NAME(FingerprintIndex::ResultIterator);
+  USE_ALLOCATOR(FingerprintIndex::ResultIterator);
+
+  ResultIterator(Node* root, TermList query, RetrievalKind kind, bool retrieveSubstitutions)
+  : _query(query), _kind(kind), _retrieveSubstitutions(retrieveSubstitutions),
+    _binder(_bindings), _candidates(root, query, kind), _found(0)
+  {
+    if (retrieveSubstitutions) {
+      if (kind == UNIFICATIONS) {
+        _subst = ResultSubstitution::fromSubstitution(&_unifier, QRS_QUERY_BANK, QRS_RESULT_BANK);
+      } else {
+        _subst = ResultSubstitutionSP(new MatchingResultSubstitution(&_bindings, kind == GENERALIZATIONS));
+      }
+    }
+  }
+
+  bool hasNext()
+  {
+    CALL("FingerprintIndex::ResultIterator::hasNext");
+
+    while (!_found && _candidates.hasNext()) {
+      LeafData& ld = _candidates.next();
+      env.statistics->fingerprintIndexCandidates++;
+      if (check(ld)) {
+        env.statistics->fingerprintIndexHits++;
+        _found = &ld;
+      }
+    }
+    return _found;
+  }
+
+  TermQueryResult next()
+  {
+    CALL("FingerprintIndex::ResultIterator::next");
+    ASS(_found);
+
+    LeafData* ld = _found;
+    _found = 0;
+    if (_retrieveSubstitutions) {
+      return TermQueryResult(ld->term, ld->literal, ld->clause, _subst);
+    }
+    return TermQueryResult(ld->term, ld->literal, ld->clause);
+  }
+
+private:
+  typedef MatchingResultSubstitution::BindingMap BindingMap;
+
+  bool check(LeafData& ld)
+  {
+    switch (_kind) {
+    case GENERALIZATIONS:
+      _bindings.reset();
+      return MatchingUtils::matchTerms(ld.term, _query, _binder);
+    case INSTANCES:
+      _bindings.reset();
+      return MatchingUtils::matchTerms(_query, ld.term, _binder);
+    case UNIFICATIONS:
+      _unifier.reset();
+      return _unifier.unify(_query, QRS_QUERY_BANK, ld.term, QRS_RESULT_BANK);
+    case ALL_WITH_TOP:
+      return true;
+    }
+    ASSERTION_VIOLATION;
+    return false;
+  }
+
+  TermList _query;
+  RetrievalKind _kind;
+  bool _retrieveSubstitutions;
+  BindingMap _bindings;
+  MatchingUtils::MapRefBinder<BindingMap> _binder;
+  RobSubstitution _unifier;
+  ResultSubstitutionSP _subst;
+  CandidateIterator _candidates;
+  LeafData* _found;
+};
+
+FingerprintIndex::FingerprintIndex()
+: _root(new Node())
+{
+}
+
+FingerprintIndex::~FingerprintIndex()
+{
+  delete _root;
+}
+
+void FingerprintIndex::insert(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("FingerprintIndex::insert");
+
+  unsigned fingerprint[FINGERPRINT_SIZE];
+  getFingerprint(t, fingerprint);
+
+  Node* node = _root;
+  for (unsigned i = 0; i < FINGERPRINT_SIZE; i++) {
+    unsigned val = fingerprint[i];
+    Stack<Child>& children = node->children;
+    unsigned pos = node->findChild(val);
+    if (pos == children.size() || children[pos].first != val) {
+      children.push(Child());
+      for (unsigned j = children.size()-1; j > pos; j--) {
+        children[j] = children[j-1];
+      }
+      children[pos] = Child(val, new Node());
+    }
+    node = children[pos].second;
+  }
+  node->leaves.push(LeafData(cls, lit, t));
+}
+
+void FingerprintIndex::remove(TermList t, Literal* lit, Clause* cls)
+{
+  CALL("FingerprintIndex::remove");
+
+  unsigned fingerprint[FINGERPRINT_SIZE];
+  getFingerprint(t, fingerprint);
+
+  Node* path[FINGERPRINT_SIZE];
+  unsigned positions[FINGERPRINT_SIZE];
+  Node* node = _root;
+  for (unsigned i = 0; i < FINGERPRINT_SIZE; i++) {
+    path[i] = node;
+    positions[i] = node->findChild(fingerprint[i]);
+    ASS_L(positions[i], node->children.size());
+    ASS_EQ(node->children[positions[i]].first, fingerprint[i]);
+    node = node->children[positions[i]].second;
+  }
+  ALWAYS(node->leaves.remove(LeafData(cls, lit, t)));
+
+  //remove the nodes that became empty
+  for (unsigned i = FINGERPRINT_SIZE; i > 0 && node->isEmpty(); i--) {
+    Stack<Child>& children = path[i-1]->children;
+    for (unsigned j = positions[i-1]+1; j < children.size(); j++) {
+      children[j-1] = children[j];
+    }
+    children.pop();
+    delete node;
+    node = path[i-1];
+  }
+}
+
+TermQueryResultIterator FingerprintIndex::getUnifications(TermList t, bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getUnifications");
+  return vi( new ResultIterator(_root, t, UNIFICATIONS, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator FingerprintIndex::getGeneralizations(TermList t, bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getGeneralizations");
+  return vi( new ResultIterator(_root, t, GENERALIZATIONS, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator FingerprintIndex::getInstances(TermList t, bool retrieveSubstitutions)
+{
+  CALL("FingerprintIndex::getInstances");
+  return vi( new ResultIterator(_root, t, INSTANCES, retrieveSubstitutions) );
+}
+
+TermQueryResultIterator FingerprintIndex::getAllWithTop(TermList t)
+{
+  CALL("FingerprintIndex::getAllWithTop");
+  ASS(t.isTerm());
+  return vi( new ResultIterator(_root, t, ALL_WITH_TOP, false) );
+}
+
+bool FingerprintIndex::generalizationExists(TermList t)
+{
+  CALL("FingerprintIndex::generalizationExists");
+  return ResultIterator(_root, t, GENERALIZATIONS, false).hasNext();
+}
+
+size_t FingerprintIndex::memoryUsage()
+{
+  CALL("FingerprintIndex::memoryUsage");
+
+  size_t res = 0;
+  static Stack<Node*> nodes;
+  nodes.reset();
+  nodes.push(_root);
+  while (nodes.isNonEmpty()) {
+    Node* node = nodes.pop();
+    res += sizeof(Node) + node->children.size()*sizeof(Child) + node->leaves.size()*sizeof(LeafData);
+    for (unsigned i = 0; i < node->children.size(); i++) {
+      nodes.push(node->children[i].second);
+    }
+  }
+  return res;
+}
+
+}
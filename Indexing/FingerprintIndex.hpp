@@ -0,0 +1,117 @@
+/*
+ * File FingerprintIndex.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FingerprintIndex.hpp
+ * Defines class FingerprintIndex.
+ */
+
+#ifndef __FingerprintIndex__
+#define __FingerprintIndex__
+
+#include <utility>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
+
+#include "SubstitutionTree.hpp"
+#include "TermIndexingStructure.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Term indexing structure using fingerprint indexing (see S. Schulz:
+ * Fingerprint Indexing for Paramodulation and Rewriting).
+ *
+ * The fingerprint of a term consists of the symbols at a fixed set of
+ * sampled positions. The value at a position is the functor of the
+ * subterm there, or tells that there is a variable at the position,
+ * that the position is below a variable, or that the position does not
+ * exist. Two terms can only unify (or match) if their values at each
+ * sampled position are compatible. The terms are stored in a trie
+ * keyed by their fingerprints, and the terms with compatible
+ * fingerprints are checked by unification or matching.
+ */
+class FingerprintIndex
+: public TermIndexingStructure
+{
+public:
+  CLASS_NAME(FingerprintIndex);
+  USE_ALLOCATOR(FingerprintIndex);
+
+  FingerprintIndex();
+  ~FingerprintIndex();
+
+  void insert(TermList t, Literal* lit, Clause* cls);
+  void remove(TermList t, Literal* lit, Clause* cls);
+
+  TermQueryResultIterator getUnifications(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getGeneralizations(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getInstances(TermList t, bool retrieveSubstitutions = true);
+  TermQueryResultIterator getAllWithTop(TermList t);
+
+  bool generalizationExists(TermList t);
+
+  size_t memoryUsage();
+
+#if VDEBUG
+  virtual void markTagged() {}
+#endif
+
+  enum RetrievalKind {
+    GENERALIZATIONS,
+    INSTANCES,
+    UNIFICATIONS,
+    /** all entries with the top symbol of the query */
+    ALL_WITH_TOP
+  };
+
+  /** Value of a position with a variable */
+  static const unsigned VARIABLE = 0;
+  /** Value of a position below a variable */
+  static const unsigned BELOW_VARIABLE = 1;
+  /** Value of a position that does not exist and is not below a variable */
+  static const unsigned NOT_EXISTING = 2;
+  /** Values of other positions are their functors plus this */
+  static const unsigned FUNCTOR_OFFSET = 3;
+
+  /** Number of sampled positions */
+  static const unsigned FINGERPRINT_SIZE = 8;
+
+  static void getFingerprint(TermList t, unsigned* fingerprint);
+  static bool compatible(RetrievalKind kind, unsigned queryValue, unsigned indexedValue);
+
+private:
+  typedef SubstitutionTree::LeafData LeafData;
+
+  struct Node;
+  class CandidateIterator;
+  class ResultIterator;
+
+  typedef std::pair<unsigned,Node*> Child;
+
+  Node* _root;
+};
+
+};
+
+#endif /* __FingerprintIndex__ */
@@ -54,4 +54,53 @@ void Index::attachContainer(ClauseContainer* cc)
   _removedSD = cc->removedEvent.subscribe(this,&Index::onRemovedFromContainer);
 }
 
+/**
+ * Collect retrieval statistics of the index into @b stats
+ *
+ * Must be called before any clause is added to the index.
+ */
+void Index::collectStatistics(IndexStatistics* stats)
+{
+  CALL("Index::collectStatistics");
+  ASS(!_stats);
+
+  _stats = stats;
+}
+
+void Index::updateClauseCount(bool adding)
+{
+  CALL("Index::updateClauseCount");
+  ASS(_stats);
+
+  if(!adding) {
+    if(_stats->clauses) {
+      _stats->clauses--;
+    }
+    return;
+  }
+  _stats->clauses++;
+  if(_stats->clauses > _stats->maxClauses) {
+    _stats->maxClauses = _stats->clauses;
+    //sampling at powers of two takes time linear in the final size in total
+    if(!(_stats->maxClauses & (_stats->maxClauses-1))) {
+      recordMemoryUsage();
+    }
+  }
+}
+
+/**
+ * Record the memory taken by the indexing structure in the statistics
+ *
+ * Is also called by the destructors of indexes that own their
+ * indexing structure, before they destroy it.
+ */
+void Index::recordMemoryUsage()
+{
+  CALL("Index::recordMemoryUsage");
+
+  if(_stats) {
+    _stats->recordMemoryUsage(memoryUsage());
+  }
+}
+
 }
@@ -30,6 +30,7 @@
 #include "Lib/Exception.hpp"
 #include "Lib/VirtualIterator.hpp"
 #include "Saturation/ClauseContainer.hpp"
+#include "IndexStatistics.hpp"
 #include "ResultSubstitution.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -129,16 +130,40 @@ public:
   virtual ~Index();
 
   void attachContainer(ClauseContainer* cc);
+
+  void collectStatistics(IndexStatistics* stats);
+
+  /** Record that a candidate returned by the index passed the final check of an inference */
+  void candidateAccepted()
+  { if(_stats) { _stats->accepted++; } }
+
+  /**
+   * Return an estimate of the memory in bytes taken by the indexing
+   * structure, or zero if it is not known
+   */
+  virtual size_t memoryUsage() { return 0; }
 protected:
-  Index() {}
+  Index() : _stats(0) {}
 
   void onAddedToContainer(Clause* c)
-  { handleClause(c, true); }
+  {
+    handleClause(c, true);
+    if(_stats) { updateClauseCount(true); }
+  }
   void onRemovedFromContainer(Clause* c)
-  { handleClause(c, false); }
+  {
+    handleClause(c, false);
+    if(_stats) { updateClauseCount(false); }
+  }
 
   virtual void handleClause(Clause* c, bool adding) {}
 
+  void updateClauseCount(bool adding);
+  void recordMemoryUsage();
+
+  /** Retrieval statistics, or zero if they are not collected */
+  IndexStatistics* _stats;
+
   //TODO: postponing index modifications during iteration (methods isBeingIterated() etc...)
 
 private:
@@ -27,9 +27,15 @@
 
 #include "Saturation/SaturationAlgorithm.hpp"
 
+#include "Shell/Statistics.hpp"
+
 #include "AcyclicityIndex.hpp"
 #include "ArithmeticIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
+#include "CompactSubstitutionTree.hpp"
+#include "DiscriminationTree.hpp"
+#include "FeatureVectorIndex.hpp"
+#include "FingerprintIndex.hpp"
 #include "GroundingIndex.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
@@ -142,6 +148,115 @@ void IndexManager::provideIndex(IndexType t, Index* index)
   _store.set(t,e);
 }
 
+/**
+ * Return a new literal substitution tree for an index used by generating
+ * inferences if @b generating is true, and by simplifications otherwise.
+ * The option compact_substitution_trees decides which implementation is used.
+ */
+LiteralIndexingStructure* IndexManager::newLiteralSubstitutionTree(bool generating, bool useConstraints)
+{
+  CALL("IndexManager::newLiteralSubstitutionTree");
+
+  if(!useConstraints && useCompactSubstitutionTree(generating)) {
+    return new CompactLiteralSubstitutionTree();
+  }
+  return new LiteralSubstitutionTree(useConstraints);
+}
+
+/**
+ * Return a new term substitution tree, see newLiteralSubstitutionTree().
+ */
+TermIndexingStructure* IndexManager::newTermSubstitutionTree(bool generating, bool useConstraints)
+{
+  CALL("IndexManager::newTermSubstitutionTree");
+
+  if(!useConstraints && useCompactSubstitutionTree(generating)) {
+    return new CompactTermSubstitutionTree();
+  }
+  return new TermSubstitutionTree(useConstraints);
+}
+
+bool IndexManager::useCompactSubstitutionTree(bool generating)
+{
+  switch(env.options->compactSubstitutionTrees()) {
+  case Options::CompactSubstitutionTrees::OFF:
+    return false;
+  case Options::CompactSubstitutionTrees::GENERATING:
+    return generating;
+  case Options::CompactSubstitutionTrees::SIMPLIFYING:
+    return !generating;
+  case Options::CompactSubstitutionTrees::ALL:
+    return true;
+  }
+  ASSERTION_VIOLATION;
+  return false;
+}
+
+/**
+ * Return true if the subterm index @b t should use a fingerprint
+ * index, as decided by the option fingerprint_indexing.
+ */
+bool IndexManager::useFingerprintIndex(IndexType t)
+{
+  switch(env.options->fingerprintIndexing()) {
+  case Options::FingerprintIndexing::OFF:
+    return false;
+  case Options::FingerprintIndexing::SUPERPOSITION:
+    return t==SUPERPOSITION_SUBTERM_SUBST_TREE;
+  case Options::FingerprintIndexing::DEMODULATION:
+    return t==DEMODULATION_SUBTERM_SUBST_TREE;
+  case Options::FingerprintIndexing::ALL:
+    return t==SUPERPOSITION_SUBTERM_SUBST_TREE || t==DEMODULATION_SUBTERM_SUBST_TREE;
+  }
+  ASSERTION_VIOLATION;
+  return false;
+}
+
+/**
+ * Return the name of index type @b t used in the statistics
+ */
+const char* IndexManager::indexTypeName(IndexType t)
+{
+  switch(t) {
+  case GENERATING_SUBST_TREE:
+    return "generating_literals";
+  case SIMPLIFYING_SUBST_TREE:
+    return "simplifying_literals";
+  case SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE:
+    return "simplifying_unit_clauses";
+  case GENERATING_UNIT_CLAUSE_SUBST_TREE:
+    return "generating_unit_clauses";
+  case GENERATING_NON_UNIT_CLAUSE_SUBST_TREE:
+    return "generating_non_unit_clauses";
+  case SUPERPOSITION_SUBTERM_SUBST_TREE:
+    return "superposition_subterms";
+  case SUPERPOSITION_LHS_SUBST_TREE:
+    return "superposition_lhs";
+  case DEMODULATION_SUBTERM_SUBST_TREE:
+    return "demodulation_subterms";
+  case DEMODULATION_LHS_SUBST_TREE:
+    return "demodulation_lhs";
+  case FW_SUBSUMPTION_CODE_TREE:
+    return "forward_subsumption_code_tree";
+  case FW_SUBSUMPTION_SUBST_TREE:
+    return "forward_subsumption_literals";
+  case BW_SUBSUMPTION_SUBST_TREE:
+    return "backward_subsumption_literals";
+  case SUBSUMPTION_FEATURE_VECTOR_INDEX:
+    return "subsumption_feature_vectors";
+  case FSD_SUBST_TREE:
+    return "subsumption_demodulation_literals";
+  case REWRITE_RULE_SUBST_TREE:
+    return "rewrite_rules";
+  case GLOBAL_SUBSUMPTION_INDEX:
+    return "global_subsumption";
+  case ACYCLICITY_INDEX:
+    return "acyclicity";
+  }
+  ASSERTION_VIOLATION;
+  return "unknown";
+}
+
 Index* IndexManager::create(IndexType t)
 {
   CALL("IndexManager::create");
@@ -155,7 +270,7 @@ Index* IndexManager::create(IndexType t)
 
   switch(t) {
   case GENERATING_SUBST_TREE:
-    is=new LiteralSubstitutionTree(useConstraints);
+    is=newLiteralSubstitutionTree(true, useConstraints);
 #if VDEBUG
     //is->markTagged();
 #endif
@@ -164,29 +279,34 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case SIMPLIFYING_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=newLiteralSubstitutionTree(false);
     res=new SimplifyingLiteralIndex(is);
     isGenerating = false;
     break;
 
   case SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=newLiteralSubstitutionTree(false);
     res=new UnitClauseLiteralIndex(is);
     isGenerating = false;
     break;
   case GENERATING_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=newLiteralSubstitutionTree(true);
     res=new UnitClauseLiteralIndex(is);
     isGenerating = true;
     break;
   case GENERATING_NON_UNIT_CLAUSE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=newLiteralSubstitutionTree(true);
     res=new NonUnitClauseLiteralIndex(is);
     isGenerating = true;
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    if(!useConstraints && useFingerprintIndex(t)) {
+      tis=new FingerprintIndex();
+    }
+    else {
+      tis=newTermSubstitutionTree(true, useConstraints);
+    }
 #if VDEBUG
     //tis->markTagged();
 #endif
@@ -194,7 +314,7 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case SUPERPOSITION_LHS_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=newTermSubstitutionTree(true, useConstraints);
     res=new SuperpositionLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
@@ -206,13 +326,22 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case DEMODULATION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree();
+    if(useFingerprintIndex(t)) {
+      tis=new FingerprintIndex();
+    }
+    else {
+      tis=newTermSubstitutionTree(false);
+    }
     res=new DemodulationSubtermIndex(tis);
     isGenerating = false;
     break;
   case DEMODULATION_LHS_SUBST_TREE:
 //    tis=new TermSubstitutionTree();
-    tis=new CodeTreeTIS();
+    if (_alg->getOptions().demodulationLHSIndex() == Options::DemodulationLHSIndex::DISCRIMINATION_TREE) {
+      tis=new DiscriminationTree();
+    } else {
+      tis=new CodeTreeTIS();
+    }
     res=new DemodulationLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = false;
     break;
@@ -223,20 +352,25 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case FW_SUBSUMPTION_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=newLiteralSubstitutionTree(false);
 //    is=new CodeTreeLIS();
     res=new FwSubsSimplifyingLiteralIndex(is);
     isGenerating = false;
     break;
 
+  case SUBSUMPTION_FEATURE_VECTOR_INDEX:
+    res=new FeatureVectorIndex();
+    isGenerating = false;
+    break;
+
   case FSD_SUBST_TREE:
-    is = new LiteralSubstitutionTree();
+    is = newLiteralSubstitutionTree(false);
     res = new FSDLiteralIndex(is);
     isGenerating = false;
     break;
 
   case REWRITE_RULE_SUBST_TREE:
-    is=new LiteralSubstitutionTree();
+    is=newLiteralSubstitutionTree(false);
     res=new RewriteRuleIndex(is, _alg->getOrdering());
     isGenerating = false;
     break;
@@ -254,6 +388,11 @@ Index* IndexManager::create(IndexType t)
   default:
     INVALID_OPERATION("Unsupported IndexType.");
   }
+  if(env.options->indexStatistics()!=Options::IndexStatistics::OFF) {
+    IndexStatistics* stats=new IndexStatistics(indexTypeName(t));
+    env.statistics->indexStatistics.push(stats);
+    res->collectStatistics(stats);
+  }
   if(isGenerating) {
     res->attachContainer(_alg->getGeneratingClauseContainer());
   }
@@ -53,6 +53,7 @@ enum IndexType {
 
   FW_SUBSUMPTION_SUBST_TREE,
   BW_SUBSUMPTION_SUBST_TREE,
+  SUBSUMPTION_FEATURE_VECTOR_INDEX,
 
   FSD_SUBST_TREE,
 
@@ -82,6 +83,8 @@ public:
   void provideIndex(IndexType t, Index* index);
 
   LiteralIndexingStructure* getGeneratingLiteralIndexingStructure() { ASS(_genLitIndex); return _genLitIndex; };
+
+  static const char* indexTypeName(IndexType t);
 private:
 
   void attach(SaturationAlgorithm* salg);
@@ -96,6 +99,10 @@ private:
   LiteralIndexingStructure* _genLitIndex;
 
   Index* create(IndexType t);
+  LiteralIndexingStructure* newLiteralSubstitutionTree(bool generating, bool useConstraints=false);
+  TermIndexingStructure* newTermSubstitutionTree(bool generating, bool useConstraints=false);
+  bool useCompactSubstitutionTree(bool generating);
+  bool useFingerprintIndex(IndexType t);
 };
 
 };
@@ -0,0 +1,65 @@
+/*
+ * File IndexStatistics.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file IndexStatistics.cpp
+ * Implements struct IndexStatistics.
+ */
+
+#include "IndexStatistics.hpp"
+
+namespace Indexing
+{
+
+IndexStatistics::IndexStatistics(const char* name)
+: name(name), queries(0), candidates(0), accepted(0),
+  clauses(0), maxClauses(0), sampledMemory(0), sampledClauses(0)
+{
+  for(unsigned i=0;i<LATENCY_BUCKETS;i++) {
+    latencies[i]=0;
+  }
+}
+
+void IndexStatistics::recordQuery(long long nanoseconds)
+{
+  CALL("IndexStatistics::recordQuery");
+
+  queries++;
+  unsigned bucket=0;
+  while(nanoseconds>1 && bucket<LATENCY_BUCKETS-1) {
+    nanoseconds>>=1;
+    bucket++;
+  }
+  latencies[bucket]++;
+}
+
+/**
+ * Record that the indexing structure takes @b bytes of memory with
+ * the current number of clauses in the index
+ */
+void IndexStatistics::recordMemoryUsage(size_t bytes)
+{
+  CALL("IndexStatistics::recordMemoryUsage");
+
+  if(!bytes || !clauses) {
+    return;
+  }
+  sampledMemory=bytes;
+  sampledClauses=clauses;
+}
+
+}
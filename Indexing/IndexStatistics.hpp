@@ -0,0 +1,148 @@
+/*
+ * File IndexStatistics.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file IndexStatistics.hpp
+ * Defines struct IndexStatistics.
+ */
+
+#ifndef __IndexStatistics__
+#define __IndexStatistics__
+
+#include <chrono>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+
+/**
+ * Retrieval statistics of one index, collected when the option
+ * index_statistics is not off.
+ *
+ * The objects are owned by Shell::Statistics, so that the statistics
+ * of indexes released before the end of the run are reported as well.
+ */
+struct IndexStatistics
+{
+  CLASS_NAME(IndexStatistics);
+  USE_ALLOCATOR(IndexStatistics);
+
+  IndexStatistics(const char* name);
+
+  /** Current time in nanoseconds, for measuring query latencies */
+  static long long now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  void recordQuery(long long nanoseconds);
+  void recordMemoryUsage(size_t bytes);
+
+  /** Bytes per clause in the last memory sample, or zero if there is none */
+  size_t bytesPerClause() const { return sampledClauses ? sampledMemory/sampledClauses : 0; }
+
+  template<typename T>
+  class MonitoredIterator;
+
+  /**
+   * Return an iterator over the results of @b it, which counts the
+   * candidates and records the latency of the query when destroyed.
+   * @b start is the time when the query was made.
+   */
+  template<typename T>
+  VirtualIterator<T> monitor(VirtualIterator<T> it, long long start)
+  {
+    return vi( new MonitoredIterator<T>(this, it, now()-start) );
+  }
+
+  /** Name of the index */
+  const char* name;
+
+  /** Number of queries */
+  unsigned long queries;
+  /** Number of candidates returned by the queries */
+  unsigned long candidates;
+  /** Number of candidates accepted by the final check of an inference */
+  unsigned long accepted;
+
+  /**
+   * Number of clauses added to the index and not removed from it;
+   * an index may store only some of them, e.g. the non-unit ones
+   */
+  unsigned clauses;
+  /** Largest value of @b clauses */
+  unsigned maxClauses;
+  /** Estimated memory of the indexing structure in the last sample */
+  size_t sampledMemory;
+  /** Number of clauses in the index in the last memory sample */
+  unsigned sampledClauses;
+
+  static const unsigned LATENCY_BUCKETS = 32;
+  /**
+   * Number of queries by the time spent in the index: bucket @b i
+   * counts the queries that took from 2^i to 2^(i+1)-1 nanoseconds,
+   * the last bucket also the longer ones
+   */
+  unsigned long latencies[LATENCY_BUCKETS];
+};
+
+/**
+ * Iterator over the results of a query, which measures the time spent
+ * in the index: the query itself, and the calls of hasNext() and next().
+ */
+template<typename T>
+class IndexStatistics::MonitoredIterator
+: public IteratorCore<T>
+{
+public:
+  CLASS_NAME(IndexStatistics::MonitoredIterator);
+  USE_ALLOCATOR(MonitoredIterator);
+
+  MonitoredIterator(IndexStatistics* stats, VirtualIterator<T> inner, long long elapsed)
+  : _stats(stats), _inner(inner), _elapsed(elapsed) {}
+  ~MonitoredIterator() { _stats->recordQuery(_elapsed); }
+
+  bool hasNext()
+  {
+    long long start=now();
+    bool res=_inner.hasNext();
+    _elapsed+=now()-start;
+    return res;
+  }
+  T next()
+  {
+    long long start=now();
+    T res=_inner.next();
+    _elapsed+=now()-start;
+    _stats->candidates++;
+    return res;
+  }
+private:
+  IndexStatistics* _stats;
+  VirtualIterator<T> _inner;
+  long long _elapsed;
+};
+
+};
+
+#endif /* __IndexStatistics__ */
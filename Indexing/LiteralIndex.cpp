@@ -38,37 +38,84 @@ namespace Indexing
 
 using namespace Kernel;
 
+/**
+ * The memory of the indexing structure is recorded in the statistics
+ * before it is destroyed.
+ */
 LiteralIndex::~LiteralIndex()
 {
+  recordMemoryUsage();
   delete _is;
 }
 
 SLQueryResultIterator LiteralIndex::getAll()
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getAll(), start);
+  }
   return _is->getAll();
 }
 
 SLQueryResultIterator LiteralIndex::getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getUnifications(lit, complementary, retrieveSubstitutions), start);
+  }
   return _is->getUnifications(lit, complementary, retrieveSubstitutions);
 }
 
 SLQueryResultIterator LiteralIndex::getUnificationsWithConstraints(Literal* lit,
           bool complementary, bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions), start);
+  }
   return _is->getUnificationsWithConstraints(lit, complementary, retrieveSubstitutions);
 }
 
 SLQueryResultIterator LiteralIndex::getGeneralizations(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getGeneralizations(lit, complementary, retrieveSubstitutions), start);
+  }
   return _is->getGeneralizations(lit, complementary, retrieveSubstitutions);
 }
 
+/**
+ * Retrieve the generalizations of all literals of @b cl, putting those of
+ * the i-th literal into @b results[i]. In the statistics, each literal
+ * counts as a query taking an equal share of the time.
+ */
+void LiteralIndex::getGeneralizations(Clause* cl, bool complementary,
+	DArray<Stack<SLQueryResult> >& results)
+{
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    _is->getGeneralizations(cl, complementary, results);
+    long long elapsed=IndexStatistics::now()-start;
+    unsigned clen=cl->length();
+    for(unsigned i=0;i<clen;i++) {
+      _stats->recordQuery(elapsed/clen);
+      _stats->candidates+=results[i].size();
+    }
+    return;
+  }
+  _is->getGeneralizations(cl, complementary, results);
+}
+
 SLQueryResultIterator LiteralIndex::getInstances(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getInstances(lit, complementary, retrieveSubstitutions), start);
+  }
   return _is->getInstances(lit, complementary, retrieveSubstitutions);
 }
 
@@ -77,6 +124,11 @@ size_t LiteralIndex::getUnificationCount(Literal* lit, bool complementary)
   return _is->getUnificationCount(lit, complementary);
 }
 
+size_t LiteralIndex::memoryUsage()
+{
+  return _is->memoryUsage();
+}
+
 void LiteralIndex::handleLiteral(Literal* lit, Clause* cl, bool add)
 {
   CALL("LiteralIndex::handleLiteral");
@@ -25,7 +25,9 @@
 #ifndef __LiteralIndex__
 #define __LiteralIndex__
 
+#include "Lib/DArray.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
 
 #include "Index.hpp"
 
@@ -52,11 +54,15 @@ public:
   SLQueryResultIterator getGeneralizations(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions = true);
 
+  void getGeneralizations(Clause* cl, bool complementary,
+	  DArray<Stack<SLQueryResult> >& results);
+
   SLQueryResultIterator getInstances(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions = true);
 
   size_t getUnificationCount(Literal* lit, bool complementary);
 
+  size_t memoryUsage();
 
 protected:
   LiteralIndex(LiteralIndexingStructure* is) : _is(is) {}
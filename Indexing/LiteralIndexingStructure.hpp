@@ -26,6 +26,12 @@
 #define __LiteralIndexingStructure__
 
 #include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+
 #include "Index.hpp"
 
 namespace Indexing {
@@ -44,6 +50,25 @@ public:
           bool complementary, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual SLQueryResultIterator getGeneralizations(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
+  /**
+   * Retrieve the generalizations of all literals of @b cl, without
+   * substitutions, and put those of the i-th literal into @b results[i].
+   * The array is resized to the length of @b cl. Structures that can
+   * retrieve several literals at once override this; by default the
+   * literals are retrieved one by one.
+   */
+  virtual void getGeneralizations(Clause* cl, bool complementary,
+	  DArray<Stack<SLQueryResult> >& results)
+  {
+    CALL("LiteralIndexingStructure::getGeneralizations/3");
+
+    unsigned clen=cl->length();
+    results.ensure(clen);
+    for(unsigned i=0;i<clen;i++) {
+      results[i].reset();
+      results[i].loadFromIterator(getGeneralizations((*cl)[i], complementary, false));
+    }
+  }
   virtual SLQueryResultIterator getInstances(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual SLQueryResultIterator getVariants(Literal* lit,
@@ -55,6 +80,9 @@ public:
     return countIteratorElements(getUnifications(lit, complementary, false));
   }
 
+  /** Estimate of the memory taken by the structure in bytes, zero if not known */
+  virtual size_t memoryUsage() { return 0; }
+
 #if VDEBUG
   virtual vstring toString() { return "<not supported>"; }
   virtual void markTagged() = 0;
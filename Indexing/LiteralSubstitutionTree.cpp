@@ -30,6 +30,8 @@
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Term.hpp"
 
+#include "TermSharing.hpp"
+
 #include "LiteralSubstitutionTree.hpp"
 
 namespace Indexing
@@ -56,6 +58,10 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
 {
   CALL("LiteralSubstitutionTree::handleLiteral");
 
+  if(postponeModification(LeafData(cls, lit), insert)) {
+    return;
+  }
+
   Literal* normLit=Renaming::normalize(lit);
 
   BindingMap svBindings;
@@ -63,11 +69,20 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
   if(insert) {
     //cout << "Into " << this << " insert " << lit->toString() << endl;
     SubstitutionTree::insert(&_nodes[getRootNodeIndex(normLit)], svBindings, LeafData(cls, lit));
+    //the nodes keep subterms of normLit, and the removal needs the same normLit
+    env.sharing->retain(normLit);
   } else {
     SubstitutionTree::remove(&_nodes[getRootNodeIndex(normLit)], svBindings, LeafData(cls, lit));
+    env.sharing->release(normLit);
   }
 }
 
+void LiteralSubstitutionTree::handlePostponed(LeafData& ld, bool insert)
+{
+  CALL("LiteralSubstitutionTree::handlePostponed");
+  handleLiteral(ld.literal, ld.clause, insert);
+}
+
 SLQueryResultIterator LiteralSubstitutionTree::getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
@@ -97,6 +112,115 @@ SLQueryResultIterator LiteralSubstitutionTree::getGeneralizations(Literal* lit,
   return res;
 }
 
+/**
+ * Retrieve the generalizations of all literals of @b cl, see
+ * LiteralIndexingStructure::getGeneralizations(Clause*,bool,DArray<Stack<SLQueryResult> >&).
+ *
+ * The literals with the same root node are retrieved by one traversal
+ * of the tree. The results of each literal are the same and in the same
+ * order as those of getGeneralizations(Literal*,bool,bool).
+ */
+void LiteralSubstitutionTree::getGeneralizations(Clause* cl, bool complementary,
+	DArray<Stack<SLQueryResult> >& results)
+{
+  CALL("LiteralSubstitutionTree::getGeneralizations/3");
+
+  unsigned clen=cl->length();
+  results.ensure(clen);
+  for(unsigned i=0;i<clen;i++) {
+    results[i].reset();
+  }
+  for(unsigned i=0;i<clen;i++) {
+    unsigned root=getRootNodeIndex((*cl)[i], complementary);
+    bool done=false;
+    for(unsigned j=0;j<i && !done;j++) {
+      done=getRootNodeIndex((*cl)[j], complementary)==root;
+    }
+    if(!done) {
+      getBatchGeneralizations(cl, i, complementary, results);
+    }
+  }
+}
+
+/**
+ * Retrieve the generalizations of the literals of @b cl from the
+ * @b first-th on that have the same root node as the @b first-th one
+ */
+void LiteralSubstitutionTree::getBatchGeneralizations(Clause* cl, unsigned first, bool complementary,
+	DArray<Stack<SLQueryResult> >& results)
+{
+  CALL("LiteralSubstitutionTree::getBatchGeneralizations");
+
+  unsigned clen=cl->length();
+  unsigned rootIndex=getRootNodeIndex((*cl)[first], complementary);
+  Node* root=_nodes[rootIndex];
+  if(root==0) {
+    return;
+  }
+  if(root->isLeaf()) {
+    for(unsigned i=first;i<clen;i++) {
+      if(getRootNodeIndex((*cl)[i], complementary)!=rootIndex) {
+        continue;
+      }
+      LDIterator ldit=static_cast<Leaf*>(root)->allChildren();
+      while(ldit.hasNext()) {
+        LeafData& ld=ldit.next();
+        results[i].push(SLQueryResult(ld.literal, ld.clause));
+      }
+    }
+    return;
+  }
+
+  //literals of the queries; a commutative literal is queried also
+  //with its arguments reversed
+  static Stack<unsigned> queryLits;
+  static Stack<bool> queryReversed;
+  static Stack<pair<unsigned,Leaf*> > hits;
+  queryLits.reset();
+  queryReversed.reset();
+  hits.reset();
+
+  BatchGeneralizations batch(this);
+  for(unsigned i=first;i<clen;i++) {
+    Literal* lit=(*cl)[i];
+    if(getRootNodeIndex(lit, complementary)!=rootIndex) {
+      continue;
+    }
+    batch.addQuery(lit, false);
+    queryLits.push(i);
+    queryReversed.push(false);
+    if(lit->commutative()) {
+      batch.addQuery(lit, true);
+      queryLits.push(i);
+      queryReversed.push(true);
+    }
+  }
+  batch.retrieve(root, hits);
+
+  //the results of the reversed queries go after the others
+  for(unsigned reversed=0;reversed<2;reversed++) {
+    Stack<pair<unsigned,Leaf*> >::BottomFirstIterator hit(hits);
+    while(hit.hasNext()) {
+      pair<unsigned,Leaf*> h=hit.next();
+      if(queryReversed[h.first]!=(reversed!=0)) {
+        continue;
+      }
+      Literal* lit=(*cl)[queryLits[h.first]];
+      Stack<SLQueryResult>& res=results[queryLits[h.first]];
+      //as in getResultIterator(), equalities must have the sort of the query
+      unsigned eqSort=lit->commutative() ? SortHelper::getEqualityArgumentSort(lit) : 0;
+      LDIterator ldit=h.second->allChildren();
+      while(ldit.hasNext()) {
+        LeafData& ld=ldit.next();
+        if(lit->commutative() && SortHelper::getEqualityArgumentSort(ld.literal)!=eqSort) {
+          continue;
+        }
+        res.push(SLQueryResult(ld.literal, ld.clause));
+      }
+    }
+  }
+}
+
 SLQueryResultIterator LiteralSubstitutionTree::getInstances(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
@@ -165,11 +289,15 @@ struct LiteralSubstitutionTree::UnifyingContext
     RobSubstitution* subst=qr.substitution->tryGetRobSubstitution();
     ASS(subst);
 
-    //This code is used only during variant retrieval, so
-    //literal commutativity doesn't need to concern us, as
-    //we normalize the query literal, so the argument order
-    //of commutative literals is always the right one.
-    ALWAYS(subst->unifyArgs(_queryLit, QRS_QUERY_BANK, qr.literal, QRS_RESULT_BANK));
+    //This code is used only during variant retrieval, so the
+    //arguments unify in one of the two orders
+    if(!subst->unifyArgs(_queryLit, QRS_QUERY_BANK, qr.literal, QRS_RESULT_BANK)) {
+      //a variant of a commutative literal with the arguments swapped
+      ASS(_queryLit->commutative());
+      subst->reset();
+      ALWAYS(subst->unify(*_queryLit->nthArgument(0), QRS_QUERY_BANK, *qr.literal->nthArgument(1), QRS_RESULT_BANK));
+      ALWAYS(subst->unify(*_queryLit->nthArgument(1), QRS_QUERY_BANK, *qr.literal->nthArgument(0), QRS_RESULT_BANK));
+    }
 
     return true;
   }
@@ -222,9 +350,9 @@ SLQueryResultIterator LiteralSubstitutionTree::getVariants(Literal* lit,
     LDIterator ldit=static_cast<Leaf*>(root)->allChildren();
     if(retrieveSubstitutions) {
       // a single substitution will be used for all in ldit, but that's OK
-      return pvi( getMappingIterator(ldit,PropositionalLDToSLQueryResultWithSubstFn()) );
+      return readingIterator(pvi( getMappingIterator(ldit,PropositionalLDToSLQueryResultWithSubstFn()) ));
     } else {
-      return pvi( getMappingIterator(ldit,LDToSLQueryResultFn()) );
+      return readingIterator(pvi( getMappingIterator(ldit,LDToSLQueryResultFn()) ));
     }
   }
 
@@ -233,19 +361,42 @@ SLQueryResultIterator LiteralSubstitutionTree::getVariants(Literal* lit,
   BindingMap svBindings;
   getBindings(normLit, svBindings);
   Leaf* leaf=findLeaf(root,svBindings);
-  if(leaf==0) {
-    return SLQueryResultIterator::getEmpty();
+
+  //The normalization numbers the variables from the first argument, and
+  //the sharing then orders the arguments of commutative literals by their
+  //ids. So a variant with the arguments swapped can be normalized to a
+  //literal with the arguments in the other order, which we look up too.
+  Leaf* swappedLeaf=0;
+  if(lit->commutative()) {
+    Renaming swapped;
+    swapped.normalizeVariables(*lit->nthArgument(1));
+    swapped.normalizeVariables(*lit->nthArgument(0));
+    Literal* swappedNormLit=swapped.apply(lit);
+    if(swappedNormLit!=normLit) {
+      BindingMap swappedBindings;
+      getBindings(swappedNormLit, swappedBindings);
+      swappedLeaf=findLeaf(root,swappedBindings);
+    }
   }
 
-  LDIterator ldit=leaf->allChildren();
+  LDIterator ldit;
+  if(leaf && swappedLeaf) {
+    ldit=pvi( getConcatenatedIterator(leaf->allChildren(), swappedLeaf->allChildren()) );
+  } else if(leaf) {
+    ldit=leaf->allChildren();
+  } else if(swappedLeaf) {
+    ldit=swappedLeaf->allChildren();
+  } else {
+    return SLQueryResultIterator::getEmpty();
+  }
   if(retrieveSubstitutions) {
-    return pvi( getContextualIterator(
+    return readingIterator(pvi( getContextualIterator(
 	    getMappingIterator(
 		    ldit,
 		    LDToSLQueryResultWithSubstFn()),
-	    UnifyingContext(lit)) );
+	    UnifyingContext(lit)) ));
   } else {
-    return pvi( getMappingIterator(ldit,LDToSLQueryResultFn()) );
+    return readingIterator(pvi( getMappingIterator(ldit,LDToSLQueryResultFn()) ));
   }
 }
 
@@ -253,11 +404,11 @@ SLQueryResultIterator LiteralSubstitutionTree::getAll()
 {
   CALL("LiteralSubstitutionTree::getAll");
 
-  return pvi( getMappingIterator(
+  return readingIterator(pvi( getMappingIterator(
       getMapAndFlattenIterator(
 	  vi( new LeafIterator(this) ),
 	  LeafToLDIteratorFn()),
-      LDToSLQueryResultFn()) ) ;
+      LDToSLQueryResultFn()) ));
 }
 
 
@@ -301,9 +452,9 @@ SLQueryResultIterator LiteralSubstitutionTree::getResultIterator(Literal* lit,
     LDIterator ldit=static_cast<Leaf*>(root)->allChildren();
     if(retrieveSubstitutions) {
       // a single substitution will be used for all in ldit, but that's OK
-      return pvi( getMappingIterator(ldit,PropositionalLDToSLQueryResultWithSubstFn()) );
+      return readingIterator(pvi( getMappingIterator(ldit,PropositionalLDToSLQueryResultWithSubstFn()) ));
     } else {
-      return pvi( getMappingIterator(ldit,LDToSLQueryResultFn()) );
+      return readingIterator(pvi( getMappingIterator(ldit,LDToSLQueryResultFn()) ));
     }
   }
 
@@ -313,16 +464,16 @@ SLQueryResultIterator LiteralSubstitutionTree::getResultIterator(Literal* lit,
     VirtualIterator<QueryResult> qrit2=vi(
   	    new Iterator(this, root, lit, retrieveSubstitutions, true, false, useConstraints) );
     ASS(lit->isEquality());
-    return pvi(
+    return readingIterator(pvi(
 	getFilteredIterator(
 	    getMappingIterator(
 		getConcatenatedIterator(qrit1,qrit2), SLQueryResultFunctor()),
 	    EqualitySortFilter(lit))
-	);
+	));
   } else {
     VirtualIterator<QueryResult> qrit=VirtualIterator<QueryResult>(
   	    new Iterator(this, root, lit, retrieveSubstitutions,false,false, useConstraints) );
-    return pvi( getMappingIterator(qrit, SLQueryResultFunctor()) );
+    return readingIterator(pvi( getMappingIterator(qrit, SLQueryResultFunctor()) ));
   }
 }
 
@@ -42,6 +42,7 @@ public:
   void insert(Literal* lit, Clause* cls);
   void remove(Literal* lit, Clause* cls);
   void handleLiteral(Literal* lit, Clause* cls, bool insert);
+  void handlePostponed(LeafData& ld, bool insert);
 
   SLQueryResultIterator getAll();
 
@@ -54,12 +55,17 @@ public:
   SLQueryResultIterator getGeneralizations(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions);
 
+  void getGeneralizations(Clause* cl, bool complementary,
+	  DArray<Stack<SLQueryResult> >& results);
+
   SLQueryResultIterator getInstances(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions);
 
   SLQueryResultIterator getVariants(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions);
 
+  size_t memoryUsage() { return SubstitutionTree::memoryUsage(); }
+
 #if VDEBUG
   virtual void markTagged(){ SubstitutionTree::markTagged();}
   vstring toString() {return SubstitutionTree::toString();}
@@ -79,6 +85,9 @@ private:
   SLQueryResultIterator getResultIterator(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions, bool useConstraints);
 
+  void getBatchGeneralizations(Clause* cl, unsigned first, bool complementary,
+	  DArray<Stack<SLQueryResult> >& results);
+
   unsigned getRootNodeIndex(Literal* t, bool complementary=false);
 };
 
@@ -161,4 +161,37 @@ Literal* DisjunctQueryAndResultVariablesSubstitution::applyToResult(Literal* l)
 
 
 
+////////////////////////////////
+// MatchingResultSubstitution
+//
+
+struct MatchingResultSubstitution::Applicator
+{
+  Applicator(BindingMap* bindings) : _bindings(bindings) {}
+  TermList apply(unsigned var) { return _bindings->get(var); }
+private:
+  BindingMap* _bindings;
+};
+
+TermList MatchingResultSubstitution::applyToBoundResult(TermList t)
+{
+  ASS(_resultIsBase);
+  Applicator applicator(_bindings);
+  return SubstHelper::apply(t, applicator);
+}
+
+Literal* MatchingResultSubstitution::applyToBoundResult(Literal* lit)
+{
+  ASS(_resultIsBase);
+  Applicator applicator(_bindings);
+  return SubstHelper::apply(lit, applicator);
+}
+
+TermList MatchingResultSubstitution::applyToBoundQuery(TermList t)
+{
+  ASS(!_resultIsBase);
+  Applicator applicator(_bindings);
+  return SubstHelper::apply(t, applicator);
+}
+
 }
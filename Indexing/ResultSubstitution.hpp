@@ -27,6 +27,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
 #include "Lib/SmartPtr.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/Renaming.hpp"
@@ -198,6 +199,43 @@ private:
   Renaming _renaming;
 };
 
+/**
+ * Substitution of a match between an indexed term and a query term,
+ * given by the bindings of the variables of the more general one.
+ * Either the indexed term is the generalization and the variables of
+ * the query are not bound, or it is the instance and the variables
+ * of the result are not bound.
+ */
+class MatchingResultSubstitution
+: public ResultSubstitution
+{
+public:
+  CLASS_NAME(MatchingResultSubstitution);
+  USE_ALLOCATOR(MatchingResultSubstitution);
+
+  typedef DHMap<unsigned,TermList> BindingMap;
+
+  MatchingResultSubstitution(BindingMap* bindings, bool resultIsBase)
+  : _bindings(bindings), _resultIsBase(resultIsBase) {}
+
+  TermList applyToBoundResult(TermList t);
+  Literal* applyToBoundResult(Literal* lit);
+  bool isIdentityOnQueryWhenResultBound() { return _resultIsBase; }
+
+  TermList applyToBoundQuery(TermList t);
+  bool isIdentityOnResultWhenQueryBound() { return !_resultIsBase; }
+
+#if VDEBUG
+  virtual vstring toString(){ return "MatchingResultSubstitution"; }
+#endif
+
+private:
+  struct Applicator;
+
+  BindingMap* _bindings;
+  bool _resultIsBase;
+};
+
 };
 
 #endif /* __ResultSubstitution__ */
@@ -61,7 +61,7 @@ using namespace Indexing;
  * @since 16/08/2008 flight Sydney-San Francisco
  */
 SubstitutionTree::SubstitutionTree(int nodes,bool useC)
-  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC)
+  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC), _readerCnt(0)
 {
   CALL("SubstitutionTree::SubstitutionTree");
 
@@ -79,6 +79,7 @@ SubstitutionTree::~SubstitutionTree()
 {
   CALL("SubstitutionTree::~SubstitutionTree");
   ASS_EQ(_iteratorCnt,0);
+  ASS_EQ(_readerCnt,0);
 
   for (unsigned i = 0; i<_nodes.size(); i++) {
     if(_nodes[i]!=0) {
@@ -87,6 +88,41 @@ SubstitutionTree::~SubstitutionTree()
   }
 } // SubstitutionTree::~SubstitutionTree
 
+/**
+ * If the tree has readers, record the insertion (if @b insert is true)
+ * or removal of @b ld to be carried out when they finish, and return
+ * true. Otherwise return false.
+ */
+bool SubstitutionTree::postponeModification(const LeafData& ld, bool insert)
+{
+  CALL("SubstitutionTree::postponeModification");
+
+  if(!_readerCnt) {
+    return false;
+  }
+  _postponed.push(make_pair(ld, insert));
+  return true;
+}
+
+/**
+ * Unregister a reader of the tree, and if it was the last one, carry
+ * out the postponed modifications.
+ */
+void SubstitutionTree::readerFinished()
+{
+  CALL("SubstitutionTree::readerFinished");
+  ASS_G(_readerCnt,0);
+
+  _readerCnt--;
+  if(_readerCnt || _postponed.isEmpty()) {
+    return;
+  }
+  for(unsigned i=0;i<_postponed.size();i++) {
+    handlePostponed(_postponed[i].first, _postponed[i].second);
+  }
+  _postponed.reset();
+}
+
 /**
  * Store initial bindings of term @b t into @b bq.
  *
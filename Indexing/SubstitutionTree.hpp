@@ -691,6 +691,54 @@ public:
   void insert(Node** node,BindingMap& binding,LeafData ld);
   void remove(Node** node,BindingMap& binding,LeafData ld);
 
+  /**
+   * Iterator registered as a reader of the tree for as long as it lives
+   *
+   * The term and literal trees return their retrieval results wrapped
+   * in it. While the tree has readers, insertions and removals are only
+   * recorded, and they are carried out in their order when the last
+   * reader finishes. Each reader therefore sees the version of the tree
+   * from when it started, and no node it may still visit is freed under
+   * it. The clauses and literals of the entries must be kept alive by
+   * the caller until then.
+   */
+  template<typename T>
+  class ReadingIterator
+  : public IteratorCore<T>
+  {
+  public:
+    CLASS_NAME(SubstitutionTree::ReadingIterator);
+    USE_ALLOCATOR(ReadingIterator);
+
+    ReadingIterator(SubstitutionTree* tree, VirtualIterator<T> inner)
+    : _tree(tree), _inner(inner) { tree->_readerCnt++; }
+    ~ReadingIterator()
+    {
+      //the retrieval must be over before the postponed modifications
+      _inner=VirtualIterator<T>::getEmpty();
+      _tree->readerFinished();
+    }
+
+    bool hasNext() { return _inner.hasNext(); }
+    T next() { return _inner.next(); }
+  private:
+    SubstitutionTree* _tree;
+    VirtualIterator<T> _inner;
+  };
+
+  template<typename T>
+  VirtualIterator<T> readingIterator(VirtualIterator<T> it)
+  {
+    return vi( new ReadingIterator<T>(this, it) );
+  }
+
+  size_t memoryUsage();
+
+  bool postponeModification(const LeafData& ld, bool insert);
+  void readerFinished();
+  /** Insert or remove the entry @b ld whose modification was postponed */
+  virtual void handlePostponed(LeafData& ld, bool insert) = 0;
+
   /** Number of the next variable */
   int _nextVar;
   /** Array of nodes */
@@ -698,6 +746,11 @@ public:
   /** enable searching with constraints for this tree */
   bool _useC;
 
+  /** Number of live reading iterators */
+  unsigned _readerCnt;
+  /** Entries to be inserted (true) or removed (false) when the readers finish */
+  Stack<pair<LeafData,bool> > _postponed;
+
   class LeafIterator
   : public IteratorCore<Leaf*>
   {
@@ -705,6 +758,10 @@ public:
     LeafIterator(SubstitutionTree* st)
     : _nextRootPtr(st->_nodes.begin()), _afterLastRootPtr(st->_nodes.end()),
     _nodeIterators(8) {}
+    /** Iterate only over the leaves below the root node at @b root */
+    LeafIterator(Node** root)
+    : _nextRootPtr(root), _afterLastRootPtr(root+1),
+    _nodeIterators(8) {}
     bool hasNext();
     Leaf* next()
     {
@@ -767,6 +824,38 @@ public:
     Stack<NodeAlgorithm> _nodeTypes;
   };
 
+  /**
+   * Retrieval of generalizations of several queries by a single traversal
+   * of the tree. The queries that reach a node together are matched against
+   * its children together, so the shared parts of their paths are walked once.
+   */
+  class BatchGeneralizations
+  {
+  public:
+    CLASS_NAME(SubstitutionTree::BatchGeneralizations);
+    USE_ALLOCATOR(BatchGeneralizations);
+
+    BatchGeneralizations(SubstitutionTree* tree) : _tree(tree) {}
+    ~BatchGeneralizations();
+
+    void addQuery(Term* query, bool reversed);
+    void retrieve(Node* root, Stack<pair<unsigned,Leaf*> >& hits);
+  private:
+    void enterNode(IntermediateNode* inode, unsigned first, unsigned cnt);
+    void enterChild(Node* child, unsigned specVar, unsigned first);
+
+    SubstitutionTree* _tree;
+    /** Matchers of the queries in the order they were added */
+    Stack<GenMatcher*> _matchers;
+    /**
+     * The queries that reached the nodes on the current path, each
+     * node's queries on top of those of its parent
+     */
+    Stack<unsigned> _active;
+    /** Pairs of a query and a leaf with its generalizations */
+    Stack<pair<unsigned,Leaf*> >* _hits;
+  };
+
   class InstMatcher;
 
   /**
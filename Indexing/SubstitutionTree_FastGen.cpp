@@ -698,4 +698,163 @@ bool SubstitutionTree::FastGeneralizationsIterator::enterNode(Node*& curr)
 }
 
 
+SubstitutionTree::BatchGeneralizations::~BatchGeneralizations()
+{
+  CALL("SubstitutionTree::BatchGeneralizations::~BatchGeneralizations");
+
+  while(_matchers.isNonEmpty()) {
+    delete _matchers.pop();
+  }
+}
+
+/**
+ * Add @b query to the batch. If @b reversed is true, the arguments
+ * of the binary commutative literal @b query are taken in the reverse
+ * order. The queries are numbered from zero in the order they are added.
+ */
+void SubstitutionTree::BatchGeneralizations::addQuery(Term* query, bool reversed)
+{
+  CALL("SubstitutionTree::BatchGeneralizations::addQuery");
+
+  GenMatcher* matcher=new GenMatcher(query,_tree->_nextVar);
+  if(reversed) {
+    ASS(query->commutative());
+    matcher->bindSpecialVar(1,*query->nthArgument(0));
+    matcher->bindSpecialVar(0,*query->nthArgument(1));
+  } else {
+    unsigned var=0;
+    for(TermList* args=query->args(); !args->isEmpty(); args=args->next()) {
+      matcher->bindSpecialVar(var++,*args);
+    }
+  }
+  _matchers.push(matcher);
+}
+
+/**
+ * Retrieve the generalizations of all queries in the tree below the
+ * intermediate node @b root, and push into @b hits the pair of a query
+ * and a leaf for every leaf whose entries generalize the query.
+ *
+ * The leaves of each query are pushed in the order in which
+ * FastGeneralizationsIterator would visit them.
+ */
+void SubstitutionTree::BatchGeneralizations::retrieve(Node* root, Stack<pair<unsigned,Leaf*> >& hits)
+{
+  CALL("SubstitutionTree::BatchGeneralizations::retrieve");
+  ASS(root);
+  ASS(!root->isLeaf());
+
+  _hits=&hits;
+  for(unsigned q=0;q<_matchers.size();q++) {
+    _active.push(q);
+  }
+  enterNode(static_cast<IntermediateNode*>(root), 0, _matchers.size());
+  _active.reset();
+}
+
+/**
+ * Visit the children of @b inode with the @b cnt queries on the
+ * @b _active stack from index @b first.
+ *
+ * As in FastGeneralizationsIterator::enterNode(), a query visits the
+ * proper term child with its top symbol before the variable children.
+ */
+void SubstitutionTree::BatchGeneralizations::enterNode(IntermediateNode* inode, unsigned first, unsigned cnt)
+{
+  CALL("SubstitutionTree::BatchGeneralizations::enterNode");
+
+  unsigned specVar=inode->childVar;
+  unsigned end=first+cnt;
+
+  for(unsigned i=first;i<end;i++) {
+    TermList binding=_matchers[_active[i]]->getSpecVarBinding(specVar);
+    if(binding.isVar()) {
+      continue;
+    }
+    unsigned functor=binding.term()->functor();
+    bool visited=false;
+    for(unsigned j=first;j<i && !visited;j++) {
+      TermList prev=_matchers[_active[j]]->getSpecVarBinding(specVar);
+      visited=prev.isTerm() && prev.term()->functor()==functor;
+    }
+    if(visited) {
+      //the child was visited with an earlier query with the same top symbol
+      continue;
+    }
+    Node** child=inode->childByTop(binding,false);
+    if(!child) {
+      continue;
+    }
+    unsigned groupFirst=_active.size();
+    _active.push(_active[i]);
+    for(unsigned j=i+1;j<end;j++) {
+      TermList other=_matchers[_active[j]]->getSpecVarBinding(specVar);
+      if(other.isTerm() && other.term()->functor()==functor) {
+        _active.push(_active[j]);
+      }
+    }
+    enterChild(*child, specVar, groupFirst);
+  }
+
+  if(inode->algorithm()==UNSORTED_LIST) {
+    for(Node** nl=static_cast<UArrIntermediateNode*>(inode)->_nodes; *nl; nl++) {
+      if((*nl)->term.isVar()) {
+        unsigned groupFirst=_active.size();
+        for(unsigned i=first;i<end;i++) {
+          _active.push(_active[i]);
+        }
+        enterChild(*nl, specVar, groupFirst);
+      }
+    }
+  } else {
+    ASS_EQ(inode->algorithm(),SKIP_LIST);
+    //in SkipList nodes variables are only at the beginning
+    NodeList* nl=static_cast<SListIntermediateNode*>(inode)->_nodes.toList();
+    for(; nl && nl->head()->term.isVar(); nl=nl->tail()) {
+      unsigned groupFirst=_active.size();
+      for(unsigned i=first;i<end;i++) {
+        _active.push(_active[i]);
+      }
+      enterChild(nl->head(), specVar, groupFirst);
+    }
+  }
+}
+
+/**
+ * Match @b child of a node with child variable @b specVar against the
+ * queries on the @b _active stack from index @b first, visit it with
+ * those that match, and remove them from the stack afterwards.
+ */
+void SubstitutionTree::BatchGeneralizations::enterChild(Node* child, unsigned specVar, unsigned first)
+{
+  CALL("SubstitutionTree::BatchGeneralizations::enterChild");
+
+  unsigned matched=first;
+  for(unsigned i=first;i<_active.size();i++) {
+    unsigned q=_active[i];
+    if(_matchers[q]->matchNext(specVar, child->term)) {
+      _active[matched++]=q;
+    }
+  }
+  _active.truncate(matched);
+  if(matched==first) {
+    return;
+  }
+
+  if(child->isLeaf()) {
+    for(unsigned i=first;i<matched;i++) {
+      _hits->push(make_pair(_active[i], static_cast<Leaf*>(child)));
+    }
+  } else {
+    enterNode(static_cast<IntermediateNode*>(child), first, matched-first);
+  }
+  ASS_EQ(_active.size(),matched);
+
+  for(unsigned i=first;i<matched;i++) {
+    _matchers[_active[i]]->backtrack();
+  }
+  _active.truncate(first);
+}
+
+
 }
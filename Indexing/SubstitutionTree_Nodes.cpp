@@ -262,4 +262,48 @@ void SubstitutionTree::ensureIntermediateNodeEfficiency(IntermediateNode** inode
   }
 }
 
+/**
+ * Return an estimate of the memory taken by the nodes of the tree
+ * and their entries. Skip list elements are counted with two links,
+ * which is their expected number.
+ */
+size_t SubstitutionTree::memoryUsage()
+{
+  CALL("SubstitutionTree::memoryUsage");
+
+  size_t res=0;
+  static Stack<Node*> toVisit;
+  toVisit.reset();
+  for(unsigned i=0;i<_nodes.size();i++) {
+    if(_nodes[i]) {
+      toVisit.push(_nodes[i]);
+    }
+  }
+  while(toVisit.isNonEmpty()) {
+    Node* node=toVisit.pop();
+    if(node->isLeaf()) {
+      if(node->algorithm()==UNSORTED_LIST) {
+        res+=sizeof(UListLeaf)+node->size()*sizeof(List<LeafData>);
+      }
+      else {
+        //SListLeaf keeps no count of its entries outside debug mode
+        size_t size=countIteratorElements(static_cast<Leaf*>(node)->allChildren());
+        res+=sizeof(SListLeaf)+size*(sizeof(LeafData)+2*sizeof(void*));
+      }
+      continue;
+    }
+    if(node->algorithm()==UNSORTED_LIST) {
+      res+=sizeof(UArrIntermediateNode);
+    }
+    else {
+      res+=sizeof(SListIntermediateNode)+node->size()*(sizeof(Node*)+2*sizeof(void*));
+    }
+    NodeIterator children=static_cast<IntermediateNode*>(node)->allChildren();
+    while(children.hasNext()) {
+      toVisit.push(*children.next());
+    }
+  }
+  return res;
+}
+
 }
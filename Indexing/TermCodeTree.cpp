@@ -55,11 +55,36 @@ TermCodeTree::TermCodeTree()
 {
   _clauseCodeTree=false;
   _onCodeOpDestroying = onCodeOpDestroying;
+  _onPostponedModification = onPostponedModification;
+}
+
+/**
+ * Perform the insertion or removal of the TermInfo @b obj postponed
+ * while there were readers. A TermInfo being removed was copied
+ * by @b remove() and is released here.
+ */
+void TermCodeTree::onPostponedModification(CodeTree* tree, void* obj, bool insert)
+{
+  CALL("TermCodeTree::onPostponedModification");
+
+  TermCodeTree* tct=static_cast<TermCodeTree*>(tree);
+  TermInfo* ti=static_cast<TermInfo*>(obj);
+  if(insert) {
+    tct->insert(ti);
+  }
+  else {
+    tct->remove(*ti);
+    delete ti;
+  }
 }
 
 void TermCodeTree::insert(TermInfo* ti)
 {
   CALL("TermCodeTree::insert");
+
+  if(postponeModification(ti, true)) {
+    return;
+  }
   
   static CodeStack code;
   code.reset();
@@ -89,6 +114,11 @@ void TermCodeTree::insert(TermInfo* ti)
 void TermCodeTree::remove(const TermInfo& ti)
 {
   CALL("TermCodeTree::remove");
+
+  if(_readerCnt) {
+    ALWAYS(postponeModification(new TermInfo(ti), false));
+    return;
+  }
   
   static RemovingTermMatcher rtm;
   static Stack<CodeOp*> firstsInBlocks;
@@ -116,6 +146,7 @@ void TermCodeTree::remove(const TermInfo& ti)
   ft->destroy();
   
   optimizeMemoryAfterRemoval(&firstsInBlocks, rtm.op);
+  compactAfterRemoval();
   /*
   
   static TermMatcher tm;
@@ -166,6 +197,7 @@ void TermCodeTree::TermMatcher::init(CodeTree* tree, TermList t)
   CALL("TermCodeTree::TermMatcher::init");
   
   Matcher::init(tree,tree->getEntryPoint());
+  tree->readerStarted();
 
   linfos=0;
   linfoCnt=0;
@@ -185,6 +217,7 @@ void TermCodeTree::TermMatcher::deinit()
 #if VDEBUG
   ft=0;
 #endif
+  tree->readerFinished();
 }
 
 TermCodeTree::TermInfo* TermCodeTree::TermMatcher::next()
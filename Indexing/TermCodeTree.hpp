@@ -50,6 +50,7 @@ class TermCodeTree : public CodeTree
 {
 protected:
   static void onCodeOpDestroying(CodeOp* op);
+  static void onPostponedModification(CodeTree* tree, void* obj, bool insert);
   
 public:
   TermCodeTree();
@@ -37,35 +37,70 @@ using namespace Kernel;
 using namespace Inferences;
 using namespace Indexing;
 
+/**
+ * The memory of the indexing structure is recorded in the statistics
+ * before it is destroyed.
+ */
 TermIndex::~TermIndex()
 {
+  recordMemoryUsage();
   delete _is;
 }
 
 TermQueryResultIterator TermIndex::getUnifications(TermList t,
 	  bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getUnifications(t, retrieveSubstitutions), start);
+  }
   return _is->getUnifications(t, retrieveSubstitutions);
 }
 
 TermQueryResultIterator TermIndex::getUnificationsWithConstraints(TermList t,
           bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getUnificationsWithConstraints(t, retrieveSubstitutions), start);
+  }
   return _is->getUnificationsWithConstraints(t, retrieveSubstitutions);
 }
 
 TermQueryResultIterator TermIndex::getGeneralizations(TermList t,
 	  bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getGeneralizations(t, retrieveSubstitutions), start);
+  }
   return _is->getGeneralizations(t, retrieveSubstitutions);
 }
 
 TermQueryResultIterator TermIndex::getInstances(TermList t,
 	  bool retrieveSubstitutions)
 {
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getInstances(t, retrieveSubstitutions), start);
+  }
   return _is->getInstances(t, retrieveSubstitutions);
 }
 
+TermQueryResultIterator TermIndex::getAllWithTop(TermList t)
+{
+  if(_stats) {
+    long long start=IndexStatistics::now();
+    return _stats->monitor(_is->getAllWithTop(t), start);
+  }
+  return _is->getAllWithTop(t);
+}
+
+
+size_t TermIndex::memoryUsage()
+{
+  return _is->memoryUsage();
+}
 
 void SuperpositionSubtermIndex::handleClause(Clause* c, bool adding)
 {
@@ -46,6 +46,9 @@ public:
 	  bool retrieveSubstitutions = true);
   TermQueryResultIterator getInstances(TermList t,
 	  bool retrieveSubstitutions = true);
+  TermQueryResultIterator getAllWithTop(TermList t);
+
+  size_t memoryUsage();
 
 protected:
   TermIndex(TermIndexingStructure* is) : _is(is) {}
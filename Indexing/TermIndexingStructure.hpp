@@ -44,9 +44,13 @@ public:
 	  bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual TermQueryResultIterator getInstances(TermList t,
 	  bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
+  virtual TermQueryResultIterator getAllWithTop(TermList t) { NOT_IMPLEMENTED; }
 
   virtual bool generalizationExists(TermList t) { NOT_IMPLEMENTED; }
 
+  /** Estimate of the memory taken by the structure in bytes, zero if not known */
+  virtual size_t memoryUsage() { return 0; }
+
 #if VDEBUG
   virtual void markTagged() = 0;
 #endif
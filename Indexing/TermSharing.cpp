@@ -31,6 +31,7 @@
 #include "Kernel/Sorts.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
+#include "Shell/Statistics.hpp"
 #include "TermSharing.hpp"
 
 using namespace Kernel;
@@ -46,7 +47,10 @@ TermSharing::TermSharing()
     _totalLiterals(0),
     // _groundLiterals(0), //MS: unused
     _literalInsertions(0),
-    _termInsertions(0)
+    _termInsertions(0),
+    _collectsGarbage(false),
+    _firstCollectableTerm(0),
+    _firstCollectableLiteral(0)
 {
   CALL("TermSharing::TermSharing");
 }
@@ -60,11 +64,11 @@ TermSharing::~TermSharing()
   CALL("TermSharing::~TermSharing");
 
 #if CHECK_LEAKS
-  Set<Term*,TermSharing>::Iterator ts(_terms);
+  ConcurrentSet<Term*,TermSharing>::Iterator ts(_terms);
   while (ts.hasNext()) {
     ts.next()->destroy();
   }
-  Set<Literal*,TermSharing>::Iterator ls(_literals);
+  ConcurrentSet<Literal*,TermSharing>::Iterator ls(_literals);
   while (ls.hasNext()) {
     ls.next()->destroy();
   }
@@ -97,9 +101,11 @@ Term* TermSharing::insert(Term* t)
 
   _termInsertions++;
   Term* s = _terms.insert(t);
+  _terms.releaseRetiredTables();
    if (s == t) {
     unsigned weight = 1;
     unsigned vars = 0;
+    unsigned varMask = 0;
     bool hasInterpretedConstants=t->arity()==0 &&
 	env.signature->getFunction(t->functor())->interpreted();
     Color color = COLOR_TRANSPARENT;
@@ -107,6 +113,7 @@ Term* TermSharing::insert(Term* t)
       if (tt->isVar()) {
           ASS(tt->isOrdinaryVar());
           vars++;
+          varMask |= Term::varMaskBit(tt->var());
           weight += 1;
       }
       else 
@@ -116,6 +123,7 @@ Term* TermSharing::insert(Term* t)
           Term* r = tt->term();
     
           vars += r->vars();
+          varMask |= r->varMask();
           weight += r->weight();
           if (env.colorUsed) {
               color = static_cast<Color>(color | r->color());
@@ -128,6 +136,7 @@ Term* TermSharing::insert(Term* t)
     t->markShared();
     t->setId(_totalTerms);
     t->setVars(vars);
+    t->setVarMask(varMask);
     t->setWeight(weight);
     if (env.colorUsed) {
       Color fcolor = env.signature->getFunction(t->functor())->color();
@@ -180,21 +189,25 @@ Literal* TermSharing::insert(Literal* t)
 
   _literalInsertions++;
   Literal* s = _literals.insert(t);
+  _literals.releaseRetiredTables();
   if (s == t) {
     unsigned weight = 1;
     unsigned vars = 0;
+    unsigned varMask = 0;
     Color color = COLOR_TRANSPARENT;
     bool hasInterpretedConstants=false;
     for (TermList* tt = t->args(); ! tt->isEmpty(); tt = tt->next()) {
       if (tt->isVar()) {
 	ASS(tt->isOrdinaryVar());
 	vars++;
+	varMask |= Term::varMaskBit(tt->var());
 	weight += 1;
       }
       else {
 	ASS_REP(tt->term()->shared(), tt->term()->toString());
 	Term* r = tt->term();
 	vars += r->vars();
+	varMask |= r->varMask();
 	weight += r->weight();
 	if (env.colorUsed) {
 	  ASS(color == COLOR_TRANSPARENT || r->color() == COLOR_TRANSPARENT || color == r->color());
@@ -208,6 +221,7 @@ Literal* TermSharing::insert(Literal* t)
     t->markShared();
     t->setId(_totalLiterals);
     t->setVars(vars);
+    t->setVarMask(varMask);
     t->setWeight(weight);
     if (env.colorUsed) {
       Color fcolor = env.signature->getPredicate(t->functor())->color();
@@ -256,10 +270,12 @@ Literal* TermSharing::insertVariableEquality(Literal* t,unsigned sort)
 
   _literalInsertions++;
   Literal* s = _literals.insert(t);
+  _literals.releaseRetiredTables();
   if (s == t) {
     t->markShared();
     t->setId(_totalLiterals);
     t->setWeight(3);
+    t->setVarMask(Term::varMaskBit(t->nthArgument(0)->var()) | Term::varMaskBit(t->nthArgument(1)->var()));
     if (env.colorUsed) {
       t->setColor(COLOR_TRANSPARENT);
     }
@@ -323,6 +339,167 @@ Literal* TermSharing::tryGetOpposite(Literal* l)
   return 0;
 }
 
+/**
+ * Let @b collectGarbage() free the terms and literals inserted from now
+ * on, and start counting @b retain() calls. The existing ones come from
+ * the input and the preprocessing and may be referred to from anywhere.
+ */
+void TermSharing::startGarbageCollection()
+{
+  CALL("TermSharing::startGarbageCollection");
+
+  _collectsGarbage = true;
+  _firstCollectableTerm = _totalTerms;
+  _firstCollectableLiteral = _totalLiterals;
+}
+
+/**
+ * True if the garbage collection may free the shared term or literal @b t
+ *
+ * Constants and propositional atoms are never freed, as the signature
+ * and the theories keep some of them. As subterms are inserted before
+ * the terms containing them, the subterms of a term that is not freed
+ * because of its id are not freed either.
+ */
+bool TermSharing::collectable(Term* t) const
+{
+  ASS(t->shared());
+
+  if (!t->arity()) {
+    return false;
+  }
+  return t->getId() >= (t->isLiteral() ? _firstCollectableLiteral : _firstCollectableTerm);
+}
+
+/**
+ * Make @b collectGarbage() keep the shared term or literal @b t and its
+ * subterms until @b release() is called on it as many times as this
+ * function was. Used by structures that keep terms for a while, such as
+ * the normalized terms of the entries of substitution trees.
+ *
+ * Terms that cannot be freed are not counted, so a term retained before
+ * the garbage collection started may be released after it did.
+ */
+void TermSharing::retain(Term* t)
+{
+  CALL("TermSharing::retain");
+
+  if (!_collectsGarbage || !collectable(t)) {
+    return;
+  }
+  unsigned* cnt;
+  _retained.getValuePtr(t, cnt, 0);
+  (*cnt)++;
+}
+
+/**
+ * Undo one call of @b retain() on @b t
+ */
+void TermSharing::release(Term* t)
+{
+  CALL("TermSharing::release");
+
+  if (!_collectsGarbage || !collectable(t)) {
+    return;
+  }
+  unsigned* cnt = _retained.findPtr(t);
+  ASS(cnt);
+  if (!--(*cnt)) {
+    _retained.remove(t);
+  }
+}
+
+/**
+ * Mark @b t and its subterms, so that @b collectGarbage() keeps them
+ *
+ * @b t may be an unshared literal of a formula, and then only its shared
+ * subterms are marked. Special terms are not entered, as they occur only
+ * in units made before saturation, whose shared subterms are kept anyway.
+ */
+void TermSharing::mark(Term* t)
+{
+  CALL("TermSharing::mark");
+  ASS(_toMark.isEmpty());
+
+  _toMark.push(t);
+  while (_toMark.isNonEmpty()) {
+    Term* s = _toMark.pop();
+    if (s->isSpecial()) {
+      continue;
+    }
+    if (s->shared()) {
+      if (s->_gcMark || !collectable(s)) {
+        continue;
+      }
+      s->_gcMark = 1;
+    }
+    for (TermList* ts = s->args(); !ts->isEmpty(); ts = ts->next()) {
+      if (ts->isTerm()) {
+        _toMark.push(ts->term());
+      }
+    }
+  }
+}
+
+/**
+ * Unmark @b t and return false if it was marked or cannot be freed,
+ * otherwise destroy it and return true
+ */
+bool TermSharing::sweep(Term* t)
+{
+  if (t->_gcMark || !collectable(t)) {
+    t->_gcMark = 0;
+    return false;
+  }
+  t->_args[0]._info.shared = 0u;
+  t->destroy();
+  return true;
+}
+
+/**
+ * Free the terms and literals inserted since @b startGarbageCollection()
+ * that were not marked since the last collection and are neither pinned
+ * nor retained nor subterms of pinned or retained ones
+ *
+ * Must be called when no other thread uses the structure and nothing
+ * refers to the unmarked terms anymore. The marks are cleared.
+ */
+void TermSharing::collectGarbage()
+{
+  CALL("TermSharing::collectGarbage");
+  ASS(_collectsGarbage);
+
+  TimeCounter tc(TC_TERM_SHARING);
+
+  ConcurrentSet<Literal*,TermSharing>::Iterator lit(_literals);
+  while (lit.hasNext()) {
+    Literal* l = lit.next();
+    if (l->_gcPinned) {
+      mark(l);
+    }
+  }
+  ConcurrentSet<Term*,TermSharing>::Iterator tit(_terms);
+  while (tit.hasNext()) {
+    Term* t = tit.next();
+    if (t->_gcPinned) {
+      mark(t);
+    }
+  }
+  DHMap<Term*,unsigned>::Iterator rit(_retained);
+  while (rit.hasNext()) {
+    mark(rit.nextKey());
+  }
+
+  size_t literals = _literals.removeIf([this](Literal* l) { return sweep(l); });
+  size_t terms = _terms.removeIf([this](Term* t) { return sweep(t); });
+  _literals.releaseRetiredTables();
+  _terms.releaseRetiredTables();
+
+  env.statistics->termGcCollections++;
+  env.statistics->termGcFreedTerms += terms;
+  env.statistics->termGcFreedLiterals += literals;
+}
+
 /**
  * Return true if t1 is greater than t2 in some arbitrary
  * total ordering.
@@ -359,8 +536,6 @@ bool TermSharing::argNormGt(TermList t1, TermList t2)
  */
 bool TermSharing::equals(const Term* s,const Term* t)
 {
-  CALL("TermSharing::equals(Term*,Term*)");
-
   if (s->functor() != t->functor()) return false;
 
   const TermList* ss = s->args();
@@ -380,8 +555,6 @@ bool TermSharing::equals(const Term* s,const Term* t)
  */
 bool TermSharing::equals(const Literal* l1, const Literal* l2, bool opposite)
 {
-  CALL("TermSharing::equals(Literal*,Literal*)");
-
   if( (l1->polarity()==l2->polarity()) == opposite) {
     return false;
   }
@@ -26,7 +26,9 @@
 #ifndef __TermSharing__
 #define __TermSharing__
 
-#include "Lib/Set.hpp"
+#include "Lib/ConcurrentSet.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
 #include "Kernel/Term.hpp"
 
 #include "Lib/Allocator.hpp"
@@ -53,6 +55,9 @@ public:
 
   Literal* tryGetOpposite(Literal* l);
 
+  //the hash and equality functions are called by ConcurrentSet,
+  //so neither they nor the functions they call may use CALL
+
   /** The hash function of this literal */
   inline static unsigned hash(const Literal* l)
   { return l->hash(); }
@@ -73,13 +78,45 @@ public:
     return equals(l1, w.l, true);
   }
 
+  /** Number of resizes of the term and literal tables */
+  unsigned tableResizes() const
+  { return _terms.resizes()+_literals.resizes(); }
+  /** Number of steps the resizes of the term and literal tables took */
+  size_t tableResizeSteps() const
+  { return _terms.resizeSteps()+_literals.resizeSteps(); }
+  /** The longest time in nanoseconds a step of these resizes took */
+  long long maxTablePause() const
+  { return std::max(_terms.maxPause(), _literals.maxPause()); }
+
+  void startGarbageCollection();
+  /** True if the garbage collection of terms and literals was started */
+  bool collectsGarbage() const { return _collectsGarbage; }
+  /** Make the garbage collection keep @b l and its subterms */
+  void pin(Literal* l) { l->_gcPinned = 1; }
+  void retain(Term* t);
+  void release(Term* t);
+  void mark(Term* t);
+  void collectGarbage();
+
 private:
   bool argNormGt(TermList t1, TermList t2);
-
-  /** The set storing all terms */
-  Set<Term*,TermSharing> _terms;
+  bool collectable(Term* t) const;
+  bool sweep(Term* t);
+
+  /**
+   * The set storing all terms
+   *
+   * Terms get their ids and other fields after the insertion by the thread
+   * whose term got into the set, so the other fields are not yet safe
+   * to be read by other threads that find the term there.
+   *
+   * Vampire uses this set and @b _literals from one thread only, so the
+   * table retired by a resize is released right after the insertion that
+   * completed the resize, instead of waiting for collectGarbage().
+   */
+  ConcurrentSet<Term*,TermSharing> _terms;
   /** The set storing all literals */
-  Set<Literal*,TermSharing> _literals;
+  ConcurrentSet<Literal*,TermSharing> _literals;
   /** Number of terms stored */
   unsigned _totalTerms;
   /** Number of ground terms stored */
@@ -92,6 +129,16 @@ private:
   unsigned _literalInsertions;
   /** Number of term insertions */
   unsigned _termInsertions;
+  /** True once @b startGarbageCollection() was called */
+  bool _collectsGarbage;
+  /** Terms with smaller ids existed when the garbage collection started and are never freed */
+  unsigned _firstCollectableTerm;
+  /** Literals with smaller ids existed when the garbage collection started and are never freed */
+  unsigned _firstCollectableLiteral;
+  /** Terms and literals to be marked by @b mark() */
+  Stack<Term*> _toMark;
+  /** Numbers of calls of @b retain() not yet matched by @b release() */
+  DHMap<Term*,unsigned> _retained;
 }; // class TermSharing
 
 } // namespace Indexing
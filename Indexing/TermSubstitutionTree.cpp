@@ -31,6 +31,8 @@
 #include "Kernel/Signature.hpp"
 #include "Kernel/Term.hpp"
 
+#include "TermSharing.hpp"
+
 #include "Shell/Options.hpp"
 
 #include "TermSubstitutionTree.hpp"
@@ -58,6 +60,12 @@ void TermSubstitutionTree::remove(TermList t, Literal* lit, Clause* cls)
   handleTerm(t,lit,cls, false);
 }
 
+void TermSubstitutionTree::handlePostponed(LeafData& ld, bool insert)
+{
+  CALL("TermSubstitutionTree::handlePostponed");
+  handleTerm(ld.term, ld.literal, ld.clause, insert);
+}
+
 /**
  * According to value of @b insert, insert or remove term.
  */
@@ -66,6 +74,9 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
   CALL("TermSubstitutionTree::handleTerm");
 
   LeafData ld(cls, lit, t);
+  if(postponeModification(ld, insert)) {
+    return;
+  }
   if(t.isOrdinaryVar()) {
     if(insert) {
       _vars.insert(ld);
@@ -86,8 +97,11 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
 
     if(insert) {
       SubstitutionTree::insert(&_nodes[rootNodeIndex], svBindings, ld);
+      //the nodes keep subterms of normTerm, and the removal needs the same normTerm
+      env.sharing->retain(normTerm);
     } else {
       SubstitutionTree::remove(&_nodes[rootNodeIndex], svBindings, ld);
+      env.sharing->release(normTerm);
     }
   }
 }
@@ -230,7 +244,7 @@ TermQueryResultIterator TermSubstitutionTree::getResultIterator(Term* trm,
     }
     else{
       VirtualIterator<QueryResult> qrit=vi( new Iterator(this, root, trm, retrieveSubstitutions,false,false, withConstraints) );
-      result = pvi( getMappingIterator(qrit, TermQueryResultFn()) );
+      result = readingIterator(pvi( getMappingIterator(qrit, TermQueryResultFn()) ));
     }
   }
 
@@ -372,16 +386,37 @@ TermQueryResultIterator TermSubstitutionTree::ldIteratorToTQRIterator(LDIt ldIt,
   ASS(retrieveSubstitutions | !withConstraints); 
 
   if(retrieveSubstitutions) {
-    return pvi( getContextualIterator(
+    return readingIterator(pvi( getContextualIterator(
 	    getMappingIterator(
 		    ldIt,
 		    LDToTermQueryResultWithSubstFn(withConstraints)),
-	    UnifyingContext(queryTerm,withConstraints)) );
+	    UnifyingContext(queryTerm,withConstraints)) ));
   } else {
-    return pvi( getMappingIterator(
+    return readingIterator(pvi( getMappingIterator(
 	    ldIt,
-	    LDToTermQueryResultFn()) );
+	    LDToTermQueryResultFn()) ));
+  }
+}
+
+/**
+ * Return all indexed terms with the same top symbol as the non-variable
+ * term @b t, without substitutions.
+ *
+ * This is a walk over a whole subtree of the index, useful when the
+ * caller matches the terms against many queries at once.
+ */
+TermQueryResultIterator TermSubstitutionTree::getAllWithTop(TermList t)
+{
+  CALL("TermSubstitutionTree::getAllWithTop");
+  ASS(t.isTerm());
+
+  Node** root=&_nodes[getRootNodeIndex(t.term())];
+  if(!*root) {
+    return TermQueryResultIterator::getEmpty();
   }
+  return readingIterator(pvi( getMappingIterator(
+	  getFlattenedIterator(getMappingIterator(vi( new LeafIterator(root) ), LeafToLDIteratorFn())),
+	  LDToTermQueryResultFn()) ));
 }
 
 TermQueryResultIterator TermSubstitutionTree::getAllUnifyingIterator(TermList trm,
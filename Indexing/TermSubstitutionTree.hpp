@@ -62,12 +62,18 @@ public:
   TermQueryResultIterator getInstances(TermList t,
 	  bool retrieveSubstitutions);
 
+  TermQueryResultIterator getAllWithTop(TermList t);
+
+  size_t memoryUsage()
+  { return SubstitutionTree::memoryUsage()+_vars.size()*(sizeof(LeafData)+2*sizeof(void*)); }
+
 #if VDEBUG
   virtual void markTagged(){ SubstitutionTree::markTagged();}
 #endif
 
 private:
   void handleTerm(TermList t, Literal* lit, Clause* cls, bool insert);
+  void handlePostponed(LeafData& ld, bool insert);
 
   struct TermQueryResultFn;
 
@@ -22,7 +22,9 @@
  */
 
 
+#include "Lib/DHMap.hpp"
 #include "Lib/DHMultiset.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/List.hpp"
@@ -41,6 +43,7 @@
 
 #include "Indexing/Index.hpp"
 #include "Indexing/TermIndex.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
 #include "Indexing/IndexManager.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
@@ -100,7 +103,7 @@ struct BackwardDemodulation::ResultFn
   typedef DHMultiset<Clause*> ClauseSet;
 
   ResultFn(Clause* cl, BackwardDemodulation& parent)
-  : _cl(cl), _parent(parent), _ordering(parent._salg->getOrdering())
+  : _cl(cl), _parent(parent)
   {
     ASS_EQ(_cl->length(),1);
     _eqLit=(*_cl)[0];
@@ -119,19 +122,13 @@ struct BackwardDemodulation::ResultFn
 
     TermQueryResult qr=arg.second;
 
-    if( !ColorHelper::compatible(_cl->color(), qr.clause->color()) ) {
-      //colors of premises don't match
-      return BwSimplificationRecord(0);
-    }
-
-    if(_cl==qr.clause || _removed->find(qr.clause)) {
+    if(_removed->find(qr.clause)) {
       //the retreived clause was already replaced during this
       //backward demodulation
       return BwSimplificationRecord(0);
     }
 
-    unsigned qrSort = SortHelper::getTermSort(qr.term, qr.literal);
-    if(qrSort!=_eqSort) {
+    if(!canRewrite(_cl, _eqSort, qr)) {
       return BwSimplificationRecord(0);
     }
 
@@ -159,77 +156,112 @@ struct BackwardDemodulation::ResultFn
       rhsS=qr.substitution->applyToBoundQuery(rhs);
     }
 
-    if(_ordering.compare(lhsS,rhsS)!=Ordering::GREATER) {
-      return BwSimplificationRecord(0);
+    BwSimplificationRecord res=_parent.rewrite(_cl, qr, lhsS, rhsS);
+    if(res.toRemove) {
+      _removed->insert(qr.clause);
     }
+    return res;
+  }
+private:
+  unsigned _eqSort;
+  Literal* _eqLit;
+  Clause* _cl;
+  SmartPtr<ClauseSet> _removed;
 
-    if(_parent.getOptions().demodulationRedundancyCheck() && qr.literal->isEquality() &&
-      (qr.term==*qr.literal->nthArgument(0) || qr.term==*qr.literal->nthArgument(1)) ) {
-      TermList other=EqHelper::getOtherEqualitySide(qr.literal, qr.term);
-      Ordering::Result tord=_ordering.compare(rhsS, other);
-      if(tord!=Ordering::LESS && tord!=Ordering::LESS_EQ) {
-        unsigned eqSort = SortHelper::getEqualityArgumentSort(qr.literal);
-        Literal* eqLitS=Literal::createEquality(true, lhsS, rhsS, eqSort);
-        bool isMax=true;
-        Clause::Iterator cit(*qr.clause);
-        while(cit.hasNext()) {
-          Literal* lit2=cit.next();
-          if(qr.literal==lit2) {
-            continue;
-          }
-          if(_ordering.compare(eqLitS, lit2)==Ordering::LESS) {
-            isMax=false;
-            break;
-          }
+  BackwardDemodulation& _parent;
+};
+
+
+/**
+ * Return true if the unit equality @b premise of sort @b eqSort may
+ * rewrite the term of @b qr in its clause.
+ */
+bool BackwardDemodulation::canRewrite(Clause* premise, unsigned eqSort, const TermQueryResult& qr)
+{
+  if( !ColorHelper::compatible(premise->color(), qr.clause->color()) ) {
+    //colors of premises don't match
+    return false;
+  }
+  if(premise==qr.clause) {
+    return false;
+  }
+  return SortHelper::getTermSort(qr.term, qr.literal)==eqSort;
+}
+
+/**
+ * Rewrite the term @b lhsS of @b qr into @b rhsS using the unit
+ * equality @b premise, unless the ordering or the redundancy check
+ * prevent it. Return record with zero clauses if the rewriting is
+ * not done.
+ */
+BwSimplificationRecord BackwardDemodulation::rewrite(Clause* premise, const TermQueryResult& qr,
+	TermList lhsS, TermList rhsS)
+{
+  CALL("BackwardDemodulation::rewrite");
+
+  Ordering& ordering=_salg->getOrdering();
+
+  if(ordering.compare(lhsS,rhsS)!=Ordering::GREATER) {
+    return BwSimplificationRecord(0);
+  }
+
+  if(getOptions().demodulationRedundancyCheck() && qr.literal->isEquality() &&
+    (qr.term==*qr.literal->nthArgument(0) || qr.term==*qr.literal->nthArgument(1)) ) {
+    TermList other=EqHelper::getOtherEqualitySide(qr.literal, qr.term);
+    Ordering::Result tord=ordering.compare(rhsS, other);
+    if(tord!=Ordering::LESS && tord!=Ordering::LESS_EQ) {
+      unsigned eqSort = SortHelper::getEqualityArgumentSort(qr.literal);
+      Literal* eqLitS=Literal::createEquality(true, lhsS, rhsS, eqSort);
+      bool isMax=true;
+      Clause::Iterator cit(*qr.clause);
+      while(cit.hasNext()) {
+        Literal* lit2=cit.next();
+        if(qr.literal==lit2) {
+          continue;
         }
-        if(isMax) {
-          //	  RSTAT_CTR_INC("bw subsumptions prevented by tlCheck");
-          //The demodulation is this case which doesn't preserve completeness:
-          //s = t     s = t1 \/ C
-          //---------------------
-          //     t = t1 \/ C
-          //where t > t1 and s = t > C
-          return BwSimplificationRecord(0);
+        if(ordering.compare(eqLitS, lit2)==Ordering::LESS) {
+          isMax=false;
+          break;
         }
       }
+      if(isMax) {
+        //	  RSTAT_CTR_INC("bw subsumptions prevented by tlCheck");
+        //The demodulation is this case which doesn't preserve completeness:
+        //s = t     s = t1 \/ C
+        //---------------------
+        //     t = t1 \/ C
+        //where t > t1 and s = t > C
+        return BwSimplificationRecord(0);
+      }
     }
+  }
 
-    Literal* resLit=EqHelper::replace(qr.literal,lhsS,rhsS);
-    if(EqHelper::isEqTautology(resLit)) {
-      env.statistics->backwardDemodulationsToEqTaut++;
-      _removed->insert(qr.clause);
-      return BwSimplificationRecord(qr.clause);
-    }
+  _index->candidateAccepted();
 
-    unsigned cLen=qr.clause->length();
-    Clause* res = new(cLen) Clause(cLen, SimplifyingInference2(InferenceRule::BACKWARD_DEMODULATION, qr.clause, _cl));
+  Literal* resLit=EqHelper::replace(qr.literal,lhsS,rhsS);
+  if(EqHelper::isEqTautology(resLit)) {
+    env.statistics->backwardDemodulationsToEqTaut++;
+    return BwSimplificationRecord(qr.clause);
+  }
 
-    (*res)[0]=resLit;
+  unsigned cLen=qr.clause->length();
+  Clause* res = new(cLen) Clause(cLen, SimplifyingInference2(InferenceRule::BACKWARD_DEMODULATION, qr.clause, premise));
 
-    unsigned next=1;
-    for(unsigned i=0;i<cLen;i++) {
-      Literal* curr=(*qr.clause)[i];
-      if(curr!=qr.literal) {
-        (*res)[next++] = curr;
-      }
-    }
-    ASS_EQ(next,cLen);
-
-    env.statistics->backwardDemodulations++;
+  (*res)[0]=resLit;
 
-    _removed->insert(qr.clause);
-    return BwSimplificationRecord(qr.clause,res);
+  unsigned next=1;
+  for(unsigned i=0;i<cLen;i++) {
+    Literal* curr=(*qr.clause)[i];
+    if(curr!=qr.literal) {
+      (*res)[next++] = curr;
+    }
   }
-private:
-  unsigned _eqSort;
-  Literal* _eqLit;
-  Clause* _cl;
-  SmartPtr<ClauseSet> _removed;
+  ASS_EQ(next,cLen);
 
-  BackwardDemodulation& _parent;
-  Ordering& _ordering;
-};
+  env.statistics->backwardDemodulations++;
 
+  return BwSimplificationRecord(qr.clause,res);
+}
 
 void BackwardDemodulation::perform(Clause* cl,
 	BwSimplificationRecordIterator& simplifications)
@@ -259,4 +291,120 @@ void BackwardDemodulation::perform(Clause* cl,
   simplifications=getPersistentIterator(replacementIterator);
 }
 
+
+/**
+ * Perform backward demodulation with all unit equalities in @b premises.
+ *
+ * When several left-hand sides of the premises share a top symbol, the
+ * part of the index with this top symbol is traversed only once and
+ * each indexed term is matched against all these left-hand sides
+ * using a small index. Other left-hand sides are retrieved from the
+ * index one by one as in @b perform.
+ */
+void BackwardDemodulation::performBatch(const ClauseStack& premises,
+	BwSimplificationRecordIterator& simplifications)
+{
+  CALL("BackwardDemodulation::performBatch");
+
+  TimeCounter tc(TC_BACKWARD_DEMODULATION);
+
+  Stack<pair<TermList,Clause*> > lhss;
+  TermSubstitutionTree lhsIndex;
+  DHMap<unsigned,unsigned> topCounts;
+
+  ClauseStack::ConstIterator pit(premises);
+  while(pit.hasNext()) {
+    Clause* premise=pit.next();
+    if(premise->length()!=1 || !(*premise)[0]->isEquality() || !(*premise)[0]->isPositive() ) {
+      continue;
+    }
+    Literal* lit=(*premise)[0];
+    TermIterator lhsIt=EqHelper::getDemodulationLHSIterator(lit, false, _salg->getOrdering(), _salg->getOptions());
+    while(lhsIt.hasNext()) {
+      TermList lhs=lhsIt.next();
+      lhss.push(make_pair(lhs, premise));
+      if(lhs.isTerm()) {
+        lhsIndex.insert(lhs, lit, premise);
+        unsigned* cnt;
+        topCounts.getValuePtr(lhs.term()->functor(), cnt, 0);
+        (*cnt)++;
+      }
+    }
+  }
+
+  DHSet<Clause*> removed;
+  DHSet<unsigned> traversedTops;
+  Stack<BwSimplificationRecord> res;
+
+  Stack<pair<TermList,Clause*> >::Iterator lhssIt(lhss);
+  while(lhssIt.hasNext()) {
+    pair<TermList,Clause*> lhsAndPremise=lhssIt.next();
+    TermList lhs=lhsAndPremise.first;
+    Clause* premise=lhsAndPremise.second;
+
+    if(lhs.isTerm() && topCounts.get(lhs.term()->functor())>1) {
+      if(!traversedTops.insert(lhs.term()->functor())) {
+        continue;
+      }
+      TermQueryResultIterator tit=_index->getAllWithTop(lhs);
+      while(tit.hasNext()) {
+        TermQueryResult qr=tit.next();
+        if(removed.find(qr.clause)) {
+          continue;
+        }
+        TermQueryResultIterator git=lhsIndex.getGeneralizations(qr.term, true);
+        while(git.hasNext()) {
+          TermQueryResult gqr=git.next();
+          unsigned eqSort=SortHelper::getEqualityArgumentSort(gqr.literal);
+          if(!canRewrite(gqr.clause, eqSort, qr)) {
+            continue;
+          }
+
+          TermList rhs=EqHelper::getOtherEqualitySide(gqr.literal, gqr.term);
+          TermList rhsS;
+          if(!gqr.substitution->isIdentityOnQueryWhenResultBound()) {
+            //see ForwardDemodulation::perform
+            TermList lhsSBadVars=gqr.substitution->applyToResult(gqr.term);
+            TermList rhsSBadVars=gqr.substitution->applyToResult(rhs);
+            Renaming rNorm, qNorm, qDenorm;
+            rNorm.normalizeVariables(lhsSBadVars);
+            qNorm.normalizeVariables(qr.term);
+            qDenorm.makeInverse(qNorm);
+            ASS_EQ(qr.term,qDenorm.apply(rNorm.apply(lhsSBadVars)));
+            rhsS=qDenorm.apply(rNorm.apply(rhsSBadVars));
+          } else {
+            rhsS=gqr.substitution->applyToBoundResult(rhs);
+          }
+
+          BwSimplificationRecord rec=rewrite(gqr.clause, qr, qr.term, rhsS);
+          if(rec.toRemove) {
+            removed.insert(qr.clause);
+            rec.premise=gqr.clause;
+            res.push(rec);
+            break;
+          }
+        }
+      }
+      continue;
+    }
+
+    ResultFn resultFn(premise, *this);
+    TermQueryResultIterator iit=_index->getInstances(lhs, true);
+    while(iit.hasNext()) {
+      TermQueryResult qr=iit.next();
+      if(removed.find(qr.clause)) {
+        continue;
+      }
+      BwSimplificationRecord rec=resultFn(make_pair(lhs, qr));
+      if(rec.toRemove) {
+        removed.insert(qr.clause);
+        rec.premise=premise;
+        res.push(rec);
+      }
+    }
+  }
+
+  simplifications=getPersistentIterator(Stack<BwSimplificationRecord>::Iterator(res));
+}
+
 }
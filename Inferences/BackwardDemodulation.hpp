@@ -46,7 +46,11 @@ public:
   void detach();
 
   void perform(Clause* premise, BwSimplificationRecordIterator& simplifications);
+  void performBatch(const ClauseStack& premises, BwSimplificationRecordIterator& simplifications) override;
 private:
+  static bool canRewrite(Clause* premise, unsigned eqSort, const TermQueryResult& qr);
+  BwSimplificationRecord rewrite(Clause* premise, const TermQueryResult& qr, TermList lhsS, TermList rhsS);
+
   struct RemovedIsNonzeroFn;
   struct RewritableClausesFn;
   struct ResultFn;
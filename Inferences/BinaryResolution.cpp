@@ -34,12 +34,14 @@
 #include "Kernel/Unit.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/LiteralSelector.hpp"
+#include "Kernel/RobSubstitution.hpp"
 #include "Kernel/SortHelper.hpp"
 
 #include "Indexing/Index.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/IndexManager.hpp"
 
+#include "Saturation/ClauseRecipe.hpp"
 #include "Saturation/SaturationAlgorithm.hpp"
 
 #include "Shell/Options.hpp"
@@ -65,6 +67,7 @@ void BinaryResolution::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(GENERATING_SUBST_TREE) );
 
   _unificationWithAbstraction = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
+  _lazyMaterialization = getOptions().lazyClauseMaterialization();
 }
 
 void BinaryResolution::detach()
@@ -99,6 +102,45 @@ private:
   bool _unificationWithAbstraction;
 };
 
+/**
+ * Resolution of @b queryLit of @b queryCl with @b resLit of @b resCl
+ * that was not performed yet.
+ */
+class BinaryResolution::Recipe
+: public ClauseRecipe
+{
+public:
+  CLASS_NAME(BinaryResolution::Recipe);
+  USE_ALLOCATOR(BinaryResolution::Recipe);
+
+  Recipe(const Inference& inf, unsigned weight, BinaryResolution& parent,
+      Clause* queryCl, Literal* queryLit, Clause* resCl, Literal* resLit)
+  : ClauseRecipe(inf, weight), _parent(parent),
+    _queryCl(queryCl), _queryLit(queryLit), _resCl(resCl), _resLit(resLit) {}
+
+  Clause* materialize() override
+  {
+    CALL("BinaryResolution::Recipe::materialize");
+
+    RobSubstitution subst;
+    ALWAYS(subst.unifyArgs(_queryLit, 0, _resLit, 1));
+    SLQueryResult qr(_resLit, _resCl, ResultSubstitution::fromSubstitution(&subst, 0, 1));
+
+    SaturationAlgorithm* salg = _parent._salg;
+    const Options& opts = _parent.getOptions();
+    bool afterCheck = opts.literalMaximalityAftercheck() && salg->getLiteralSelector().isBGComplete();
+    return BinaryResolution::generateClause(_queryCl, _queryLit, qr, opts, salg->getPassiveClauseContainer(),
+        afterCheck ? &salg->getOrdering() : 0, &salg->getLiteralSelector());
+  }
+
+private:
+  BinaryResolution& _parent;
+  Clause* _queryCl;
+  Literal* _queryLit;
+  Clause* _resCl;
+  Literal* _resLit;
+};
+
 struct BinaryResolution::ResultFn
 {
   ResultFn(Clause* cl, PassiveClauseContainer* passiveClauseContainer, bool afterCheck, Ordering* ord, LiteralSelector& selector, BinaryResolution& parent)
@@ -111,7 +153,17 @@ struct BinaryResolution::ResultFn
     SLQueryResult& qr = arg.second;
     Literal* resLit = arg.first;
 
-    return BinaryResolution::generateClause(_cl, resLit, qr, _parent.getOptions(), _passiveClauseContainer, _afterCheck ? _ord : 0, &_selector);
+    Clause* res;
+    if (_parent._lazyMaterialization && (qr.constraints.isEmpty() || qr.constraints->isEmpty())) {
+      res = _parent.addRecipe(_cl, resLit, qr);
+    }
+    else {
+      res = BinaryResolution::generateClause(_cl, resLit, qr, _parent.getOptions(), _passiveClauseContainer, _afterCheck ? _ord : 0, &_selector);
+    }
+    if (res) {
+      _parent._index->candidateAccepted();
+    }
+    return res;
   }
 private:
   Clause* _cl;
@@ -325,6 +377,35 @@ Clause* BinaryResolution::generateClause(Clause* queryCl, Literal* queryLit, SLQ
   return res;
 }
 
+/**
+ * Pass the resolution to the saturation algorithm as a recipe
+ * and return 0.
+ */
+Clause* BinaryResolution::addRecipe(Clause* queryCl, Literal* queryLit, SLQueryResult& qr)
+{
+  CALL("BinaryResolution::addRecipe");
+
+  unsigned weight = 0;
+  unsigned clength = queryCl->length();
+  for(unsigned i=0;i<clength;i++) {
+    Literal* curr=(*queryCl)[i];
+    if(curr!=queryLit) {
+      weight += qr.substitution->getApplicationWeight(curr, false);
+    }
+  }
+  unsigned dlength = qr.clause->length();
+  for(unsigned i=0;i<dlength;i++) {
+    Literal* curr=(*qr.clause)[i];
+    if(curr!=qr.literal) {
+      weight += qr.substitution->getApplicationWeight(curr, true);
+    }
+  }
+
+  Inference inf(GeneratingInference2(InferenceRule::RESOLUTION, queryCl, qr.clause));
+  _salg->addClauseRecipe(new Recipe(inf, Int::max(weight, 1u), *this, queryCl, queryLit, qr.clause, qr.literal));
+  return 0;
+}
+
 ClauseIterator BinaryResolution::generateClauses(Clause* premise)
 {
   CALL("BinaryResolution::generateClauses");
@@ -44,7 +44,7 @@ public:
   CLASS_NAME(BinaryResolution);
   USE_ALLOCATOR(BinaryResolution);
 
-  BinaryResolution() : _index(0), _unificationWithAbstraction(false) {}
+  BinaryResolution() : _index(0), _unificationWithAbstraction(false), _lazyMaterialization(false) {}
 
   void attach(SaturationAlgorithm* salg);
   void detach();
@@ -53,11 +53,16 @@ public:
   ClauseIterator generateClauses(Clause* premise);
 
 private:
+  Clause* addRecipe(Clause* queryCl, Literal* queryLit, SLQueryResult& qr);
+
   struct UnificationsFn;
   struct ResultFn;
+  class Recipe;
 
   GeneratingLiteralIndex* _index;
   bool _unificationWithAbstraction;
+  /** True if the lazy_clause_materialization option is on */
+  bool _lazyMaterialization;
 };
 
 };
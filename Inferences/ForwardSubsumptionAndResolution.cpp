@@ -37,6 +37,7 @@
 #include "Kernel/ColorHelper.hpp"
 
 #include "Indexing/Index.hpp"
+#include "Indexing/FeatureVectorIndex.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/LiteralMiniIndex.hpp"
 #include "Indexing/IndexManager.hpp"
@@ -63,17 +64,30 @@ void ForwardSubsumptionAndResolution::attach(SaturationAlgorithm* salg)
   ForwardSimplificationEngine::attach(salg);
   _unitIndex=static_cast<UnitClauseLiteralIndex*>(
 	  _salg->getIndexManager()->request(SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE) );
-  _fwIndex=static_cast<FwSubsSimplifyingLiteralIndex*>(
+  if(_salg->getOptions().featureVectorSubsumption()) {
+    _fvIndex=static_cast<FeatureVectorIndex*>(
+	  _salg->getIndexManager()->request(SUBSUMPTION_FEATURE_VECTOR_INDEX) );
+  }
+  //with the feature vector index, the literal index is only needed for subsumption resolution
+  if(!_fvIndex || _subsumptionResolution) {
+    _fwIndex=static_cast<FwSubsSimplifyingLiteralIndex*>(
 	  _salg->getIndexManager()->request(FW_SUBSUMPTION_SUBST_TREE) );
+  }
 }
 
 void ForwardSubsumptionAndResolution::detach()
 {
   CALL("ForwardSubsumptionAndResolution::detach");
+  _salg->getIndexManager()->release(SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE);
+  if(_fwIndex) {
+    _salg->getIndexManager()->release(FW_SUBSUMPTION_SUBST_TREE);
+  }
+  if(_fvIndex) {
+    _salg->getIndexManager()->release(SUBSUMPTION_FEATURE_VECTOR_INDEX);
+  }
   _unitIndex=0;
   _fwIndex=0;
-  _salg->getIndexManager()->release(SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE);
-  _salg->getIndexManager()->release(FW_SUBSUMPTION_SUBST_TREE);
+  _fvIndex=0;
   ForwardSimplificationEngine::detach();
 }
 
@@ -187,6 +201,28 @@ bool isSubsumed(Clause* cl, CMStack& cmStore)
   return false;
 }
 
+/**
+ * Compute the literal matches of the candidate @b mcl, store them in
+ * @b cmStore, and return true if @b mcl subsumes @b cl.
+ */
+bool checkSubsumptionCandidate(Clause* cl, Clause* mcl, LiteralMiniIndex& miniIndex, CMStack& cmStore)
+{
+  CALL("checkSubsumptionCandidate");
+  ASS_G(mcl->length(),1);
+
+  env.statistics->forwardSubsumptionCandidates++;
+
+  ClauseMatches* cms=new ClauseMatches(mcl);
+  mcl->setAux(cms);
+  cmStore.push(cms);
+  cms->fillInMatches(&miniIndex);
+
+  if(cms->anyNonMatched()) {
+    return false;
+  }
+  return MLMatcher::canBeMatched(mcl,cl,cms->_matches,0) && ColorHelper::compatible(cl->color(), mcl->color());
+}
+
 Clause* ForwardSubsumptionAndResolution::generateSubsumptionResolutionClause(Clause* cl, Literal* lit, Clause* baseClause)
 {
   CALL("ForwardSubsumptionAndResolution::generateSubsumptionResolutionClause");
@@ -273,6 +309,7 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       }
       premise->setAux(0);
       if(ColorHelper::compatible(cl->color(), premise->color()) ) {
+        _unitIndex->candidateAccepted();
         premises = pvi( getSingletonIterator(premise) );
         env.statistics->forwardSubsumed++;
         result = true;
@@ -284,30 +321,14 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
   {
   LiteralMiniIndex miniIndex(cl);
 
-  for(unsigned li=0;li<clen;li++) {
-    SLQueryResultIterator rit=_fwIndex->getGeneralizations( (*cl)[li], false, false);
-    while(rit.hasNext()) {
-      SLQueryResult res=rit.next();
-      Clause* mcl=res.clause;
-      if(mcl->hasAux()) {
-	//we've already checked this clause
-	continue;
-      }
-      unsigned mlen=mcl->length();
-      ASS_G(mlen,1);
-
-      ClauseMatches* cms=new ClauseMatches(mcl);
-      mcl->setAux(cms);
-      cmStore.push(cms);
-      //      cms->addMatch(res.literal, (*cl)[li]);
-      //      cms->fillInMatches(&miniIndex, res.literal, (*cl)[li]);
-      cms->fillInMatches(&miniIndex);
-
-      if(cms->anyNonMatched()) {
-	continue;
-      }
-
-      if(MLMatcher::canBeMatched(mcl,cl,cms->_matches,0) && ColorHelper::compatible(cl->color(), mcl->color())) {
+  if(_fvIndex) {
+    ClauseIterator cit=_fvIndex->getSubsumingCandidates(cl);
+    while(cit.hasNext()) {
+      Clause* mcl=cit.next();
+      //the index returns each clause once and contains no unit clauses
+      ASS(!mcl->hasAux());
+      if(checkSubsumptionCandidate(cl, mcl, miniIndex, cmStore)) {
+        _fvIndex->candidateAccepted();
         premises = pvi( getSingletonIterator(mcl) );
         env.statistics->forwardSubsumed++;
         result = true;
@@ -315,6 +336,26 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       }
     }
   }
+  else {
+    //the candidates are retrieved lazily, as the first ones often subsume cl
+    for(unsigned li=0;li<clen;li++) {
+      SLQueryResultIterator rit=_fwIndex->getGeneralizations( (*cl)[li], false, false);
+      while(rit.hasNext()) {
+	Clause* mcl=rit.next().clause;
+	if(mcl->hasAux()) {
+	  //we've already checked this clause
+	  continue;
+	}
+	if(checkSubsumptionCandidate(cl, mcl, miniIndex, cmStore)) {
+	  _fwIndex->candidateAccepted();
+	  premises = pvi( getSingletonIterator(mcl) );
+	  env.statistics->forwardSubsumed++;
+	  result = true;
+	  goto fin;
+	}
+      }
+    }
+  }
 
   tc_fs.stop();
 
@@ -325,12 +366,18 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
   {
     TimeCounter tc_fsr(TC_FORWARD_SUBSUMPTION_RESOLUTION);
 
+    //generalizations of the literals of cl in the literal index,
+    //retrieved for all literals at once, as the checks below mostly
+    //go through all of them
+    DArray<Stack<SLQueryResult> > genResults;
+
     for(unsigned li=0;li<clen;li++) {
       Literal* resLit=(*cl)[li];
       SLQueryResultIterator rit=_unitIndex->getGeneralizations( resLit, true, false);
       while(rit.hasNext()) {
 	Clause* mcl=rit.next().clause;
 	if(ColorHelper::compatible(cl->color(), mcl->color())) {
+	  _unitIndex->candidateAccepted();
 	  resolutionClause=generateSubsumptionResolutionClause(cl,resLit,mcl);
 	  env.statistics->forwardSubsumptionResolution++;
 	  premises = pvi( getSingletonIterator(mcl) );
@@ -341,6 +388,25 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       }
     }
 
+    if(_fvIndex) {
+      //the clauses with a literal matching a literal of cl are not
+      //necessarily candidates of the feature vector index
+      _fwIndex->getGeneralizations(cl, false, genResults);
+      for(unsigned li=0;li<clen;li++) {
+	Stack<SLQueryResult>::BottomFirstIterator rit(genResults[li]);
+	while(rit.hasNext()) {
+	  Clause* mcl=rit.next().clause;
+	  if(mcl->hasAux()) {
+	    continue;
+	  }
+	  ClauseMatches* cms=new ClauseMatches(mcl);
+	  mcl->setAux(cms);
+	  cmStore.push(cms);
+	  cms->fillInMatches(&miniIndex);
+	}
+      }
+    }
+
     {
       CMStack::Iterator csit(cmStore);
       while(csit.hasNext()) {
@@ -348,6 +414,7 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 	for(unsigned li=0;li<clen;li++) {
 	  Literal* resLit=(*cl)[li];
 	  if(checkForSubsumptionResolution(cl, cms, resLit) && ColorHelper::compatible(cl->color(), cms->_cl->color()) ) {
+	    _fwIndex->candidateAccepted();
 	    resolutionClause=generateSubsumptionResolutionClause(cl,resLit,cms->_cl);
 	    env.statistics->forwardSubsumptionResolution++;
 	    premises = pvi( getSingletonIterator(cms->_cl) );
@@ -359,9 +426,10 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       }
     }
 
+    _fwIndex->getGeneralizations(cl, true, genResults);
     for(unsigned li=0;li<clen;li++) {
       Literal* resLit=(*cl)[li];	//resolved literal
-      SLQueryResultIterator rit=_fwIndex->getGeneralizations( resLit, true, false);
+      Stack<SLQueryResult>::BottomFirstIterator rit(genResults[li]);
       while(rit.hasNext()) {
 	SLQueryResult res=rit.next();
 	Clause* mcl=res.clause;
@@ -377,6 +445,7 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
 	cms->fillInMatches(&miniIndex);
 
 	if(checkForSubsumptionResolution(cl, cms, resLit) && ColorHelper::compatible(cl->color(), cms->_cl->color())) {
+	  _fwIndex->candidateAccepted();
 	  resolutionClause=generateSubsumptionResolutionClause(cl,resLit,cms->_cl);
 	  env.statistics->forwardSubsumptionResolution++;
           premises = pvi( getSingletonIterator(cms->_cl) );
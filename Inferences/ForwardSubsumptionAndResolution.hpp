@@ -43,7 +43,7 @@ public:
   USE_ALLOCATOR(ForwardSubsumptionAndResolution);
 
   ForwardSubsumptionAndResolution(bool subsumptionResolution=true)
-  : _subsumptionResolution(subsumptionResolution) {}
+  : _fwIndex(0), _fvIndex(0), _subsumptionResolution(subsumptionResolution) {}
 
   void attach(SaturationAlgorithm* salg) override;
   void detach() override;
@@ -54,6 +54,8 @@ private:
   /** Simplification unit index */
   UnitClauseLiteralIndex* _unitIndex;
   FwSubsSimplifyingLiteralIndex* _fwIndex;
+  /** Index of the candidates of subsumption if the feature vector index is used, zero otherwise */
+  FeatureVectorIndex* _fvIndex;
 
   bool _subsumptionResolution;
 };
@@ -24,6 +24,7 @@
 #include "Lib/Environment.hpp"
 #include "Lib/Random.hpp"
 #include "Lib/DArray.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/List.hpp"
 #include "Lib/Metaiterators.hpp"
 
@@ -158,6 +159,43 @@ struct GeneratingFunctor
   { return gie->generateClauses(cl); }
   Clause* cl;
 };
+/**
+ * Perform backward simplification with all clauses of @b premises.
+ *
+ * Each returned record has its premise set, and no clause is removed
+ * by more than one record. The default implementation calls @b perform
+ * for each premise, descendant classes can share index traversals among
+ * the premises.
+ */
+void BackwardSimplificationEngine::performBatch(const ClauseStack& premises,
+	BwSimplificationRecordIterator& simplifications)
+{
+  CALL("BackwardSimplificationEngine::performBatch");
+
+  DHSet<Clause*> removed;
+  Stack<BwSimplificationRecord> res;
+
+  ClauseStack::ConstIterator pit(premises);
+  while(pit.hasNext()) {
+    Clause* premise=pit.next();
+    BwSimplificationRecordIterator sit;
+    perform(premise, sit);
+    while(sit.hasNext()) {
+      BwSimplificationRecord rec=sit.next();
+      if(!removed.insert(rec.toRemove)) {
+	//the clause is already removed with an earlier premise
+	if(rec.replacement) {
+	  rec.replacement->destroyIfUnnecessary();
+	}
+	continue;
+      }
+      rec.premise=premise;
+      res.push(rec);
+    }
+  }
+  simplifications=getPersistentIterator(Stack<BwSimplificationRecord>::Iterator(res));
+}
+
 CompositeGIE::~CompositeGIE()
 {
   GIList::destroyWithDeletion(_inners);
@@ -149,12 +149,16 @@ struct BwSimplificationRecord
 {
   BwSimplificationRecord() {}
   BwSimplificationRecord(Clause* toRemove)
-  : toRemove(toRemove), replacement(0) {}
+  : toRemove(toRemove), replacement(0), premise(0) {}
   BwSimplificationRecord(Clause* toRemove, Clause* replacement)
-  : toRemove(toRemove), replacement(replacement) {}
+  : toRemove(toRemove), replacement(replacement), premise(0) {}
+  BwSimplificationRecord(Clause* toRemove, Clause* replacement, Clause* premise)
+  : toRemove(toRemove), replacement(replacement), premise(premise) {}
 
   Clause* toRemove;
   Clause* replacement;
+  /** The simplifying clause, set only by BackwardSimplificationEngine::performBatch() */
+  Clause* premise;
 };
 typedef VirtualIterator<BwSimplificationRecord> BwSimplificationRecordIterator;
 
@@ -170,6 +174,8 @@ public:
    * the time of call to this method.
    */
   virtual void perform(Clause* premise, BwSimplificationRecordIterator& simplifications) = 0;
+
+  virtual void performBatch(const ClauseStack& premises, BwSimplificationRecordIterator& simplifications);
 };
 
 
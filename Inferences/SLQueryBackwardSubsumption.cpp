@@ -38,6 +38,7 @@
 #include "Kernel/Term.hpp"
 #include "Kernel/ColorHelper.hpp"
 
+#include "Indexing/FeatureVectorIndex.hpp"
 #include "Indexing/Index.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/IndexManager.hpp"
@@ -68,6 +69,10 @@ void SLQueryBackwardSubsumption::attach(SaturationAlgorithm* salg)
   BackwardSimplificationEngine::attach(salg);
   _index=static_cast<SimplifyingLiteralIndex*>(
 	  _salg->getIndexManager()->request(SIMPLIFYING_SUBST_TREE) );
+  if(_salg->getOptions().featureVectorSubsumption()) {
+    _fvIndex=static_cast<FeatureVectorIndex*>(
+	  _salg->getIndexManager()->request(SUBSUMPTION_FEATURE_VECTOR_INDEX) );
+  }
 }
 
 void SLQueryBackwardSubsumption::detach()
@@ -75,6 +80,10 @@ void SLQueryBackwardSubsumption::detach()
   CALL("SLQueryBackwardSubsumption::detach");
   _index=0;
   _salg->getIndexManager()->release(SIMPLIFYING_SUBST_TREE);
+  if(_fvIndex) {
+    _fvIndex=0;
+    _salg->getIndexManager()->release(SUBSUMPTION_FEATURE_VECTOR_INDEX);
+  }
   BackwardSimplificationEngine::detach();
 }
 
@@ -144,6 +153,11 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
     return;
   }
 
+  if(_fvIndex) {
+    performWithFeatureVectorIndex(cl, simplifications);
+    return;
+  }
+
   unsigned lmIndex=0; //least matchable literal index
   unsigned lmVal=(*cl)[0]->weight();
   for(unsigned i=1;i<clen;i++) {
@@ -183,6 +197,7 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
     }
 
     RSTAT_CTR_INC("bs1 0 candidates");
+    env.statistics->backwardSubsumptionCandidates++;
 
     //here we pick one literal header of the base clause and make sure that
     //every instance clause has it
@@ -293,4 +308,62 @@ void SLQueryBackwardSubsumption::perform(Clause* cl,
   return;
 }
 
+/**
+ * Perform backward subsumption by a non-unit clause with the candidates
+ * retrieved from the feature vector index. The index already ensures
+ * that the candidates have enough literals with each predicate symbol,
+ * so the literal matches are computed right away.
+ */
+void SLQueryBackwardSubsumption::performWithFeatureVectorIndex(Clause* cl,
+	BwSimplificationRecordIterator& simplifications)
+{
+  CALL("SLQueryBackwardSubsumption::performWithFeatureVectorIndex");
+
+  unsigned clen=cl->length();
+
+  static DArray<LiteralList*> matchedLits(32);
+  matchedLits.init(clen, 0);
+
+  ClauseList* subsumed=0;
+
+  ClauseIterator cit=_fvIndex->getSubsumedCandidates(cl);
+  while(cit.hasNext()) {
+    Clause* icl=cit.next();
+    if(icl==cl) {
+      continue;
+    }
+    env.statistics->backwardSubsumptionCandidates++;
+
+    unsigned ilen=icl->length();
+    ASS_GE(ilen,clen);
+    for(unsigned bi=0;bi<clen;bi++) {
+      for(unsigned ii=0;ii<ilen;ii++) {
+	if(MatchingUtils::match((*cl)[bi],(*icl)[ii],false)) {
+	  LiteralList::push((*icl)[ii], matchedLits[bi]);
+	}
+      }
+      if(!matchedLits[bi]) {
+	goto match_fail;
+      }
+    }
+
+    if(MLMatcher::canBeMatched(cl,icl,matchedLits.array(),0)) {
+      ClauseList::push(icl, subsumed);
+      env.statistics->backwardSubsumed++;
+    }
+
+  match_fail:
+    for(unsigned bi=0; bi<clen; bi++) {
+      LiteralList::destroy(matchedLits[bi]);
+      matchedLits[bi]=0;
+    }
+  }
+
+  if(subsumed) {
+    simplifications=getPersistentIterator(
+	    getMappingIterator(ClauseList::Iterator(subsumed), ClauseToBwSimplRecordFn()));
+    ClauseList::destroy(subsumed);
+  }
+}
+
 }
@@ -38,7 +38,7 @@ public:
   CLASS_NAME(SLQueryBackwardSubsumption);
   USE_ALLOCATOR(SLQueryBackwardSubsumption);
 
-  SLQueryBackwardSubsumption(bool byUnitsOnly) : _byUnitsOnly(byUnitsOnly), _index(0) {}
+  SLQueryBackwardSubsumption(bool byUnitsOnly) : _byUnitsOnly(byUnitsOnly), _index(0), _fvIndex(0) {}
 
   /**
    * Create SLQueryBackwardSubsumption rule with explicitely provided index,
@@ -47,7 +47,7 @@ public:
    * For objects created by this constructor, methods  @c attach()
    * and @c detach() must not be called.
    */
-  SLQueryBackwardSubsumption(SimplifyingLiteralIndex* index, bool byUnitsOnly=false) : _byUnitsOnly(byUnitsOnly), _index(index) {}
+  SLQueryBackwardSubsumption(SimplifyingLiteralIndex* index, bool byUnitsOnly=false) : _byUnitsOnly(byUnitsOnly), _index(index), _fvIndex(0) {}
 
   void attach(SaturationAlgorithm* salg);
   void detach();
@@ -57,8 +57,12 @@ private:
   struct ClauseExtractorFn;
   struct ClauseToBwSimplRecordFn;
 
+  void performWithFeatureVectorIndex(Clause* cl, BwSimplificationRecordIterator& simplifications);
+
   bool _byUnitsOnly;
   SimplifyingLiteralIndex* _index;
+  /** Index of the candidates for non-unit clauses if the feature vector index is used, zero otherwise */
+  FeatureVectorIndex* _fvIndex;
 };
 
 };
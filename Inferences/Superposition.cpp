@@ -34,6 +34,7 @@
 #include "Kernel/EqHelper.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/Ordering.hpp"
+#include "Kernel/RobSubstitution.hpp"
 #include "Kernel/SortHelper.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/TermIterators.hpp"
@@ -44,6 +45,7 @@
 #include "Indexing/IndexManager.hpp"
 #include "Indexing/TermSharing.hpp"
 
+#include "Saturation/ClauseRecipe.hpp"
 #include "Saturation/SaturationAlgorithm.hpp"
 
 #include "Shell/Options.hpp"
@@ -71,6 +73,7 @@ void Superposition::attach(SaturationAlgorithm* salg)
 	  _salg->getIndexManager()->request(SUPERPOSITION_SUBTERM_SUBST_TREE) );
   _lhsIndex=static_cast<SuperpositionLHSIndex*> (
 	  _salg->getIndexManager()->request(SUPERPOSITION_LHS_SUBST_TREE) );
+  _lazyMaterialization = getOptions().lazyClauseMaterialization();
 }
 
 void Superposition::detach()
@@ -149,8 +152,13 @@ struct Superposition::ForwardResultFn
     CALL("Superposition::ForwardResultFn::operator()");
 
     TermQueryResult& qr = arg.second;
-    return _parent.performSuperposition(_cl, arg.first.first, arg.first.second,
-	    qr.clause, qr.literal, qr.term, qr.substitution, true, _passiveClauseContainer, qr.constraints);
+    Clause* res = _parent.performSuperposition(_cl, arg.first.first, arg.first.second,
+	    qr.clause, qr.literal, qr.term, qr.substitution, true, _passiveClauseContainer, qr.constraints,
+	    _parent._lazyMaterialization);
+    if(res) {
+      _parent._lhsIndex->candidateAccepted();
+    }
+    return res;
   }
 private:
   Clause* _cl;
@@ -172,8 +180,13 @@ struct Superposition::BackwardResultFn
     }
 
     TermQueryResult& qr = arg.second;
-    return _parent.performSuperposition(qr.clause, qr.literal, qr.term,
-	    _cl, arg.first.first, arg.first.second, qr.substitution, false, _passiveClauseContainer, qr.constraints);
+    Clause* res = _parent.performSuperposition(qr.clause, qr.literal, qr.term,
+	    _cl, arg.first.first, arg.first.second, qr.substitution, false, _passiveClauseContainer, qr.constraints,
+	    _parent._lazyMaterialization);
+    if(res) {
+      _parent._subtermIndex->candidateAccepted();
+    }
+    return res;
   }
 private:
   Clause* _cl;
@@ -182,6 +195,44 @@ private:
 };
 
 
+/**
+ * Superposition of @b eqClause into @b rwClause that was not performed yet.
+ */
+class Superposition::Recipe
+: public ClauseRecipe
+{
+public:
+  CLASS_NAME(Superposition::Recipe);
+  USE_ALLOCATOR(Superposition::Recipe);
+
+  Recipe(const Inference& inf, unsigned weight, Superposition& parent,
+      Clause* rwClause, Literal* rwLit, TermList rwTerm,
+      Clause* eqClause, Literal* eqLit, TermList eqLHS)
+  : ClauseRecipe(inf, weight), _parent(parent),
+    _rwClause(rwClause), _rwLit(rwLit), _rwTerm(rwTerm),
+    _eqClause(eqClause), _eqLit(eqLit), _eqLHS(eqLHS) {}
+
+  Clause* materialize() override
+  {
+    CALL("Superposition::Recipe::materialize");
+
+    RobSubstitution subst;
+    ALWAYS(subst.unify(_rwTerm, 0, _eqLHS, 1));
+    return _parent.performSuperposition(_rwClause, _rwLit, _rwTerm, _eqClause, _eqLit, _eqLHS,
+        ResultSubstitution::fromSubstitution(&subst, 0, 1), true,
+        _parent._salg->getPassiveClauseContainer(), UnificationConstraintStackSP());
+  }
+
+private:
+  Superposition& _parent;
+  Clause* _rwClause;
+  Literal* _rwLit;
+  TermList _rwTerm;
+  Clause* _eqClause;
+  Literal* _eqLit;
+  TermList _eqLHS;
+};
+
 ClauseIterator Superposition::generateClauses(Clause* premise)
 {
   CALL("Superposition::generateClauses");
@@ -374,12 +425,16 @@ bool Superposition::earlyWeightLimitCheck(Clause* eqClause, Literal* eqLit,
 /**
  * If superposition should be performed, return result of the superposition,
  * otherwise return 0.
+ *
+ * If @b lazy is true and there are no unification constraints, the
+ * superposition is passed to the saturation algorithm as a recipe and
+ * 0 is returned.
  */
 Clause* Superposition::performSuperposition(
     Clause* rwClause, Literal* rwLit, TermList rwTerm,
     Clause* eqClause, Literal* eqLit, TermList eqLHS,
     ResultSubstitutionSP subst, bool eqIsResult, PassiveClauseContainer* passiveClauseContainer,
-    UnificationConstraintStackSP constraints)
+    UnificationConstraintStackSP constraints, bool lazy)
 {
   CALL("Superposition::performSuperposition");
   // we want the rwClause and eqClause to be active
@@ -441,6 +496,29 @@ Clause* Superposition::performSuperposition(
     }
   }
 
+  if(lazy && !hasConstraints) {
+    //estimate the weight assuming that rwTerm occurs once in rwLit
+    int weight = subst->getApplicationWeight(rwLit, !eqIsResult);
+    weight += subst->getApplicationWeight(tgtTerm, eqIsResult);
+    weight -= subst->getApplicationWeight(eqLHS, eqIsResult);
+    for(unsigned i=0;i<rwLength;i++) {
+      Literal* curr=(*rwClause)[i];
+      if(curr!=rwLit) {
+        weight += subst->getApplicationWeight(curr, !eqIsResult);
+      }
+    }
+    for(unsigned i=0;i<eqLength;i++) {
+      Literal* curr=(*eqClause)[i];
+      if(curr!=eqLit) {
+        weight += subst->getApplicationWeight(curr, eqIsResult);
+      }
+    }
+    inf_destroyer.disable(); // ownership passed to the recipe below
+    _salg->addClauseRecipe(new Recipe(inf, Int::max(weight, 1), *this,
+        rwClause, rwLit, rwTerm, eqClause, eqLit, eqLHS));
+    return 0;
+  }
+
   Ordering& ordering = _salg->getOrdering();
 
   TermList eqLHSS = subst->apply(eqLHS, eqIsResult);
@@ -54,7 +54,7 @@ private:
 	  Clause* rwClause, Literal* rwLiteral, TermList rwTerm,
 	  Clause* eqClause, Literal* eqLiteral, TermList eqLHS,
 	  ResultSubstitutionSP subst, bool eqIsResult, PassiveClauseContainer* passiveClauseContainer,
-          UnificationConstraintStackSP constraints);
+          UnificationConstraintStackSP constraints, bool lazy=false);
 
   bool checkClauseColorCompatibility(Clause* eqClause, Clause* rwClause);
   static bool earlyWeightLimitCheck(Clause* eqClause, Literal* eqLit,
@@ -71,8 +71,12 @@ private:
   struct RewritableResultsFn;
   struct BackwardResultFn;
 
+  class Recipe;
+
   SuperpositionSubtermIndex* _subtermIndex;
   SuperpositionLHSIndex* _lhsIndex;
+  /** True if the lazy_clause_materialization option is on */
+  bool _lazyMaterialization;
 };
 
 
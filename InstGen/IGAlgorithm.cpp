@@ -121,8 +121,11 @@ IGAlgorithm::IGAlgorithm(Problem& prb,const Options& opt)
     _globalSubsumption = new GlobalSubsumption(_opt,_groundingIndex.ptr());
   }
 
+  _use_fingerprints = _opt.useFingerprintVariantIndex();
   _use_hashing = _opt.useHashingVariantIndex();
-  if (_use_hashing) {
+  if (_use_fingerprints) {
+    _variantIdx = new FingerprintClauseVariantIndex();
+  } else if (_use_hashing) {
     _variantIdx = new HashingClauseVariantIndex();
   } else {
     _variantIdx = new SubstitutionTreeClauseVariantIndex();
@@ -756,7 +759,9 @@ void IGAlgorithm::wipeIndexes()
 
   delete _selected;
   delete _variantIdx;
-  if (_use_hashing) {
+  if (_use_fingerprints) {
+    _variantIdx = new FingerprintClauseVariantIndex();
+  } else if (_use_hashing) {
     _variantIdx = new HashingClauseVariantIndex();
   } else {
     _variantIdx = new SubstitutionTreeClauseVariantIndex();
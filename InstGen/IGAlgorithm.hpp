@@ -166,6 +166,7 @@ private:
 
   RCClauseStack _inputClauses;
 
+  bool _use_fingerprints;
   bool _use_hashing;
   ClauseVariantIndex* _variantIdx;
 
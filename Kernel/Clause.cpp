@@ -41,6 +41,7 @@
 #include "SAT/SATClause.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "Inference.hpp"
 #include "Signature.hpp"
@@ -73,6 +74,7 @@ Clause::Clause(unsigned length,const Inference& inf)
     _extensionality(false),
     _extensionalityTag(false),
     _component(false),
+    _reclaimed(false),
     _store(NONE),
     _numSelected(0),
     _weight(0),
@@ -140,6 +142,10 @@ void Clause::destroyExceptInferenceObject()
   size_t size = sizeof(Clause) + _length * sizeof(Literal*);
   size -= sizeof(Literal*);
 
+  if (_reclaimed) {
+    env.statistics->reclaimedClauseMemory += size;
+  }
+
   DEALLOC_KNOWN(this, size,"Clause");
 }
 
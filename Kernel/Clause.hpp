@@ -203,6 +203,9 @@ public:
 
   bool isComponent() const { return _component; }
   void setComponent(bool c) { _component = c; }
+
+  /** Note that a clause derived from this one has forgotten its premises */
+  void markReclaimed() { _reclaimed = true; }
   
   bool skip() const;
 
@@ -362,6 +365,9 @@ protected:
   unsigned _extensionalityTag : 1;
   /** Clause is a splitting component. */
   unsigned _component : 1;
+  /** The memory of the clause is counted as reclaimed when it is destroyed,
+    * see Inference::removePremises() */
+  unsigned _reclaimed : 1;
 
   /** storage class */
   Store _store : 3;
@@ -0,0 +1,206 @@
+/*
+ * File ClauseHeap.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ClauseHeap.cpp
+ * Implements class ClauseHeap.
+ */
+
+#include "Debug/Tracer.hpp"
+
+#include "ClauseHeap.hpp"
+
+/** Number of children of a heap node */
+#define ARITY 4
+
+using namespace Lib;
+using namespace Kernel;
+
+bool ClauseHeap::Key::operator<(const Key& o) const
+{
+  if (primary != o.primary) {
+    return primary < o.primary;
+  }
+  if (secondary != o.secondary) {
+    return secondary < o.secondary;
+  }
+  if (tertiary != o.tertiary) {
+    return tertiary < o.tertiary;
+  }
+  return number < o.number;
+}
+
+/**
+ * Insert @b cl with keys @b key. The clause must not be in the heap.
+ */
+void ClauseHeap::insert(Clause* cl, const Key& key)
+{
+  CALL("ClauseHeap::insert");
+
+  Entry e;
+  e.key = key;
+  e.stamp = _nextStamp++;
+  e.clause = cl;
+  ALWAYS(_live.insert(cl, e.stamp));
+
+  _entries.push(e);
+  siftUp(_entries.size()-1);
+}
+
+/**
+ * Remove @b cl from the heap and return true, or return false
+ * if it is not in the heap.
+ */
+bool ClauseHeap::remove(Clause* cl)
+{
+  CALL("ClauseHeap::remove");
+
+  if (!_live.remove(cl)) {
+    return false;
+  }
+  if (_entries.size() > 2*_live.size() + 1024) {
+    compact();
+  }
+  return true;
+}
+
+/**
+ * Remove the clause with the smallest keys from the heap and return it.
+ * The heap must not be empty.
+ */
+Clause* ClauseHeap::pop()
+{
+  CALL("ClauseHeap::pop");
+
+  Clause* res = top();
+  ALWAYS(_live.remove(res));
+  removeTop();
+  return res;
+}
+
+/**
+ * Return the clause with the smallest keys. The heap must not be empty.
+ */
+Clause* ClauseHeap::top()
+{
+  CALL("ClauseHeap::top");
+  ASS(!isEmpty());
+
+  dropStale();
+  return _entries[0].clause;
+}
+
+/**
+ * Return the keys of the clause returned by @b top().
+ */
+const ClauseHeap::Key& ClauseHeap::topKey()
+{
+  CALL("ClauseHeap::topKey");
+  ASS(!isEmpty());
+
+  dropStale();
+  return _entries[0].key;
+}
+
+bool ClauseHeap::isStale(const Entry& e) const
+{
+  unsigned stamp;
+  return !_live.find(e.clause, stamp) || stamp != e.stamp;
+}
+
+/** Remove entries of removed clauses from the top of the heap */
+void ClauseHeap::dropStale()
+{
+  CALL("ClauseHeap::dropStale");
+
+  while (isStale(_entries[0])) {
+    removeTop();
+  }
+}
+
+void ClauseHeap::siftUp(unsigned pos)
+{
+  Entry e = _entries[pos];
+  while (pos > 0) {
+    unsigned parent = (pos-1)/ARITY;
+    if (!(e.key < _entries[parent].key)) {
+      break;
+    }
+    _entries[pos] = _entries[parent];
+    pos = parent;
+  }
+  _entries[pos] = e;
+}
+
+void ClauseHeap::siftDown(unsigned pos)
+{
+  unsigned size = _entries.size();
+  Entry e = _entries[pos];
+  for (;;) {
+    unsigned first = pos*ARITY+1;
+    if (first >= size) {
+      break;
+    }
+    unsigned last = first+ARITY < size ? first+ARITY : size;
+    unsigned best = first;
+    for (unsigned i = first+1; i < last; i++) {
+      if (_entries[i].key < _entries[best].key) {
+        best = i;
+      }
+    }
+    if (!(_entries[best].key < e.key)) {
+      break;
+    }
+    _entries[pos] = _entries[best];
+    pos = best;
+  }
+  _entries[pos] = e;
+}
+
+/** Remove the entry at the top of the heap */
+void ClauseHeap::removeTop()
+{
+  Entry last = _entries.pop();
+  if (_entries.isNonEmpty()) {
+    _entries[0] = last;
+    siftDown(0);
+  }
+}
+
+/**
+ * Drop all entries of removed clauses and rebuild the heap
+ */
+void ClauseHeap::compact()
+{
+  CALL("ClauseHeap::compact");
+
+  unsigned size = _entries.size();
+  unsigned next = 0;
+  for (unsigned i = 0; i < size; i++) {
+    if (!isStale(_entries[i])) {
+      _entries[next++] = _entries[i];
+    }
+  }
+  _entries.truncate(next);
+  ASS_EQ(next, _live.size());
+
+  if (next > 1) {
+    for (unsigned i = (next-2)/ARITY+1; i > 0; i--) {
+      siftDown(i-1);
+    }
+  }
+}
@@ -0,0 +1,115 @@
+/*
+ * File ClauseHeap.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ClauseHeap.hpp
+ * Defines class ClauseHeap.
+ */
+
+#ifndef __ClauseHeap__
+#define __ClauseHeap__
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+namespace Kernel {
+
+using namespace Lib;
+
+/**
+ * A clause priority queue organised as a 4-ary heap stored in an array.
+ *
+ * Unlike in the ClauseQueue, the keys of a clause are given when it is
+ * inserted and are stored next to it, so comparisons do not touch the
+ * clauses. Removal is lazy and takes constant time: the clause is only
+ * forgotten, and its entry is dropped when it gets to the top or when
+ * the array is compacted.
+ */
+class ClauseHeap
+{
+public:
+  CLASS_NAME(ClauseHeap);
+  USE_ALLOCATOR(ClauseHeap);
+
+  /**
+   * Keys of a clause, compared lexicographically.
+   * Smaller keys are closer to the top.
+   */
+  struct Key
+  {
+    Key() {}
+    Key(unsigned primary, unsigned secondary, unsigned tertiary, unsigned number)
+    : primary(primary), secondary(secondary), tertiary(tertiary), number(number) {}
+
+    bool operator<(const Key& o) const;
+
+    unsigned primary;
+    unsigned secondary;
+    unsigned tertiary;
+    /** Clause number, makes the order total */
+    unsigned number;
+  };
+
+  ClauseHeap() : _nextStamp(0) {}
+
+  void insert(Clause* cl, const Key& key);
+  bool remove(Clause* cl);
+  Clause* pop();
+  Clause* top();
+  const Key& topKey();
+
+  /** True if the heap contains no clause */
+  bool isEmpty() const { return _live.isEmpty(); }
+  /** Number of clauses in the heap */
+  unsigned size() const { return _live.size(); }
+
+  /** Iterate over the clauses in the heap in no particular order */
+  VirtualIterator<Clause*> iterator() const { return _live.domain(); }
+
+private:
+  struct Entry
+  {
+    Key key;
+    /** Stamp of the insertion, see @b _live */
+    unsigned stamp;
+    Clause* clause;
+  };
+
+  bool isStale(const Entry& e) const;
+  void dropStale();
+  void siftUp(unsigned pos);
+  void siftDown(unsigned pos);
+  void removeTop();
+  void compact();
+
+  /** The heap, children of the entry at i are at 4*i+1 to 4*i+4 */
+  Stack<Entry> _entries;
+  /**
+   * Clauses in the heap with the stamps of their current entries.
+   * An entry whose clause is missing here or has another stamp was
+   * removed and is skipped.
+   */
+  DHMap<Clause*,unsigned> _live;
+  unsigned _nextStamp;
+}; // class ClauseHeap
+
+} // namespace Kernel
+
+#endif /* __ClauseHeap__ */
@@ -120,6 +120,27 @@ void Inference::destroy()
   }
 }
 
+void Inference::removePremises()
+{
+  CALL("Inference::removePremises");
+
+  Iterator it = iterator();
+  while(hasNext(it)) {
+    Unit* premise = next(it);
+    if(!_removedPremisesFromInput && premise->derivedFromInput()) {
+      _removedPremisesFromInput = true;
+    }
+    if(premise->isClause()) {
+      static_cast<Clause*>(premise)->markReclaimed();
+    }
+  }
+
+  destroy();
+  _kind = Kind::INFERENCE_012;
+  _ptr1 = nullptr;
+  _ptr2 = nullptr;
+}
+
 Inference::Inference(const FromSatRefutation& fsr) {
   CALL("Inference::Inference(FromSatRefutation)");
 
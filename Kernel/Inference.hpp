@@ -594,6 +594,7 @@ private:
     _inputType = inputType;
     _rule = r;
     _included = false;
+    _removedPremisesFromInput = false;
     _inductionDepth = 0;
     _sineLevel = std::numeric_limits<decltype(_sineLevel)>::max();
     _splits = nullptr;
@@ -671,6 +672,17 @@ public:
    */
   void destroy();
 
+  /**
+   * Decrease reference counters in referred units and forget them,
+   * so the inference has no premises from now on. Whether the removed
+   * premises were derived from input is recorded before, so that
+   * Unit::derivedFromInput() stays correct.
+   */
+  void removePremises();
+
+  /** true if the premises were removed and some of them was derived from input */
+  bool removedPremisesFromInput() const { return _removedPremisesFromInput; }
+
   /**
    * Since we treat Inferences as PODs, this is intentionally left empty.
    *
@@ -829,6 +841,9 @@ private:
   /** true if the unit is read from a TPTP included file  */
   bool _included : 1;
 
+  /** see removedPremisesFromInput() */
+  bool _removedPremisesFromInput : 1;
+
   /** track whether all leafs were theory axioms only */
   bool _isPureTheoryDescendant : 1;
 
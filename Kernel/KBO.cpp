@@ -30,6 +30,7 @@
 #include "Lib/Comparison.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "Term.hpp"
 #include "KBO.hpp"
@@ -329,7 +330,19 @@ Ordering::Result KBO::comparePredicates(Literal* l1, Literal* l2) const
   unsigned p1 = l1->functor();
   unsigned p2 = l2->functor();
 
-  Result res;
+  Result res=INCOMPARABLE;
+  bool decided=compareBySummaries(l1,l2,res);
+  if(decided) {
+    env.statistics->kboComparisonsWithoutTraversal++;
+#if !VDEBUG
+    return res;
+#endif
+  }
+#if VDEBUG
+  //the traversal is done anyway to check the result
+  Result summaryRes=res;
+#endif
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -357,6 +370,7 @@ Ordering::Result KBO::comparePredicates(Literal* l1, Literal* l2) const
 #if VDEBUG
   _state=state;
 #endif
+  ASS(!decided || res==summaryRes);
   return res;
 } // KBO::comparePredicates()
 
@@ -388,6 +402,28 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   Term* t1=tl1.term();
   Term* t2=tl2.term();
 
+  Result res;
+  if(findCachedComparison(t1,t2,res)) {
+    return res;
+  }
+  if(compareBySummaries(t1,t2,res)) {
+    env.statistics->kboComparisonsWithoutTraversal++;
+    //the traversal is done anyway to check the result
+    ASS_EQ(res,compareByTraversal(t1,t2));
+  } else {
+    res=compareByTraversal(t1,t2);
+  }
+  cacheComparison(t1,t2,res);
+  return res;
+}
+
+/**
+ * Compare terms @b t1 and @b t2 by traversing them
+ */
+Ordering::Result KBO::compareByTraversal(Term* t1, Term* t2) const
+{
+  CALL("KBO::compareByTraversal");
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -399,8 +435,8 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   if(t1->functor()==t2->functor()) {
     state->traverse(t1,t2);
   } else {
-    state->traverse(tl1,1);
-    state->traverse(tl2,-1);
+    state->traverse(TermList(t1),1);
+    state->traverse(TermList(t2),-1);
   }
   Result res=state->result(t1,t2);
 #if VDEBUG
@@ -409,6 +445,57 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   return res;
 }
 
+/**
+ * If the comparison of distinct shared terms @b t1 and @b t2, or of
+ * the arguments of shared literals @b t1 and @b t2, can be decided only
+ * from their weights and the summaries of their variables, assign its
+ * result to @b res and return true
+ *
+ * A term can be greater only if it contains each variable at least as
+ * many times as the other term. This fails if the other term has more
+ * variable occurrences, or a variable mask bit the term does not have.
+ */
+bool KBO::compareBySummaries(Term* t1, Term* t2, Result& res) const
+{
+  CALL("KBO::compareBySummaries");
+
+  if(!t1->shared() || !t2->shared() ||
+      t1->color()!=COLOR_TRANSPARENT || t2->color()!=COLOR_TRANSPARENT) {
+    //colored symbols have boosted weights
+    return false;
+  }
+
+  bool t1CanBeGreater = t1->vars()>=t2->vars() && !(t2->varMask() & ~t1->varMask());
+  bool t2CanBeGreater = t2->vars()>=t1->vars() && !(t1->varMask() & ~t2->varMask());
+  if(!t1CanBeGreater && !t2CanBeGreater) {
+    res=INCOMPARABLE;
+    return true;
+  }
+
+  int w1=_defaultSymbolWeight*(t1->weight()-t1->vars())+_variableWeight*t1->vars();
+  int w2=_defaultSymbolWeight*(t2->weight()-t2->vars())+_variableWeight*t2->vars();
+  if(w1>w2) {
+    if(!t1CanBeGreater) {
+      res=INCOMPARABLE;
+      return true;
+    }
+    if(t2->ground()) {
+      res=GREATER;
+      return true;
+    }
+  } else if(w1<w2) {
+    if(!t2CanBeGreater) {
+      res=INCOMPARABLE;
+      return true;
+    }
+    if(t1->ground()) {
+      res=LESS;
+      return true;
+    }
+  }
+  return false;
+}
+
 int KBO::functionSymbolWeight(unsigned fun) const
 {
   int weight = _defaultSymbolWeight;
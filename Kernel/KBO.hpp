@@ -64,6 +64,9 @@ protected:
 
   int functionSymbolWeight(unsigned fun) const;
 
+  Result compareByTraversal(Term* t1, Term* t2) const;
+  bool compareBySummaries(Term* t1, Term* t2, Result& res) const;
+
   bool allConstantsHeavierThanVariables() const { return false; }
   bool existsZeroWeightUnaryFunction() const { return false; }
 
@@ -82,7 +82,19 @@ Ordering::Result LPO::compare(TermList tl1, TermList tl2) const
     return tl2.containsSubterm(tl1) ? LESS : INCOMPARABLE;
   }
   ASS(tl1.isTerm());
-  return clpo(tl1.term(), tl2);
+  if(tl2.isVar()) {
+    return clpo(tl1.term(), tl2);
+  }
+
+  Term* t1=tl1.term();
+  Term* t2=tl2.term();
+  Result res;
+  if(findCachedComparison(t1,t2,res)) {
+    return res;
+  }
+  res=clpo(t1, tl2);
+  cacheComparison(t1,t2,res);
+  return res;
 }
 
 Ordering::Result LPO::clpo(Term* t1, TermList tl2) const
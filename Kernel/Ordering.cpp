@@ -38,6 +38,7 @@
 
 #include "Shell/Options.hpp"
 #include "Shell/Property.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "LPO.hpp"
 #include "KBO.hpp"
@@ -58,6 +59,7 @@ using namespace Kernel;
 OrderingSP Ordering::s_globalOrdering;
 
 Ordering::Ordering()
+: _comparisonCacheBits(0)
 {
   CALL("Ordering::Ordering");
 
@@ -230,6 +232,79 @@ Ordering::Result Ordering::getEqualityArgumentOrder(Literal* eq) const
   return res;
 }
 
+/**
+ * Make the comparison cache have 2^@b bits entries, or remove it if
+ * @b bits is zero
+ */
+void Ordering::initComparisonCache(unsigned bits)
+{
+  CALL("Ordering::initComparisonCache");
+  ASS_L(bits, 32);
+
+  _comparisonCacheBits = bits;
+  _comparisonCache.ensure(bits ? (1u<<bits) : 0);
+  for(unsigned i=0;i<_comparisonCache.size();i++) {
+    _comparisonCache[i].result = 0;
+  }
+}
+
+/**
+ * If the comparison of shared terms @b t1 and @b t2 is in the cache,
+ * assign its result to @b res and return true
+ *
+ * Pairs of terms are stored with the term of the smaller id first, so the
+ * result of comparing them in the other order is found as well.
+ */
+bool Ordering::findCachedComparison(Term* t1, Term* t2, Result& res) const
+{
+  CALL("Ordering::findCachedComparison");
+
+  if(!_comparisonCacheBits || !t1->shared() || !t2->shared()) {
+    return false;
+  }
+  unsigned id1 = t1->getId();
+  unsigned id2 = t2->getId();
+  bool swapped = id1 > id2;
+  if(swapped) {
+    std::swap(id1, id2);
+  }
+  unsigned long long key = (static_cast<unsigned long long>(id1)<<32) | id2;
+  const CachedComparison& entry = _comparisonCache[(key*0x9e3779b97f4a7c15ull)>>(64-_comparisonCacheBits)];
+  if(!entry.result || entry.key!=key) {
+    env.statistics->orderingCacheMisses++;
+    return false;
+  }
+  env.statistics->orderingCacheHits++;
+  res = static_cast<Result>(entry.result);
+  if(swapped) {
+    res = reverse(res);
+  }
+  return true;
+}
+
+/**
+ * Store @b res as the result of comparing shared terms @b t1 and @b t2,
+ * replacing the comparison stored at its position in the cache
+ */
+void Ordering::cacheComparison(Term* t1, Term* t2, Result res) const
+{
+  CALL("Ordering::cacheComparison");
+
+  if(!_comparisonCacheBits || !t1->shared() || !t2->shared()) {
+    return;
+  }
+  unsigned id1 = t1->getId();
+  unsigned id2 = t2->getId();
+  if(id1 > id2) {
+    std::swap(id1, id2);
+    res = reverse(res);
+  }
+  unsigned long long key = (static_cast<unsigned long long>(id1)<<32) | id2;
+  CachedComparison& entry = _comparisonCache[(key*0x9e3779b97f4a7c15ull)>>(64-_comparisonCacheBits)];
+  entry.key = key;
+  entry.result = res;
+}
+
 //////////////////////////////////////////////////
 // PrecedenceOrdering class
 //////////////////////////////////////////////////
@@ -650,6 +725,8 @@ PrecedenceOrdering::PrecedenceOrdering(Problem& prb, const Options& opt)
   CALL("PrecedenceOrdering::PrecedenceOrdering");
   ASS_G(_predicates, 0);
 
+  initComparisonCache(opt.orderingCacheBits());
+
   // Make sure we (re-)compute usageCnt's for all the symbols;
   // in particular, the sP's (the Tseitin predicates) and sK's (the Skolem functions), which only exists since preprocessing.
   prb.getProperty();
@@ -115,6 +115,10 @@ protected:
 
   Result compareEqualities(Literal* eq1, Literal* eq2) const;
 
+  void initComparisonCache(unsigned bits);
+  bool findCachedComparison(Term* t1, Term* t2, Result& res) const;
+  void cacheComparison(Term* t1, Term* t2, Result res) const;
+
 private:
 
   enum ArgumentOrderVals {
@@ -147,6 +151,22 @@ private:
   /** Object used to compare equalities */
   EqCmp* _eqCmp;
 
+  /** An entry of the comparison cache, with @b result 0 if it is empty */
+  struct CachedComparison {
+    /** ids of the compared terms, the smaller one in the upper half */
+    unsigned long long key;
+    unsigned result;
+  };
+  /**
+   * Direct-mapped cache of results of comparisons of shared terms,
+   * keyed by the term ids, which are never reused even when terms are
+   * freed by the term garbage collection. A new result replaces
+   * the one stored at its position.
+   */
+  mutable DArray<CachedComparison> _comparisonCache;
+  /** Number of bits of the positions in @b _comparisonCache, 0 if there is no cache */
+  unsigned _comparisonCacheBits;
+
   /**
    * We store orientation of equalities in this ordering inside
    * the term sharing structure. Setting an ordering to be global
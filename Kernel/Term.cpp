@@ -734,8 +734,6 @@ Literal* Literal::apply(Substitution& subst)
  */
 unsigned Term::hash() const
 {
-  CALL("Term::hash");
-
   unsigned hash = Hash::hash(_functor);
   if (_arity == 0) {
     return hash;
@@ -750,8 +748,6 @@ unsigned Term::hash() const
  */
 unsigned Literal::hash() const
 {
-  CALL("Literal::hash");
-
   unsigned hash = Hash::hash(isPositive() ? (2*_functor) : (2*_functor+1));
   if (_arity == 0) {
     return hash;
@@ -768,8 +764,6 @@ unsigned Literal::hash() const
  */
 unsigned Literal::oppositeHash() const
 {
-  CALL("Literal::hash");
-
   unsigned hash = Hash::hash( (!isPositive()) ? (2*_functor) : (2*_functor+1));
   if (_arity == 0) {
     return hash;
@@ -1352,8 +1346,11 @@ Term::Term(const Term& t) throw()
     _color(COLOR_TRANSPARENT),
     _hasInterpretedConstants(0),
     _isTwoVarEquality(0),
+    _gcMark(0),
+    _gcPinned(0),
     _weight(0),
-    _vars(0)
+    _vars(0),
+    _varMask(0)
 {
   CALL("Term::Term/1");
   ASS(!isSpecial()); //we do not copy special terms
@@ -1381,8 +1378,11 @@ Term::Term() throw()
    _color(COLOR_TRANSPARENT),
    _hasInterpretedConstants(0),
    _isTwoVarEquality(0),
+   _gcMark(0),
+   _gcPinned(0),
    _weight(0),
-   _vars(0)
+   _vars(0),
+   _varMask(0)
 {
   CALL("Term::Term/0");
 
@@ -455,6 +455,26 @@ public:
     return _vars;
   } // vars()
 
+  /** Set the mask of variables */
+  void setVarMask(unsigned mask)
+  {
+    _varMask = mask;
+  }
+
+  /**
+   * Return the mask of variables, where bit i is set iff some variable
+   * whose number is equal to i modulo 32 occurs in the term. Applicable
+   * only to shared terms.
+   */
+  unsigned varMask() const
+  {
+    ASS(shared());
+    return _varMask;
+  }
+
+  /** Return the bit of variable @b var in variable masks */
+  static unsigned varMaskBit(unsigned var) { return 1u<<(var&31); }
+
   /**
    * Return true iff the object is an equality between two variables.
    *
@@ -634,13 +654,17 @@ protected:
   /** The number of this symbol in a signature */
   unsigned _functor;
   /** Arity of the symbol */
-  unsigned _arity : 27;
+  unsigned _arity : 26;
   /** colour, used in interpolation and symbol elimination */
   unsigned _color : 2;
   /** Equal to 1 if the term/literal contains any interpreted constants */
   unsigned _hasInterpretedConstants : 1;
   /** If true, the object is an equality literal between two variables */
   unsigned _isTwoVarEquality : 1;
+  /** Set by the garbage collection of TermSharing on reachable shared terms */
+  unsigned _gcMark : 1;
+  /** If true, the garbage collection of TermSharing keeps the shared term and its subterms */
+  unsigned _gcPinned : 1;
   /** Weight of the symbol */
   unsigned _weight;
   union {
@@ -651,6 +675,8 @@ protected:
      * the sort of the top-level variables */
     unsigned _sort;
   };
+  /** Mask of variables occurring in the term, see @b varMask() */
+  unsigned _varMask;
 
 #if USE_MATCH_TAG && !ARCH_X64
   MatchTag _matchTag;
@@ -829,7 +855,6 @@ public:
    */
   unsigned twoVarEqSort() const
   {
-    CALL("Literal::twoVarEqSort");
     ASS(isTwoVarEquality());
 
     return _sort;
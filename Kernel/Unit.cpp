@@ -266,7 +266,7 @@ bool Unit::derivedFromInput() const
   todo.push(&const_cast<Inference&>(_inference)); 
   while(!todo.isEmpty()){
     Inference* inf = todo.pop();
-    if(inf->rule() == InferenceRule::INPUT){
+    if(inf->rule() == InferenceRule::INPUT || inf->removedPremisesFromInput()){
       return true;
     }
     Inference::Iterator it = inf->iterator();
@@ -101,6 +101,7 @@ size_t Allocator::_tolerated;
 Allocator* Allocator::current;
 Allocator::Page* Allocator::_pages[MAX_PAGES];
 size_t Allocator::_usedMemory = 0;
+size_t Allocator::_freeMemory = 0;
 Allocator* Allocator::_all[MAX_ALLOCATORS];
 
 #if VDEBUG
@@ -382,6 +383,7 @@ void Allocator::deallocateKnown(void* obj,size_t size)
     Known* mem = reinterpret_cast<Known*>(obj);
     mem->next = _freeList[index];
     _freeList[index] = mem;
+    _freeMemory += (index+1)*sizeof(Known);
   }
 
 #if VDEBUG
@@ -459,6 +461,7 @@ void Allocator::deallocateUnknown(void* obj)
     int index = (size-1)/sizeof(Known);
     known->next = _freeList[index];
     _freeList[index] = known;
+    _freeMemory += (index+1)*sizeof(Known);
   }
 
 #if WATCH_ADDRESS
@@ -594,6 +597,7 @@ Allocator::Page* Allocator::allocatePages(size_t size)
   if (_pages[index]) {
     result = _pages[index];
     _pages[index] = result->next;
+    _freeMemory -= realSize;
   }
   else {
     size_t newSize = _usedMemory+realSize;
@@ -734,6 +738,7 @@ void Allocator::deallocatePages(Page* page)
 
   page->next = _pages[index];
   _pages[index] = page;
+  _freeMemory += size;
 
 #if WATCH_ADDRESS
   unsigned addr = (unsigned)(void*)page;
@@ -840,6 +845,7 @@ char* Allocator::allocatePiece(size_t size)
     Known* mem = _freeList[index];
     if (mem) {
       _freeList[index] = mem->next;
+      _freeMemory -= size;
       result = reinterpret_cast<char*>(mem);
     } // There is no available piece in the free list
     else if (_reserveBytesAvailable >= size) { // reserve has enough memory
@@ -865,6 +871,7 @@ char* Allocator::allocatePiece(size_t size)
 #endif
 	save->next = _freeList[index];
 	_freeList[index] = save;
+	_freeMemory += (index+1)*sizeof(Known);
       }
       Page* page = allocatePages(0);
       _reserveBytesAvailable = VPAGE_SIZE-PAGE_PREFIX_SIZE;
@@ -84,6 +84,15 @@ public:
     CALLC("Allocator::getUsedMemory",MAKE_CALLS);
     return _usedMemory;
   }
+  /**
+   * Return the part of the used memory that has been deallocated
+   * and can be reused without allocating more
+   */
+  static size_t getFreeMemory()
+  {
+    CALLC("Allocator::getFreeMemory",MAKE_CALLS);
+    return _freeMemory;
+  }
   /** Return the global memory limit (in bytes) */
   static size_t getMemoryLimit()
   {
@@ -312,6 +321,8 @@ private:
 
   /** Total memory allocated by pages */
   static size_t _usedMemory;
+  /** Memory in the free lists and in the free pages */
+  static size_t _freeMemory;
   /** Page allocator array, a.k.a. "the global manager".
    * Each entry is a (singly linked) list */
   static Page* _pages[MAX_PAGES];
@@ -0,0 +1,577 @@
+
+/*
+ * File ConcurrentSet.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ConcurrentSet.hpp
+ * Defines class ConcurrentSet<Val,Hash> of sets of pointers into which
+ * several threads can insert at the same time.
+ */
+
+#ifndef __ConcurrentSet__
+#define __ConcurrentSet__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+
+#include "Forwards.hpp"
+
+#include "Allocator.hpp"
+#include "Exception.hpp"
+#include "Reflection.hpp"
+
+namespace Lib {
+
+/**
+ * Set of pointers for hash-consing, into which several threads can
+ * insert and in which they can search at the same time.
+ *
+ * The set is a hash table with open addressing and linear probing.
+ * A value is inserted by an atomic compare-and-swap on an empty slot,
+ * so when two threads insert equal values, one of them wins and the
+ * other one gets the value of the winner. Values are removed only by
+ * @b removeIf(), while no other thread uses the set.
+ *
+ * A slot holds the pointer together with the upper half of its hash,
+ * so that probing calls Hash::equals() only on values that are likely
+ * to be equal.
+ *
+ * When the table gets half full, a table of twice the capacity is
+ * allocated, and every insertion then does one step of the resize:
+ * it clears a stripe of slots of the new table, or once the new table
+ * is clear, moves the values of a stripe of the old one there. So no
+ * insertion waits for the whole table to be rehashed. While the values
+ * are being moved, new values go to the new table, and searches go there
+ * when they do not find the value in the old one. A search of the old
+ * table ends at an empty slot, which an insertion marks as moved before
+ * going on to the new table, so no thread still probing the old table
+ * can put an equal value there afterwards. An insertion waits only when
+ * its table gets three quarters full, which happens when the threads
+ * that took resize steps are stalled.
+ *
+ * The old tables are kept until @b releaseRetiredTables() is called or
+ * the set is destroyed, as threads may still be reading them. A set used
+ * by one thread can release them after every insertion, which is what
+ * TermSharing does.
+ *
+ * Neither the methods of this class nor those of @b Hash called by it
+ * may use the CALL macro, which is not thread-safe. The tables are
+ * allocated by ALLOC_KNOWN from the global Allocator, which is not
+ * thread-safe either. Only one thread starts a resize at a time, so
+ * several threads may use the set only when no other thread allocates
+ * meanwhile. TermSharing does not meet this, as the terms and literals
+ * it inserts are allocated by Term::create() and Literal::create(), so
+ * term sharing may be used from one thread only until the allocation
+ * is made thread-safe.
+ *
+ * Hash has to contain methods Hash::hash(Val), Hash::equals(Val,Val),
+ * and for @b find() also Hash::hash(Key) and Hash::equals(Val,Key).
+ */
+template <typename Val,class Hash>
+class ConcurrentSet
+{
+  struct Table;
+
+public:
+  CLASS_NAME(ConcurrentSet);
+  USE_ALLOCATOR(ConcurrentSet);
+
+  ConcurrentSet()
+    : _table(Table::create(initialCapacity)), _retired(0),
+      _resizes(0), _resizeSteps(0), _maxPause(0)
+  {
+    Table* t=_table.load();
+    t->clear(0, t->capacity);
+  }
+
+  ~ConcurrentSet()
+  {
+    completeResize();
+    releaseRetiredTables();
+    Table::destroy(_table.load());
+  }
+
+  /**
+   * Insert @b val into the set, unless the set already contains a value
+   * equal to it. Return the value in the set.
+   */
+  Val insert(Val val)
+  {
+    unsigned code=Hash::hash(val);
+    for(;;) {
+      Table* t=_table.load(std::memory_order_acquire);
+      if(t->resizing.load(std::memory_order_acquire)) {
+        resizeStep(t);
+      }
+      Val res;
+      if(insert(t, val, code, res)) {
+        return res;
+      }
+      //the table is too full until the threads with resize steps do them
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * If the set contains a value equal to @b key, assign it to
+   * @b result and return true, otherwise return false.
+   */
+  template<typename Key>
+  bool find(Key key, Val& result)
+  {
+    unsigned code=Hash::hash(key);
+    for(Table* t=_table.load(std::memory_order_acquire); t; t=t->next.load(std::memory_order_acquire)) {
+      //if the value is not in t, it might have been inserted into the next table
+      size_t mask=t->capacity-1;
+      for(size_t pos=code&mask;;pos=(pos+1)&mask) {
+        size_t cur=t->slots[pos].load(std::memory_order_acquire);
+        if(!cur || cur==moved()) {
+          break;
+        }
+        if(matches(cur, code) && Hash::equals(value(cur),key)) {
+          result=value(cur);
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /** Return the number of values in the set (exact when no thread is inserting) */
+  size_t size() const
+  {
+    Table* t=_table.load(std::memory_order_acquire);
+    size_t res=t->size.load(std::memory_order_relaxed);
+    Table* n=t->next.load(std::memory_order_acquire);
+    if(n) {
+      res+=n->size.load(std::memory_order_relaxed)-t->movedValues.load(std::memory_order_relaxed);
+    }
+    return res;
+  }
+
+  /**
+   * Finish the resize in progress, if there is one
+   *
+   * May be called only when no other thread uses the set.
+   */
+  void completeResize()
+  {
+    for(;;) {
+      Table* t=_table.load();
+      if(!t->resizing.load()) {
+        return;
+      }
+      resizeStep(t);
+    }
+  }
+
+  /**
+   * Deallocate the tables from which values were moved
+   *
+   * May be called only when no other thread uses the set.
+   */
+  void releaseRetiredTables()
+  {
+    while(_retired) {
+      Table* t=_retired;
+      _retired=t->retired;
+      Table::destroy(t);
+    }
+  }
+
+  /**
+   * Remove the values for which @b pred returns true and return their
+   * number. @b pred is called exactly once on every value of the set.
+   *
+   * May be called only when no other thread uses the set. A removed
+   * value is replaced by backward shifting the values of its cluster
+   * that may be there, so no search ends early at the freed slot.
+   */
+  template<class Pred>
+  size_t removeIf(Pred pred)
+  {
+    completeResize();
+    Table* t=_table.load();
+    size_t mask=t->capacity-1;
+    //starting after an empty slot, every value is shifted only over slots still to be visited
+    size_t start=0;
+    while(t->slots[start].load(std::memory_order_relaxed)) {
+      start++;
+    }
+    size_t res=0;
+    for(size_t i=1;i<=t->capacity;i++) {
+      size_t pos=(start+i)&mask;
+      for(;;) {
+        size_t cur=t->slots[pos].load(std::memory_order_relaxed);
+        if(!cur || !pred(value(cur))) {
+          break;
+        }
+        removeAt(t, pos);
+        res++;
+      }
+    }
+    t->size.fetch_sub(res, std::memory_order_relaxed);
+    return res;
+  }
+
+  /** Return the number of times the set was moved to a larger table */
+  unsigned resizes() const { return _resizes.load(std::memory_order_relaxed); }
+  /** Return the number of steps the resizes took */
+  size_t resizeSteps() const { return _resizeSteps.load(std::memory_order_relaxed); }
+  /** Return the longest time in nanoseconds spent on one step of a resize */
+  long long maxPause() const { return _maxPause.load(std::memory_order_relaxed); }
+
+  /**
+   * Iterator over the values of the set
+   *
+   * No thread may use the set while it is being iterated.
+   */
+  class Iterator
+  {
+  public:
+    DECL_ELEMENT_TYPE(Val);
+
+    Iterator(ConcurrentSet& set)
+      : _pos(0)
+    {
+      set.completeResize();
+      _table=set._table.load();
+    }
+
+    bool hasNext()
+    {
+      while(_pos<_table->capacity) {
+        if(_table->slots[_pos].load(std::memory_order_relaxed)) {
+          return true;
+        }
+        _pos++;
+      }
+      return false;
+    }
+
+    Val next()
+    {
+      ALWAYS(hasNext());
+      return value(_table->slots[_pos++].load(std::memory_order_relaxed));
+    }
+
+  private:
+    Table* _table;
+    size_t _pos;
+  };
+
+private:
+  /** Must be a power of two */
+  static const size_t initialCapacity=1024;
+  /** Number of slots cleared or moved in one step of a resize */
+  static const size_t stripeLength=256;
+  /** The bits of a slot from this one up hold the upper half of the hash */
+  static const unsigned tagShift=48;
+
+  /** The mark of an empty slot of a table whose values are being moved */
+  static size_t moved() { return 1; }
+
+  /** Return the content of a slot holding @b val with hash @b code */
+  static size_t slot(Val val, unsigned code)
+  {
+    static_assert(sizeof(size_t)==8, "hashes are stored in the unused bits of 64-bit pointers");
+    size_t ptr=reinterpret_cast<size_t>(val);
+    //the pointers are aligned and do not use the top of the address space;
+    //the latter is not guaranteed by every platform, so it is checked also
+    //in the release build
+    ASS_EQ(ptr&moved(),0);
+    if(ptr>>tagShift) {
+      INVALID_OPERATION("ConcurrentSet: a pointer uses the bits reserved for the hash");
+    }
+    return ptr|(static_cast<size_t>(code>>16)<<tagShift);
+  }
+  /** Return the value held in a slot with content @b slot */
+  static Val value(size_t slot)
+  {
+    return reinterpret_cast<Val>(slot&((static_cast<size_t>(1)<<tagShift)-1));
+  }
+  /** Return true if the slot with content @b slot may hold a value with hash @b code */
+  static bool matches(size_t slot, unsigned code)
+  {
+    return (slot>>tagShift)==(code>>16);
+  }
+
+  static long long now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  struct Table
+  {
+    /** The number of slots, always a power of two */
+    size_t capacity;
+    /** The number of values in the table */
+    std::atomic<size_t> size;
+    /** True once a thread started the resize of this table */
+    std::atomic<bool> resizing;
+    /** The table the values will be moved to, or zero before it is allocated */
+    std::atomic<Table*> pending;
+    /** The first stripe of @b pending no thread has started to clear */
+    std::atomic<size_t> nextClearedStripe;
+    /** Number of stripes of @b pending cleared */
+    std::atomic<size_t> clearedStripes;
+    /** The table the values are being moved to, or zero before it is clear */
+    std::atomic<Table*> next;
+    /** The first stripe no thread has started to move */
+    std::atomic<size_t> nextMovedStripe;
+    /** Number of stripes moved */
+    std::atomic<size_t> movedStripes;
+    /** Number of values moved */
+    std::atomic<size_t> movedValues;
+    /** The table retired before this one, once this one is retired */
+    Table* retired;
+    /**
+     * The slots, zero means empty; the array continues past the structure
+     * and holds garbage until it is cleared
+     */
+    std::atomic<size_t> slots[1];
+
+    size_t stripeCnt() const { return (capacity+stripeLength-1)/stripeLength; }
+
+    static size_t byteSize(size_t capacity)
+    {
+      return sizeof(Table)+(capacity-1)*sizeof(std::atomic<size_t>);
+    }
+
+    /** Allocate a table without clearing its slots */
+    static Table* create(size_t capacity)
+    {
+      void* mem=ALLOC_KNOWN(byteSize(capacity),"ConcurrentSet::Table");
+      Table* res=static_cast<Table*>(mem);
+      res->capacity=capacity;
+      new(&res->size) std::atomic<size_t>(0);
+      new(&res->resizing) std::atomic<bool>(false);
+      new(&res->pending) std::atomic<Table*>(0);
+      new(&res->nextClearedStripe) std::atomic<size_t>(0);
+      new(&res->clearedStripes) std::atomic<size_t>(0);
+      new(&res->next) std::atomic<Table*>(0);
+      new(&res->nextMovedStripe) std::atomic<size_t>(0);
+      new(&res->movedStripes) std::atomic<size_t>(0);
+      new(&res->movedValues) std::atomic<size_t>(0);
+      res->retired=0;
+      return res;
+    }
+
+    /** Make the slots from @b start up to @b end empty */
+    void clear(size_t start, size_t end)
+    {
+      for(size_t i=start;i<end;i++) {
+        new(&slots[i]) std::atomic<size_t>(0);
+      }
+    }
+
+    static void destroy(Table* t)
+    {
+      DEALLOC_KNOWN(t,byteSize(t->capacity),"ConcurrentSet::Table");
+    }
+  };
+
+  /**
+   * Insert @b val with hash @b code into @b t or the table it is being
+   * moved to, and assign the value in the set to @b res. Return false if
+   * the value belongs to a table too full to insert into.
+   */
+  bool insert(Table* t, Val val, unsigned code, Val& res)
+  {
+    //the values in t that will be moved to the table we insert into
+    size_t toMove=0;
+    for(;;) {
+      Table* n=t->next.load(std::memory_order_acquire);
+      size_t mask=t->capacity-1;
+      for(size_t pos=code&mask;;pos=(pos+1)&mask) {
+        size_t cur=t->slots[pos].load(std::memory_order_acquire);
+        if(!cur) {
+          if(!n) {
+            //while threads are stalled in resize steps, the others must not fill the table
+            if(4*(t->size.load(std::memory_order_relaxed)+toMove)>=3*t->capacity) {
+              startResize(t);
+              return false;
+            }
+            if(t->slots[pos].compare_exchange_strong(cur, slot(val,code), std::memory_order_acq_rel, std::memory_order_acquire)) {
+              if(2*(t->size.fetch_add(1, std::memory_order_relaxed)+1)>t->capacity) {
+                startResize(t);
+              }
+              res=val;
+              return true;
+            }
+          }
+          //mark the end of the search, so that no equal value can get here
+          else if(t->slots[pos].compare_exchange_strong(cur, moved(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+            cur=moved();
+          }
+          //otherwise cur is what got into the slot first
+        }
+        if(cur==moved()) {
+          break;
+        }
+        if(matches(cur, code) && Hash::equals(value(cur),val)) {
+          res=value(cur);
+          return true;
+        }
+      }
+      //the value is not in t, so it belongs to the next table
+      toMove=t->size.load(std::memory_order_relaxed)-t->movedValues.load(std::memory_order_relaxed);
+      t=t->next.load(std::memory_order_acquire);
+      ASS(t);
+    }
+  }
+
+  /**
+   * Allocate the table into which the values of @b t will be moved,
+   * unless another thread is doing that or @b t is not the table in
+   * use yet
+   *
+   * So a resize starts only after the previous one is complete, and
+   * only one table is being retired at a time.
+   */
+  void startResize(Table* t)
+  {
+    if(_table.load(std::memory_order_acquire)!=t) {
+      return;
+    }
+    bool expected=false;
+    if(!t->resizing.compare_exchange_strong(expected, true)) {
+      return;
+    }
+    long long start=now();
+    t->pending.store(Table::create(2*t->capacity), std::memory_order_release);
+    _resizes.fetch_add(1, std::memory_order_relaxed);
+    recordStep(now()-start);
+  }
+
+  /**
+   * Clear a stripe of the table into which the values of @b t will be
+   * moved, or once it is clear, move a stripe of the values of @b t there,
+   * unless other threads have taken all the stripes
+   */
+  void resizeStep(Table* t)
+  {
+    Table* p=t->pending.load(std::memory_order_acquire);
+    if(!p) {
+      //the thread that started the resize is allocating the table
+      return;
+    }
+    if(!t->next.load(std::memory_order_acquire)) {
+      size_t stripeCnt=p->stripeCnt();
+      size_t stripe=t->nextClearedStripe.fetch_add(1);
+      if(stripe>=stripeCnt) {
+        return;
+      }
+      long long start=now();
+      p->clear(stripe*stripeLength, std::min((stripe+1)*stripeLength, p->capacity));
+      if(t->clearedStripes.fetch_add(1)+1==stripeCnt) {
+        //from now on the values go to the new table
+        t->next.store(p, std::memory_order_release);
+      }
+      recordStep(now()-start);
+    }
+    else {
+      size_t stripeCnt=t->stripeCnt();
+      size_t stripe=t->nextMovedStripe.fetch_add(1);
+      if(stripe>=stripeCnt) {
+        return;
+      }
+      long long start=now();
+      moveStripe(t, p, stripe);
+      if(t->movedStripes.fetch_add(1)+1==stripeCnt) {
+        //the last stripe was moved, so the new table can be used alone
+        t->retired=_retired;
+        _retired=t;
+        _table.store(p, std::memory_order_release);
+      }
+      recordStep(now()-start);
+    }
+  }
+
+  /** Move the values of stripe number @b stripe of @b t to @b n */
+  void moveStripe(Table* t, Table* n, size_t stripe)
+  {
+    size_t end=std::min((stripe+1)*stripeLength, t->capacity);
+    size_t mask=n->capacity-1;
+    size_t cnt=0;
+    for(size_t i=stripe*stripeLength;i<end;i++) {
+      size_t cur=0;
+      if(t->slots[i].compare_exchange_strong(cur, moved(), std::memory_order_acq_rel, std::memory_order_acquire) ||
+          cur==moved()) {
+        continue;
+      }
+      //no thread puts a value equal to this one into n, as they find it in t
+      for(size_t pos=Hash::hash(value(cur))&mask;;pos=(pos+1)&mask) {
+        size_t empty=0;
+        if(n->slots[pos].compare_exchange_strong(empty, cur, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+          break;
+        }
+      }
+      cnt++;
+    }
+    n->size.fetch_add(cnt, std::memory_order_relaxed);
+    t->movedValues.fetch_add(cnt, std::memory_order_relaxed);
+  }
+
+  /**
+   * Empty the slot @b hole of @b t, moving into it the first value of
+   * the rest of its cluster whose probing passes it, and so on
+   */
+  static void removeAt(Table* t, size_t hole)
+  {
+    size_t mask=t->capacity-1;
+    for(size_t pos=(hole+1)&mask;;pos=(pos+1)&mask) {
+      size_t cur=t->slots[pos].load(std::memory_order_relaxed);
+      if(!cur) {
+        break;
+      }
+      size_t home=Hash::hash(value(cur))&mask;
+      //the value can go to the hole unless its probing starts after the hole
+      if(((pos-home)&mask)>=((pos-hole)&mask)) {
+        t->slots[hole].store(cur, std::memory_order_relaxed);
+        hole=pos;
+      }
+    }
+    t->slots[hole].store(0, std::memory_order_relaxed);
+  }
+
+  void recordStep(long long pause)
+  {
+    _resizeSteps.fetch_add(1, std::memory_order_relaxed);
+    long long max=_maxPause.load(std::memory_order_relaxed);
+    while(pause>max && !_maxPause.compare_exchange_weak(max, pause, std::memory_order_relaxed)) {}
+  }
+
+  /** The table in use, whose values may be being moved to the next one */
+  std::atomic<Table*> _table;
+  /** The list of the tables the values were moved from, linked by Table::retired */
+  Table* _retired;
+  /** Number of resizes started */
+  std::atomic<unsigned> _resizes;
+  /** Number of resize steps done */
+  std::atomic<size_t> _resizeSteps;
+  /** The longest time in nanoseconds a resize step took */
+  std::atomic<long long> _maxPause;
+};
+
+}
+
+#endif /* __ConcurrentSet__ */
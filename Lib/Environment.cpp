@@ -54,6 +54,7 @@ Environment::Environment()
   : signature(0),
     sharing(0),
     property(0),
+    timer(0),
     maxSineLevel(1),
     predicateSineLevels(nullptr),
     colorUsed(false),
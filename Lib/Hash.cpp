@@ -68,7 +68,6 @@ unsigned Hash::hash (const char* val)
  */
 unsigned Hash::hash (const unsigned char* val,size_t size)
 {
-  CALL("Hash::hash/1");
   ASS(size > 0);
 
   unsigned hash = 2166136261u;
@@ -88,7 +87,6 @@ unsigned Hash::hash (const unsigned char* val,size_t size)
  */
 unsigned Hash::hash (const unsigned char* val,size_t size,unsigned hash)
 {
-  CALL("Hash::hash/0");
   ASS(size > 0);
 
   for (int i = size-1;i >= 0;i--) {
@@ -261,6 +261,9 @@ void TimeCounter::outputSingleStat(TimeCounterUnit tcu, ostream& out)
   case TC_BACKWARD_SUBSUMPTION_INDEX_MAINTENANCE:
     out<<"backward subsumption index maintenance";
     break;
+  case TC_FEATURE_VECTOR_INDEX_MAINTENANCE:
+    out<<"feature vector index maintenance";
+    break;
   case TC_BACKWARD_SUPERPOSITION_INDEX_MAINTENANCE:
     out<<"backward superposition index maintenance";
     break;
@@ -55,6 +55,7 @@ enum TimeCounterUnit
   TC_FORWARD_SUBSUMPTION_DEMODULATION_INDEX_MAINTENANCE,
   TC_BINARY_RESOLUTION_INDEX_MAINTENANCE,
   TC_BACKWARD_SUBSUMPTION_INDEX_MAINTENANCE,
+  TC_FEATURE_VECTOR_INDEX_MAINTENANCE,
   TC_BACKWARD_SUPERPOSITION_INDEX_MAINTENANCE,
   TC_FORWARD_SUPERPOSITION_INDEX_MAINTENANCE,
   TC_BACKWARD_DEMODULATION_INDEX_MAINTENANCE,
@@ -113,7 +113,9 @@ timer_sigalrm_handler (int sig)
 
   timer_sigalrm_counter++;
 
-  if(Timer::s_timeLimitEnforcement && env.timeLimitReached()) {
+  //the first ticks can come before the Environment constructor sets
+  //env.timer, which happens only after the timer has been initialized
+  if(Timer::s_timeLimitEnforcement && env.timer && env.timeLimitReached()) {
     timeLimitReached();
   }
 
@@ -233,6 +233,82 @@ void AWPassiveClauseContainer::remove(Clause* cl)
   }
 }
 
+ClauseIterator AWPassiveClauseContainer::iterator()
+{
+  CALL("AWPassiveClauseContainer::iterator");
+
+  //both queues contain the same clauses unless one of the ratios is zero
+  if (_weightRatio) {
+    return pvi( ClauseQueue::Iterator(_weightQueue) );
+  }
+  return pvi( ClauseQueue::Iterator(_ageQueue) );
+}
+
+/**
+ * Return true if the clause would precede the head of the weight queue
+ * or of the age queue, so that it might be the next one selected. As in fulfilsWeightLimit(unsigned, unsigned, const Inference&),
+ * the numeral weight and the split weight are assumed to be 0.
+ */
+bool AWPassiveClauseContainer::mayBeSelectedBefore(unsigned w, const Inference& inference)
+{
+  CALL("AWPassiveClauseContainer::mayBeSelectedBefore");
+
+  if (_weightRatio) {
+    if (_weightQueue.isEmpty()) {
+      return true;
+    }
+    Clause* head = ClauseQueue::Iterator(_weightQueue).next();
+    unsigned weightForClauseSelection = Clause::computeWeightForClauseSelection(w, 0, 0, inference.derivedFromGoal(), _opt);
+    if (weightForClauseSelection < head->weightForClauseSelection(_opt)) {
+      return true;
+    }
+  }
+  if (_ageRatio) {
+    if (_ageQueue.isEmpty()) {
+      return true;
+    }
+    Clause* head = ClauseQueue::Iterator(_ageQueue).next();
+    if (inference.age() < head->age()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Remove up to @b cnt clauses from the end of the weight queue.
+ */
+unsigned AWPassiveClauseContainer::evictHeaviest(unsigned cnt)
+{
+  CALL("AWPassiveClauseContainer::evictHeaviest");
+
+  if (!_isOutermost || !_weightRatio || !cnt) {
+    return 0;
+  }
+  if (cnt > _size) {
+    cnt = _size;
+  }
+
+  static Stack<Clause*> toRemove(256);
+  unsigned skip = _size - cnt;
+  ClauseQueue::Iterator wit(_weightQueue);
+  while (wit.hasNext()) {
+    Clause* cl=wit.next();
+    if (skip) {
+      skip--;
+      continue;
+    }
+    toRemove.push(cl);
+  }
+
+  unsigned removed = toRemove.size();
+  while (toRemove.isNonEmpty()) {
+    env.statistics->discardedNonRedundantClauses++;
+    remove(toRemove.pop());
+  }
+  return removed;
+}
+
 bool AWPassiveClauseContainer::byWeight(int balance)
 {
   CALL("AWPassiveClauseContainer::byWeight");
@@ -289,10 +365,12 @@ Clause* AWPassiveClauseContainer::popSelected()
    }
   }
   //std::cerr << _ageRatio << "\t" << _weightRatio << std::endl;
+  bool selectByWeight = byWeight(_balance);
+  prepareSelection(selectByWeight);
   _size--;
 
   Clause* cl;
-  if (byWeight(_balance)) {
+  if (selectByWeight) {
     _balance -= _ageRatio;
     cl = _weightQueue.pop();
     _ageQueue.remove(cl);
@@ -92,9 +92,21 @@ public:
 
   unsigned sizeEstimate() const override { return _size; }
 
+  ClauseIterator iterator() override;
+
+  bool mayBeSelectedBefore(unsigned w, const Inference& inference) override;
+  unsigned evictHeaviest(unsigned cnt) override;
+
   static Comparison compareWeight(Clause* cl1, Clause* cl2, const Shell::Options& opt);
 
-private:
+protected:
+  /**
+   * Called by @b popSelected() once it is decided whether the next
+   * clause is taken from the weight queue (@b byWeight is true) or
+   * from the age queue, just before the clause is popped.
+   */
+  virtual void prepareSelection(bool byWeight) {}
+
   /** The age queue, empty if _ageRatio=0 */
   AgeQueue _ageQueue;
   /** The weight queue, empty if _weightRatio=0 */
@@ -142,6 +142,32 @@ public:
 
   virtual unsigned sizeEstimate() const = 0;
 
+  /**
+   * Iterate over the clauses in the container. A clause may
+   * be returned more than once by containers that keep clauses
+   * in several sub-queues. The container must not be modified
+   * while the iterator is in use.
+   *
+   * The literals of clauses spilled to disk by
+   * SpillingPassiveClauseContainer are 0, so the callers may only use
+   * the clause objects and their inferences, or must skip the 0 literals.
+   */
+  virtual ClauseIterator iterator() = 0;
+
+  /**
+   * Return true if a clause of weight @b w (as returned by weight())
+   * derived by @b inference might be selected before the clause that
+   * would be selected next. Containers that cannot tell return true.
+   */
+  virtual bool mayBeSelectedBefore(unsigned w, const Inference& inference) { return true; }
+
+  /**
+   * Remove up to @b cnt clauses that would be selected last by weight
+   * and return the number of removed clauses. Used to free memory,
+   * the removed clauses are lost for the proof search.
+   */
+  virtual unsigned evictHeaviest(unsigned cnt) { return 0; }
+
   /*
    * LRS specific methods for computation of Limits
    */
@@ -0,0 +1,76 @@
+/*
+ * File ClauseRecipe.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file ClauseRecipe.hpp
+ * Defines class ClauseRecipe.
+ */
+
+#ifndef __ClauseRecipe__
+#define __ClauseRecipe__
+
+#include "Forwards.hpp"
+
+#include "Kernel/Inference.hpp"
+
+namespace Saturation {
+
+using namespace Kernel;
+
+/**
+ * A generated clause that has not been built yet.
+ *
+ * With the lazy_clause_materialization option, generating inferences
+ * store their premises and the place of the inference instead of the
+ * conclusion. Only the age (given by the inference) and an estimate of
+ * the weight are known before the clause is built by @b materialize(),
+ * which is done when the clause could be selected from passive, see
+ * SaturationAlgorithm::materializeRecipes().
+ */
+class ClauseRecipe
+{
+public:
+  CLASS_NAME(ClauseRecipe);
+  USE_ALLOCATOR(ClauseRecipe);
+
+  /**
+   * Create a recipe with estimated weight @b weight.
+   * The recipe takes over the inference object @b inf.
+   */
+  ClauseRecipe(const Inference& inf, unsigned weight)
+  : _inference(inf), _weight(weight) {}
+  virtual ~ClauseRecipe() { _inference.destroy(); }
+
+  /**
+   * Perform the inference in full and return its conclusion,
+   * or 0 if it turns out that the inference cannot be done.
+   * Can be called only when all premises are active.
+   */
+  virtual Clause* materialize() = 0;
+
+  const Inference& inference() const { return _inference; }
+  /** Estimated weight of the conclusion, see Clause::weight() */
+  unsigned weight() const { return _weight; }
+
+protected:
+  Inference _inference;
+  unsigned _weight;
+};
+
+};
+
+#endif /* __ClauseRecipe__ */
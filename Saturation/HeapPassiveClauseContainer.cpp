@@ -0,0 +1,174 @@
+/*
+ * File HeapPassiveClauseContainer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file HeapPassiveClauseContainer.cpp
+ * Implements class HeapPassiveClauseContainer.
+ */
+
+#include <climits>
+
+#include "Lib/Environment.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "HeapPassiveClauseContainer.hpp"
+
+namespace Saturation
+{
+using namespace Lib;
+using namespace Kernel;
+
+HeapPassiveClauseContainer::HeapPassiveClauseContainer(bool isOutermost, const Shell::Options& opt, vstring name)
+  : PassiveClauseContainer(isOutermost, opt, name),
+    _ageRatio(opt.ageRatio()), _weightRatio(opt.weightRatio()), _balance(0)
+{
+  CALL("HeapPassiveClauseContainer::HeapPassiveClauseContainer");
+  ASS_GE(_ageRatio, 0);
+  ASS_GE(_weightRatio, 0);
+  ASS(_ageRatio > 0 || _weightRatio > 0);
+}
+
+HeapPassiveClauseContainer::~HeapPassiveClauseContainer()
+{
+  ClauseIterator cit = iterator();
+  while (cit.hasNext()) {
+    Clause* cl=cit.next();
+    ASS(!_isOutermost || cl->store()==Clause::PASSIVE);
+    cl->setStore(Clause::NONE);
+  }
+}
+
+void HeapPassiveClauseContainer::add(Clause* cl)
+{
+  CALL("HeapPassiveClauseContainer::add");
+  ASS(cl->store() == Clause::PASSIVE);
+
+  unsigned weight = cl->weightForClauseSelection(_opt);
+  //larger input types go first, see WeightQueue::lessThan
+  unsigned inputRank = UINT_MAX - static_cast<unsigned>(cl->inputType());
+
+  if (_ageRatio) {
+    _ageHeap.insert(cl, ClauseHeap::Key(cl->age(), weight, inputRank, cl->number()));
+  }
+  if (_weightRatio) {
+    _weightHeap.insert(cl, ClauseHeap::Key(weight, cl->age(), inputRank, cl->number()));
+  }
+
+  if (_isOutermost) {
+    addedEvent.fire(cl);
+  }
+}
+
+/**
+ * Remove Clause from the Passive store. Should be called only
+ * when the Clause is no longer needed by the inference process
+ * (i.e. was backward subsumed/simplified), as it can result in
+ * deletion of the clause.
+ */
+void HeapPassiveClauseContainer::remove(Clause* cl)
+{
+  CALL("HeapPassiveClauseContainer::remove");
+  if (_isOutermost) {
+    ASS(cl->store()==Clause::PASSIVE);
+  }
+
+  _ageHeap.remove(cl);
+  _weightHeap.remove(cl);
+
+  if (_isOutermost) {
+    removedEvent.fire(cl);
+    ASS(cl->store()!=Clause::PASSIVE);
+  }
+}
+
+ClauseIterator HeapPassiveClauseContainer::iterator()
+{
+  CALL("HeapPassiveClauseContainer::iterator");
+
+  //both heaps contain the same clauses unless one of the ratios is zero
+  return _weightRatio ? _weightHeap.iterator() : _ageHeap.iterator();
+}
+
+/**
+ * Return true if the clause would precede the top of the weight heap
+ * or of the age heap, see AWPassiveClauseContainer::mayBeSelectedBefore().
+ */
+bool HeapPassiveClauseContainer::mayBeSelectedBefore(unsigned w, const Inference& inference)
+{
+  CALL("HeapPassiveClauseContainer::mayBeSelectedBefore");
+
+  if (_weightRatio) {
+    if (_weightHeap.isEmpty()) {
+      return true;
+    }
+    unsigned weightForClauseSelection = Clause::computeWeightForClauseSelection(w, 0, 0, inference.derivedFromGoal(), _opt);
+    if (weightForClauseSelection < _weightHeap.topKey().primary) {
+      return true;
+    }
+  }
+  if (_ageRatio) {
+    if (_ageHeap.isEmpty()) {
+      return true;
+    }
+    if (inference.age() < _ageHeap.topKey().primary) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool HeapPassiveClauseContainer::byWeight() const
+{
+  if (! _ageRatio) {
+    return true;
+  }
+  if (! _weightRatio) {
+    return false;
+  }
+  if (_balance != 0) {
+    return _balance > 0;
+  }
+  return _ageRatio <= _weightRatio;
+}
+
+/**
+ * Return the next selected clause and remove it from the container.
+ */
+Clause* HeapPassiveClauseContainer::popSelected()
+{
+  CALL("HeapPassiveClauseContainer::popSelected");
+  ASS( ! isEmpty());
+
+  Clause* cl;
+  if (byWeight()) {
+    _balance -= _ageRatio;
+    cl = _weightHeap.pop();
+    _ageHeap.remove(cl);
+  } else {
+    _balance += _weightRatio;
+    cl = _ageHeap.pop();
+    _weightHeap.remove(cl);
+  }
+
+  if (_isOutermost) {
+    selectedEvent.fire(cl);
+  }
+  return cl;
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * File HeapPassiveClauseContainer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file HeapPassiveClauseContainer.hpp
+ * Defines the class HeapPassiveClauseContainer
+ */
+
+#ifndef __HeapPassiveClauseContainer__
+#define __HeapPassiveClauseContainer__
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/ClauseHeap.hpp"
+#include "ClauseContainer.hpp"
+
+#include "Lib/Allocator.hpp"
+
+namespace Saturation {
+
+using namespace Kernel;
+
+/**
+ * Age-weight passive container with the age and weight queues kept
+ * in ClauseHeap objects instead of skip lists.
+ *
+ * Clauses are selected in the same order as by the
+ * AWPassiveClauseContainer with a constant age-weight ratio shape.
+ * The container does not compute LRS limits.
+ */
+class HeapPassiveClauseContainer
+: public PassiveClauseContainer
+{
+public:
+  CLASS_NAME(HeapPassiveClauseContainer);
+  USE_ALLOCATOR(HeapPassiveClauseContainer);
+
+  HeapPassiveClauseContainer(bool isOutermost, const Shell::Options& opt, vstring name);
+  ~HeapPassiveClauseContainer();
+
+  void add(Clause* cl) override;
+  void remove(Clause* cl) override;
+  Clause* popSelected() override;
+
+  /** True if there are no passive clauses */
+  bool isEmpty() const override
+  { return _ageHeap.isEmpty() && _weightHeap.isEmpty(); }
+
+  unsigned sizeEstimate() const override
+  { return _weightRatio ? _weightHeap.size() : _ageHeap.size(); }
+
+  ClauseIterator iterator() override;
+
+  bool mayBeSelectedBefore(unsigned w, const Inference& inference) override;
+
+private:
+  bool byWeight() const;
+
+  /** Clauses ordered as by the AgeQueue, empty if _ageRatio=0 */
+  ClauseHeap _ageHeap;
+  /** Clauses ordered as by the WeightQueue, empty if _weightRatio=0 */
+  ClauseHeap _weightHeap;
+  /** the age ratio */
+  int _ageRatio;
+  /** the weight ratio */
+  int _weightRatio;
+  /** current balance. If &lt;0 then selection by age, if &gt;0
+   * then by weight */
+  int _balance;
+
+  /*
+   * LRS specific methods for computation of Limits
+   */
+public:
+  void simulationInit() override {}
+  bool simulationHasNext() override { return false; }
+  void simulationPopSelected() override {}
+
+  // returns whether at least one of the limits was tightened
+  bool setLimitsToMax() override { return false; }
+  // returns whether at least one of the limits was tightened
+  bool setLimitsFromSimulation() override { return false; }
+
+  void onLimitsUpdated() override {}
+
+  /*
+   * LRS specific methods and fields for usage of limits
+   */
+  bool ageLimited() const override { return false; }
+  bool weightLimited() const override { return false; }
+
+  bool fulfilsAgeLimit(Clause* c) const override { return true; }
+  bool fulfilsAgeLimit(unsigned w, unsigned numPositiveLiterals, const Inference& inference) const override { return true; }
+  bool fulfilsWeightLimit(Clause* cl) const override { return true; }
+  bool fulfilsWeightLimit(unsigned w, unsigned numPositiveLiterals, const Inference& inference) const override { return true; }
+
+  bool childrenPotentiallyFulfilLimits(Clause* cl, unsigned upperBoundNumSelLits) const override { return true; }
+}; // class HeapPassiveClauseContainer
+
+};
+
+#endif /* __HeapPassiveClauseContainer__ */
@@ -21,6 +21,9 @@
  * Implements class LRS.
  */
 
+#include <cmath>
+
+#include "Lib/Allocator.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Timer.hpp"
 #include "Lib/TimeCounter.hpp"
@@ -60,6 +63,10 @@ void LRS::onUnprocessedSelected(Clause* c)
 
   SaturationAlgorithm::onUnprocessedSelected(c);
 
+  if(_activationStart>=0) {
+    finishGenerationTiming();
+  }
+
   if(shouldUpdateLimits()) {
     TimeCounter tc(TC_LRS_LIMIT_MAINTENANCE);
 
@@ -73,6 +80,33 @@ void LRS::onUnprocessedSelected(Clause* c)
   }
 }
 
+bool LRS::handleClauseBeforeActivation(Clause* c)
+{
+  CALL("LRS::handleClauseBeforeActivation");
+
+  if(_opt.lrsEstimator()==Options::LrsEstimator::THROUGHPUT) {
+    finishGenerationTiming();
+    _activationStart=env.timer->elapsedMilliseconds();
+  }
+  return SaturationAlgorithm::handleClauseBeforeActivation(c);
+}
+
+/**
+ * Stop measuring the time of the current activation
+ *
+ * The activation is considered finished when the first generated clause
+ * is selected from unprocessed, or when the next activation starts.
+ */
+void LRS::finishGenerationTiming()
+{
+  CALL("LRS::finishGenerationTiming");
+
+  if(_activationStart>=0) {
+    _generationTime+=env.timer->elapsedMilliseconds()-_activationStart;
+    _activationStart=-1;
+  }
+}
+
 /**
  * Return true if it is time to update age and weight
  * limits of the LRS strategy
@@ -132,6 +166,10 @@ long long LRS::estimatedReachableCount()
   } else {
     timeLeft=_opt.timeLimitInDeciseconds()*100 - currTime;
   }
+  if(_opt.lrsEstimator()==Options::LrsEstimator::THROUGHPUT) {
+    result = throughputReachableCount(timeLeft);
+    goto finish;
+  }
   if(timeLeft<=0 || processed<=10) {
     //we end-up here even if there is no time limit (i.e. time limit is set to 0)
     result = -1;
@@ -150,4 +188,89 @@ long long LRS::estimatedReachableCount()
   return result;
 }
 
+/**
+ * Return an estimate of the number of clauses that can be activated
+ * in the remaining time @b timeLeft and memory, or -1 if there is
+ * no estimate yet.
+ *
+ * The run is measured in windows of at least 10 activations and 100
+ * milliseconds, each ending at a call of this function. A window gives
+ * the time per activation spent in generating inferences and in the
+ * rest (mostly simplification of the generated clauses) and the memory
+ * per activation. The values are smoothed over the windows.
+ *
+ * The simplification time per activation usually grows with the size
+ * of the indexes. Its growth is estimated from the difference between
+ * the recent and the average simplification time per activation, and
+ * the count @b n is taken such that n activations with linearly
+ * increasing cost fit into @b timeLeft. The result is at most the number
+ * of activations the remaining memory is estimated to allow.
+ */
+long long LRS::throughputReachableCount(long long timeLeft)
+{
+  CALL("LRS::throughputReachableCount");
+
+  finishGenerationTiming();
+
+  int currTime=env.timer->elapsedMilliseconds();
+  long long activations=env.statistics->activeClauses;
+  size_t usedMemory=Allocator::getUsedMemory();
+
+  long long windowActivations=activations-_windowActivations;
+  long long windowTime=currTime-_windowTime;
+  if(windowActivations>=10 && windowTime>=100) {
+    long long windowGenerationTime=_generationTime-_windowGenerationTime;
+    double generationCost=static_cast<double>(windowGenerationTime)/windowActivations;
+    double simplificationCost=static_cast<double>(max(windowTime-windowGenerationTime,0LL))/windowActivations;
+    double memoryCost=(static_cast<double>(usedMemory)-static_cast<double>(_windowMemory))/windowActivations;
+
+    if(_haveCosts) {
+      _generationCost=(_generationCost+generationCost)/2;
+      _simplificationCost=(_simplificationCost+simplificationCost)/2;
+      _memoryCost=(_memoryCost+memoryCost)/2;
+    } else {
+      _generationCost=generationCost;
+      _simplificationCost=simplificationCost;
+      _memoryCost=memoryCost;
+      _haveCosts=true;
+    }
+    //if the simplification cost grew linearly since the start, its average
+    //over the whole run is the cost in the middle of the run
+    long long totalSimplificationTime=max(currTime-_startTime-_generationTime,0LL);
+    double averageSimplificationCost=static_cast<double>(totalSimplificationTime)/activations;
+    _simplificationGrowth=max(_simplificationCost-averageSimplificationCost,0.0)*2/activations;
+
+    _windowTime=currTime;
+    _windowActivations=activations;
+    _windowGenerationTime=_generationTime;
+    _windowMemory=usedMemory;
+  }
+  if(!_haveCosts) {
+    return -1;
+  }
+
+  long long result=-1;
+  if(timeLeft>0) {
+    //at least one millisecond per 1000 activations, so that the result is finite
+    double cost=max(_generationCost+_simplificationCost,0.001);
+    double reachable;
+    if(_simplificationGrowth>0) {
+      //solve cost*n + growth*n*n/2 = timeLeft
+      reachable=(sqrt(cost*cost+2*_simplificationGrowth*timeLeft)-cost)/_simplificationGrowth;
+    } else {
+      reachable=timeLeft/cost;
+    }
+    result=static_cast<long long>(reachable);
+  }
+
+  size_t memoryLimit=Allocator::getMemoryLimit();
+  if(_memoryCost>0 && memoryLimit>usedMemory) {
+    long long memoryReachable=static_cast<long long>((memoryLimit-usedMemory)/_memoryCost);
+    if(result<0 || memoryReachable<result) {
+      result=memoryReachable;
+    }
+  }
+  return result;
+}
+
 }
@@ -43,7 +43,11 @@ public:
   USE_ALLOCATOR(LRS);
 
   LRS(Problem& prb, const Options& opt)
-  : Otter(prb, opt), _limitsEverActive(false) {}
+  : Otter(prb, opt), _limitsEverActive(false),
+    _activationStart(-1), _generationTime(0),
+    _windowTime(0), _windowActivations(0), _windowGenerationTime(0), _windowMemory(0),
+    _haveCosts(false),
+    _generationCost(0), _simplificationCost(0), _simplificationGrowth(0), _memoryCost(0) {}
 
 
 protected:
@@ -54,11 +58,42 @@ protected:
   //overrides SaturationAlgorithm::onUnprocessedSelected
   void onUnprocessedSelected(Clause* c);
 
+  //overrides SaturationAlgorithm::handleClauseBeforeActivation
+  bool handleClauseBeforeActivation(Clause* c);
+
   bool shouldUpdateLimits();
 
   long long estimatedReachableCount();
+  long long throughputReachableCount(long long timeLeft);
+  void finishGenerationTiming();
 
   bool _limitsEverActive;
+
+  /*
+   * Fields of the throughput estimator, see throughputReachableCount()
+   */
+  /** Time at which the current activation started, -1 if not measuring */
+  int _activationStart;
+  /** Milliseconds spent in activations, i.e. in generating inferences */
+  long long _generationTime;
+
+  /** Time, activation count, generation time and used memory at the start of the current window */
+  int _windowTime;
+  long long _windowActivations;
+  long long _windowGenerationTime;
+  size_t _windowMemory;
+
+  /** True if at least one window was measured */
+  bool _haveCosts;
+
+  /** Smoothed milliseconds per activation spent in generating inferences */
+  double _generationCost;
+  /** Smoothed milliseconds per activation spent in the rest, mostly simplification */
+  double _simplificationCost;
+  /** Smoothed increase of @b _simplificationCost per activation */
+  double _simplificationGrowth;
+  /** Smoothed increase of the used memory per activation in bytes */
+  double _memoryCost;
 };
 
 };
@@ -48,6 +48,12 @@ private:
   const std::vector<Clause*>::const_iterator end;
 };
 
+ClauseIterator ManCSPassiveClauseContainer::iterator()
+{
+  CALL("ManCSPassiveClauseContainer::iterator");
+  return ClauseIterator(new VectorIteratorWrapper(clauses));
+}
+
 void ManCSPassiveClauseContainer::add(Clause* cl)
 {
   CALL("ManCSPassiveClauseContainer::add");
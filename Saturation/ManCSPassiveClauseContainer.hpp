@@ -47,6 +47,7 @@ public:
   
   unsigned sizeEstimate() const override;
   bool isEmpty() const override;
+  ClauseIterator iterator() override;
   void add(Clause* cl) override;
   void remove(Clause* cl) override;
   Clause* popSelected() override;
@@ -27,6 +27,7 @@
 #include "Shell/Options.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/Inference.hpp"
+#include "Lib/Metaiterators.hpp"
 #include "Lib/SharedSet.hpp"
 
 namespace Saturation
@@ -186,6 +187,41 @@ unsigned PredicateSplitPassiveClauseContainer::sizeEstimate() const
   }
 }
 
+/**
+ * Iterate over the clauses of all queues. In the layered arrangement
+ * a clause is returned once for every queue it is in.
+ */
+ClauseIterator PredicateSplitPassiveClauseContainer::iterator()
+{
+  CALL("PredicateSplitPassiveClauseContainer::iterator");
+
+  ClauseIterator res = ClauseIterator::getEmpty();
+  for (const auto& queue : _queues)
+  {
+    res = pvi(getConcatenatedIterator(queue->iterator(), res));
+  }
+  return res;
+}
+
+/**
+ * The clause might be selected before some clause in the container if
+ * that holds for one of the queues, as we don't know which queues it
+ * would be put in.
+ */
+bool PredicateSplitPassiveClauseContainer::mayBeSelectedBefore(unsigned w, const Inference& inference)
+{
+  CALL("PredicateSplitPassiveClauseContainer::mayBeSelectedBefore");
+
+  for (const auto& queue : _queues)
+  {
+    if (queue->mayBeSelectedBefore(w, inference))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 Clause* PredicateSplitPassiveClauseContainer::popSelected()
 {
   CALL("PredicateSplitPassiveClauseContainer::popSelected");
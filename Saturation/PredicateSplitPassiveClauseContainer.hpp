@@ -42,6 +42,8 @@ public:
   Clause* popSelected() override;
   bool isEmpty() const override; /** True if there are no passive clauses */
   unsigned sizeEstimate() const override;
+  ClauseIterator iterator() override;
+  bool mayBeSelectedBefore(unsigned w, const Inference& inference) override;
 
 private:
   Lib::vvector<std::unique_ptr<PassiveClauseContainer>> _queues;
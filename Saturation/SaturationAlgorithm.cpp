@@ -21,10 +21,15 @@
  * Implementing SaturationAlgorithm class.
  */
 
+#include <cstdio>
+#include <fstream>
+
 #include "Debug/RuntimeStatistics.hpp"
 
+#include "Lib/Allocator.hpp"
 #include "Lib/DHSet.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
 #include "Lib/Metaiterators.hpp"
 #include "Lib/SharedSet.hpp"
 #include "Lib/Stack.hpp"
@@ -34,6 +39,7 @@
 #include "Lib/STL.hpp"
 
 #include "Indexing/LiteralIndexingStructure.hpp"
+#include "Indexing/TermSharing.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/ColorHelper.hpp"
@@ -86,6 +92,7 @@
 #include "Shell/AnswerExtractor.hpp"
 #include "Shell/Options.hpp"
 #include "Shell/Statistics.hpp"
+#include "Shell/TPTPPrinter.hpp"
 #include "Shell/UIHelper.hpp"
 
 #include "Splitter.hpp"
@@ -95,9 +102,12 @@
 #include "Splitter.hpp"
 #include "SymElOutput.hpp"
 #include "SaturationAlgorithm.hpp"
+#include "ClauseRecipe.hpp"
 #include "ManCSPassiveClauseContainer.hpp"
 #include "AWPassiveClauseContainer.hpp"
 #include "PredicateSplitPassiveClauseContainer.hpp"
+#include "SpillingPassiveClauseContainer.hpp"
+#include "HeapPassiveClauseContainer.hpp"
 #include "Discount.hpp"
 #include "LRS.hpp"
 #include "Otter.hpp"
@@ -119,6 +129,12 @@ SaturationAlgorithm* SaturationAlgorithm::s_instance = 0;
 
 std::unique_ptr<PassiveClauseContainer> makeLevel0(bool isOutermost, const Options& opt, vstring name)
 {
+  if (opt.passiveSpillBudget()) {
+    return Lib::make_unique<SpillingPassiveClauseContainer>(isOutermost, opt, name + "AWQ");
+  }
+  if (opt.passiveQueue() == Options::PassiveQueue::HEAP) {
+    return Lib::make_unique<HeapPassiveClauseContainer>(isOutermost, opt, name + "AWH");
+  }
   return Lib::make_unique<AWPassiveClauseContainer>(isOutermost, opt, name + "AWQ");
 }
 
@@ -207,6 +223,9 @@ std::unique_ptr<PassiveClauseContainer> makeLevel4(bool isOutermost, const Optio
 SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   : MainLoop(prb, opt),
     _clauseActivationInProgress(false),
+    _checkpointing(!opt.checkpointFile().empty()), _nextCheckpointTime(0),
+    _nextRecipeNumber(0),
+    _discardedOnMemoryPressure(false), _memoryAfterPressure(0), _memoryAfterTermGarbage(0),
     _fwSimplifiers(0), _bwSimplifiers(0), _splitter(0),
     _consFinder(0), _labelFinder(0), _symEl(0), _answerLiteralManager(0),
     _instantiation(0),
@@ -274,6 +293,13 @@ SaturationAlgorithm::~SaturationAlgorithm()
 
   s_instance=0;
 
+  _bwSimplificationBatch.reset();
+
+  DHMap<unsigned,ClauseRecipe*>::Iterator rit(_recipes);
+  while (rit.hasNext()) {
+    delete rit.next();
+  }
+
   if (_splitter) {
     delete _splitter;
   }
@@ -329,7 +355,7 @@ void SaturationAlgorithm::tryUpdateFinalClauseCount()
  */
 bool SaturationAlgorithm::isComplete()
 {
-  return _completeOptionSettings && !env.statistics->inferencesSkippedDueToColors;
+  return _completeOptionSettings && !env.statistics->inferencesSkippedDueToColors && !_discardedOnMemoryPressure;
 }
 
 ClauseIterator SaturationAlgorithm::activeClauses()
@@ -741,6 +767,10 @@ void SaturationAlgorithm::init()
 {
   CALL("SaturationAlgorithm::init");
 
+  if (_opt.termGarbageCollection()) {
+    env.sharing->startGarbageCollection();
+  }
+
   ClauseIterator toAdd = _prb.clauseIterator();
 
   while (toAdd.hasNext()) {
@@ -990,6 +1020,13 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
 {
   CALL("SaturationAlgorithm::backwardSimplify");
 
+  if (_opt.backwardSimplificationBatch() > 1) {
+    _bwSimplificationBatch.push(cl);
+    if (_bwSimplificationBatch.size() >= _opt.backwardSimplificationBatch()) {
+      backwardSimplifyBatch();
+    }
+    return;
+  }
 
   BwSimplList::Iterator bsit(_bwSimplifiers);
   while (bsit.hasNext()) {
@@ -999,27 +1036,92 @@ void SaturationAlgorithm::backwardSimplify(Clause* cl)
     bse->perform(cl,simplifications);
     while (simplifications.hasNext()) {
       BwSimplificationRecord srec=simplifications.next();
-      Clause* redundant=srec.toRemove;
-      ASS_NEQ(redundant, cl);
+      ASS_NEQ(srec.toRemove, cl);
+      applyBackwardSimplification(srec.toRemove, srec.replacement, cl);
+    }
+  }
+}
 
-      Clause* replacement=srec.replacement;
+/**
+ * Do the backward simplification with the clauses collected by
+ * @b backwardSimplify() when backward_simplification_batch is greater
+ * than one. Return true if there were any such clauses.
+ *
+ * Each simplification engine gets all the collected clauses that were
+ * not removed in the meantime at once, so it can share the index
+ * traversals among them.
+ */
+bool SaturationAlgorithm::backwardSimplifyBatch()
+{
+  CALL("SaturationAlgorithm::backwardSimplifyBatch");
 
-      if (replacement) {
-	addNewClause(replacement);
-      }
-      onClauseReduction(redundant, replacement, cl, false);
+  if (_bwSimplificationBatch.isEmpty()) {
+    return false;
+  }
 
-      //we must remove the redundant clause before adding its replacement,
-      //as otherwise the redundant one might demodulate the replacement into
-      //a tautology
+  //the clauses stay referenced until the end, so the removed ones are
+  //not deleted before all the engines are done; the iteration over
+  //batch then goes in the order in which they were collected
+  ClauseStack batch;
+  while (_bwSimplificationBatch.isNonEmpty()) {
+    batch.push(_bwSimplificationBatch.popWithoutDec());
+  }
+  env.statistics->backwardSimplificationBatches++;
 
-      redundant->incRefCnt(); //we don't want the clause deleted before we record the simplification
+  ClauseStack premises;
+  BwSimplList::Iterator bsit(_bwSimplifiers);
+  while (bsit.hasNext()) {
+    BackwardSimplificationEngine* bse=bsit.next();
 
-      removeActiveOrPassiveClause(redundant);
+    premises.reset();
+    ClauseStack::Iterator cit(batch);
+    while (cit.hasNext()) {
+      Clause* cl = cit.next();
+      if (cl->store() != Clause::NONE) {
+        premises.push(cl);
+      }
+    }
+    if (premises.isEmpty()) {
+      break;
+    }
 
-      redundant->decRefCnt();
+    BwSimplificationRecordIterator simplifications;
+    bse->performBatch(premises,simplifications);
+    while (simplifications.hasNext()) {
+      BwSimplificationRecord srec=simplifications.next();
+      ASS_NEQ(srec.toRemove, srec.premise);
+      applyBackwardSimplification(srec.toRemove, srec.replacement, srec.premise);
     }
   }
+
+  while (batch.isNonEmpty()) {
+    batch.pop()->decRefCnt();
+  }
+  return true;
+}
+
+/**
+ * Replace the clause @b redundant by @b replacement (which may be zero)
+ * as a result of backward simplification by @b premise.
+ */
+void SaturationAlgorithm::applyBackwardSimplification(Clause* redundant, Clause* replacement, Clause* premise)
+{
+  CALL("SaturationAlgorithm::applyBackwardSimplification");
+
+  if (replacement) {
+    addNewClause(replacement);
+  }
+  onClauseReduction(redundant, replacement, premise, false);
+
+  //we must remove the redundant clause before adding its replacement,
+  //as otherwise the redundant one might demodulate the replacement into
+  //a tautology
+
+  redundant->incRefCnt(); //we don't want the clause deleted before we record the simplification
+
+  removeActiveOrPassiveClause(redundant);
+
+  redundant->decRefCnt();
 }
 
 /**
@@ -1070,12 +1172,31 @@ void SaturationAlgorithm::addToPassive(Clause* cl)
   cl->setStore(Clause::PASSIVE);
   env.statistics->passiveClauses++;
 
+  if (_opt.reclaimDeletedClauses() && !premisesNeeded()) {
+    //the premises were needed only to compute the split set and the
+    //parenthood, which has been done when the clause was derived
+    cl->inference().removePremises();
+  }
+
   {
     TimeCounter tc(TC_PASSIVE_CONTAINER_MAINTENANCE);
     _passive->add(cl);
   }
 }
 
+/**
+ * Return true if the premises of the clauses in the search space may
+ * still be needed: for the proof output, for answer extraction, for the
+ * symbol elimination output, or for the interpolation of an AVATAR
+ * refutation with colors.
+ */
+bool SaturationAlgorithm::premisesNeeded() const
+{
+  return _opt.proof() != Options::Proof::OFF ||
+      _opt.questionAnswering() != Options::QuestionAnsweringMode::OFF ||
+      _symEl || env.colorUsed;
+}
+
 /**
  * Activate clause @b cl
  *
@@ -1129,23 +1250,12 @@ bool SaturationAlgorithm::activate(Clause* cl)
 
 
     ClauseIterator toAdd= pvi(getConcatenatedIterator(instances,_generator->generateClauses(cl)));
+    if (_opt.sortGeneratedClauses()) {
+      toAdd = sortGeneratedClauses(toAdd);
+    }
 
     while (toAdd.hasNext()) {
-      Clause* genCl=toAdd.next();
-
-      addNewClause(genCl);
-
-      Inference::Iterator iit=genCl->inference().iterator();
-      while (genCl->inference().hasNext(iit)) {
-        Unit* premUnit=genCl->inference().next(iit);
-        // Now we can get generated clauses having parents that are not clauses
-        // Indeed, from induction we can have generated clauses whose parents do 
-        // not include the activated clause
-        if(premUnit->isClause()){
-          Clause* premCl=static_cast<Clause*>(premUnit);
-          onParenthood(genCl, premCl);
-        }
-      }
+      addGeneratedClause(toAdd.next());
     }
 
   _clauseActivationInProgress=false;
@@ -1164,6 +1274,253 @@ bool SaturationAlgorithm::activate(Clause* cl)
   return true; 
 }
 
+/**
+ * Add a clause obtained by a generating inference and report
+ * its parents.
+ */
+void SaturationAlgorithm::addGeneratedClause(Clause* genCl)
+{
+  CALL("SaturationAlgorithm::addGeneratedClause");
+
+  addNewClause(genCl);
+
+  Inference::Iterator iit=genCl->inference().iterator();
+  while (genCl->inference().hasNext(iit)) {
+    Unit* premUnit=genCl->inference().next(iit);
+    // Now we can get generated clauses having parents that are not clauses
+    // Indeed, from induction we can have generated clauses whose parents do
+    // not include the activated clause
+    if(premUnit->isClause()){
+      Clause* premCl=static_cast<Clause*>(premUnit);
+      onParenthood(genCl, premCl);
+    }
+  }
+}
+
+Comparison SaturationAlgorithm::RecipeWeightComparator::compare(const RecipeKey& k1, const RecipeKey& k2)
+{
+  Comparison res = Int::compare(k1.weight, k2.weight);
+  if (res == EQUAL) {
+    res = Int::compare(k1.age, k2.age);
+  }
+  if (res == EQUAL) {
+    res = Int::compare(k1.number, k2.number);
+  }
+  return res;
+}
+
+Comparison SaturationAlgorithm::RecipeAgeComparator::compare(const RecipeKey& k1, const RecipeKey& k2)
+{
+  Comparison res = Int::compare(k1.age, k2.age);
+  if (res == EQUAL) {
+    res = Int::compare(k1.weight, k2.weight);
+  }
+  if (res == EQUAL) {
+    res = Int::compare(k1.number, k2.number);
+  }
+  return res;
+}
+
+/**
+ * Take over @b recipe of a generated clause, the clause will be built
+ * by @b materializeRecipes() when it could be selected from passive.
+ */
+void SaturationAlgorithm::addClauseRecipe(ClauseRecipe* recipe)
+{
+  CALL("SaturationAlgorithm::addClauseRecipe");
+
+  RecipeKey key;
+  key.weight = Clause::computeWeightForClauseSelection(recipe->weight(), 0, 0, recipe->inference().derivedFromGoal(), _opt);
+  key.age = recipe->inference().age();
+  key.number = _nextRecipeNumber++;
+
+  ALWAYS(_recipes.insert(key.number, recipe));
+  _recipesByWeight.insert(key);
+  _recipesByAge.insert(key);
+  env.statistics->clauseRecipes++;
+}
+
+/**
+ * Build the clauses of recipes that might be selected before the
+ * clause the passive container would select next, and add them
+ * as new clauses. Return true if a clause was added.
+ *
+ * Recipes with a premise that is no longer active are dropped, as
+ * the inference would not be performed any more.
+ */
+bool SaturationAlgorithm::materializeRecipes()
+{
+  CALL("SaturationAlgorithm::materializeRecipes");
+
+  static ClauseStack materialized;
+  materialized.reset();
+  for (;;) {
+    while (!_recipesByWeight.isEmpty() && !_recipes.find(_recipesByWeight.top().number)) {
+      _recipesByWeight.pop();
+    }
+    while (!_recipesByAge.isEmpty() && !_recipes.find(_recipesByAge.top().number)) {
+      _recipesByAge.pop();
+    }
+    if (_recipes.isEmpty()) {
+      //all keys are stale
+      _recipesByWeight.reset();
+      _recipesByAge.reset();
+      break;
+    }
+
+    unsigned number;
+    ClauseRecipe* recipe = _recipes.get(_recipesByWeight.top().number);
+    if (_passive->mayBeSelectedBefore(recipe->weight(), recipe->inference())) {
+      number = _recipesByWeight.pop().number;
+    }
+    else {
+      recipe = _recipes.get(_recipesByAge.top().number);
+      if (!_passive->mayBeSelectedBefore(recipe->weight(), recipe->inference())) {
+        break;
+      }
+      number = _recipesByAge.pop().number;
+    }
+    ALWAYS(_recipes.pop(number, recipe));
+
+    bool premisesActive = true;
+    Inference::Iterator iit = recipe->inference().iterator();
+    while (recipe->inference().hasNext(iit)) {
+      Unit* prem = recipe->inference().next(iit);
+      if (prem->isClause() && static_cast<Clause*>(prem)->store() != Clause::ACTIVE) {
+        premisesActive = false;
+        break;
+      }
+    }
+    Clause* cl = premisesActive ? recipe->materialize() : 0;
+    delete recipe;
+
+    if (cl) {
+      env.statistics->materializedRecipes++;
+      materialized.push(cl);
+    }
+  }
+
+  //the clauses are added only now so that they can be sorted like the
+  //clauses generated by an activation
+  ClauseIterator toAdd = pvi( ClauseStack::BottomFirstIterator(materialized) );
+  if (_opt.sortGeneratedClauses()) {
+    toAdd = sortGeneratedClauses(toAdd);
+  }
+  while (toAdd.hasNext()) {
+    addGeneratedClause(toAdd.next());
+  }
+  return materialized.isNonEmpty();
+}
+
+/**
+ * Compare the contents of @b t1 and @b t2, that is their symbols and
+ * variables, with the arguments of commutative symbols taken in the order
+ * of their contents.
+ *
+ * Unlike the order of the ids term sharing gives to terms, this does not
+ * depend on the order in which the terms were created.
+ */
+static Comparison compareContents(TermList t1, TermList t2)
+{
+  CALL("compareContents");
+
+  if (t1 == t2) {
+    return EQUAL;
+  }
+  if (t1.isVar() || t2.isVar()) {
+    if (!t1.isVar()) {
+      return GREATER;
+    }
+    if (!t2.isVar()) {
+      return LESS;
+    }
+    return Int::compare(t1.content(), t2.content());
+  }
+  Term* s1 = t1.term();
+  Term* s2 = t2.term();
+  if (s1->isLiteral()) {
+    Literal* l1 = static_cast<Literal*>(s1);
+    Literal* l2 = static_cast<Literal*>(s2);
+    if (l1->header() != l2->header()) {
+      return Int::compare(l1->header(), l2->header());
+    }
+  }
+  else if (s1->functor() != s2->functor()) {
+    return Int::compare(s1->functor(), s2->functor());
+  }
+  ASS_EQ(s1->arity(), s2->arity());
+
+  if (s1->commutative()) {
+    ASS_EQ(s1->arity(), 2);
+    TermList a1 = *s1->nthArgument(0);
+    TermList b1 = *s1->nthArgument(1);
+    TermList a2 = *s2->nthArgument(0);
+    TermList b2 = *s2->nthArgument(1);
+    if (compareContents(a1, b1) == GREATER) {
+      std::swap(a1, b1);
+    }
+    if (compareContents(a2, b2) == GREATER) {
+      std::swap(a2, b2);
+    }
+    Comparison res = compareContents(a1, a2);
+    return res == EQUAL ? compareContents(b1, b2) : res;
+  }
+  for (unsigned i = 0; i < s1->arity(); i++) {
+    Comparison res = compareContents(*s1->nthArgument(i), *s2->nthArgument(i));
+    if (res != EQUAL) {
+      return res;
+    }
+  }
+  return EQUAL;
+}
+
+/**
+ * Put lighter clauses first, then shorter ones, then the ones whose
+ * literals have smaller contents.
+ *
+ * Only clauses with the same literals in the same order are ordered by
+ * their numbers, so the order of the other ones does not depend on the order
+ * in which they were generated.
+ */
+bool SaturationAlgorithm::GeneratedClauseComparator::operator()(Clause* c1, Clause* c2) const
+{
+  CALL("SaturationAlgorithm::GeneratedClauseComparator::operator()");
+
+  //the weights must not be cached by Clause::weight() yet, as the
+  //splitter assigns the split sets only when the clauses are added
+  unsigned w1 = c1->computeWeight();
+  unsigned w2 = c2->computeWeight();
+  if (w1 != w2) {
+    return w1 < w2;
+  }
+  if (c1->length() != c2->length()) {
+    return c1->length() < c2->length();
+  }
+  for (unsigned i = 0; i < c1->length(); i++) {
+    Comparison res = compareContents(TermList((*c1)[i]), TermList((*c2)[i]));
+    if (res != EQUAL) {
+      return res == LESS;
+    }
+  }
+  return c1->number() < c2->number();
+}
+
+/**
+ * Exhaust the iterator @b generated and return its clauses sorted by
+ * GeneratedClauseComparator.
+ *
+ * The returned iterator is valid until the next call of this function.
+ */
+ClauseIterator SaturationAlgorithm::sortGeneratedClauses(ClauseIterator generated)
+{
+  CALL("SaturationAlgorithm::sortGeneratedClauses");
+
+  _generatedBuffer.reset();
+  _generatedBuffer.loadFromIterator(generated);
+  std::sort(_generatedBuffer.begin(), _generatedBuffer.end(), GeneratedClauseComparator());
+  return pvi( ClauseStack::BottomFirstIterator(_generatedBuffer) );
+}
+
 /**
  * Perform the loop that puts clauses from the unprocessed to the passive container.
  */
@@ -1176,17 +1533,22 @@ start:
   newClausesToUnprocessed();
 
   while (! _unprocessed->isEmpty()) {
-    Clause* c = _unprocessed->pop();
-    ASS(!isRefutation(c));
-
-    if (forwardSimplify(c)) {
-      onClauseRetained(c);
-      addToPassive(c);
-      ASS_EQ(c->store(), Clause::PASSIVE);
+    if (_opt.forwardSimplificationBatch() > 1) {
+      doUnprocessedBatch();
     }
     else {
-      ASS_EQ(c->store(), Clause::UNPROCESSED);
-      c->setStore(Clause::NONE);
+      Clause* c = _unprocessed->pop();
+      ASS(!isRefutation(c));
+
+      if (forwardSimplify(c)) {
+        onClauseRetained(c);
+        addToPassive(c);
+        ASS_EQ(c->store(), Clause::PASSIVE);
+      }
+      else {
+        ASS_EQ(c->store(), Clause::UNPROCESSED);
+        c->setStore(Clause::NONE);
+      }
     }
 
     newClausesToUnprocessed();
@@ -1196,6 +1558,11 @@ start:
     }
   }
 
+  if (backwardSimplifyBatch()) {
+    //the replacements of the simplified clauses are yet to be processed
+    goto start;
+  }
+
   ASS(clausesFlushed());
   onAllProcessed();
   if (!clausesFlushed()) {
@@ -1205,6 +1572,242 @@ start:
 
 }
 
+/**
+ * Take up to forward_simplification_batch clauses from the unprocessed
+ * container and forward simplify all of them before any of them enters
+ * the passive container.
+ *
+ * Every clause of the batch is therefore simplified against the same
+ * set of simplifying clauses, and the retained clauses are added to
+ * passive in the order in which they were popped from unprocessed, so
+ * the result does not depend on the order in which the batch members
+ * are simplified.
+ */
+void SaturationAlgorithm::doUnprocessedBatch()
+{
+  CALL("SaturationAlgorithm::doUnprocessedBatch");
+  ASS(_unprocessedBatch.isEmpty());
+
+  unsigned batchSize = _opt.forwardSimplificationBatch();
+  while (_unprocessedBatch.size() < batchSize && !_unprocessed->isEmpty()) {
+    Clause* c = _unprocessed->pop();
+    ASS(!isRefutation(c));
+    _unprocessedBatch.push(c);
+  }
+
+  unsigned retained = 0;
+  for (unsigned i = 0; i < _unprocessedBatch.size(); i++) {
+    Clause* c = _unprocessedBatch[i];
+    if (forwardSimplify(c)) {
+      onClauseRetained(c);
+      _unprocessedBatch[retained++] = c;
+    }
+    else {
+      ASS_EQ(c->store(), Clause::UNPROCESSED);
+      c->setStore(Clause::NONE);
+    }
+  }
+  _unprocessedBatch.truncate(retained);
+
+  ClauseStack::BottomFirstIterator bit(_unprocessedBatch);
+  while (bit.hasNext()) {
+    Clause* c = bit.next();
+    addToPassive(c);
+    ASS_EQ(c->store(), Clause::PASSIVE);
+  }
+  _unprocessedBatch.reset();
+}
+
+/**
+ * Call @b onMemoryPressure() if the memory in use exceeds
+ * memory_pressure_watermark percent of the memory limit.
+ *
+ * Memory freed by the allocator is not returned to the system but
+ * reused, so the memory in use is the allocated memory without the
+ * free one. To avoid repeating the work when it does not bring the
+ * usage below the watermark, the next call happens only after the
+ * usage grows by another percent of the limit.
+ *
+ * With USE_SYSTEM_ALLOCATION the allocator does not keep track of the
+ * used memory, so this never calls @b onMemoryPressure().
+ */
+void SaturationAlgorithm::checkMemoryPressure()
+{
+  CALL("SaturationAlgorithm::checkMemoryPressure");
+
+  if (!_opt.memoryPressureWatermark()) {
+    return;
+  }
+  size_t onePercent = Allocator::getMemoryLimit()/100;
+  size_t inUse = Allocator::getUsedMemory()-Allocator::getFreeMemory();
+  if (inUse < onePercent*_opt.memoryPressureWatermark() ||
+      (_memoryAfterPressure && inUse < _memoryAfterPressure+onePercent)) {
+    return;
+  }
+
+  env.statistics->memoryPressureEvents++;
+  onMemoryPressure();
+  memoryPressureEvent.fire();
+
+  _memoryAfterPressure = Allocator::getUsedMemory()-Allocator::getFreeMemory();
+}
+
+/**
+ * Free memory so that the run can go on within the memory limit.
+ *
+ * The first steps keep the completeness of the proof search: the
+ * inference records of clauses are released when their premises are
+ * not needed (this lets the deleted clauses they refer to go), and the backward
+ * simplifications are switched off together with their indexes. Then
+ * the passive limits are tightened to what can be selected before the
+ * passive container is halved, and if the memory is still short, the
+ * heaviest quarter of passive clauses is evicted.
+ */
+void SaturationAlgorithm::onMemoryPressure()
+{
+  CALL("SaturationAlgorithm::onMemoryPressure");
+
+  size_t watermark = Allocator::getMemoryLimit()/100*_opt.memoryPressureWatermark();
+
+  if (!premisesNeeded()) {
+    static ClauseStack clauses;
+    clauses.reset();
+    clauses.loadFromIterator(activeClauses());
+    clauses.loadFromIterator(_passive->iterator());
+    while (clauses.isNonEmpty()) {
+      Inference& inf = clauses.pop()->inference();
+      Inference::Iterator iit = inf.iterator();
+      if (inf.hasNext(iit)) {
+        inf.removePremises();
+        env.statistics->memoryPressureReleasedInferences++;
+      }
+    }
+  }
+
+  _bwSimplificationBatch.reset();
+  while (_bwSimplifiers) {
+    BackwardSimplificationEngine* bse = BwSimplList::pop(_bwSimplifiers);
+    bse->detach();
+    delete bse;
+    env.statistics->memoryPressureDroppedSimplifiers++;
+  }
+
+  if (Allocator::getUsedMemory()-Allocator::getFreeMemory() < watermark) {
+    return;
+  }
+
+  _discardedOnMemoryPressure = true;
+  {
+    TimeCounter tc(TC_PASSIVE_CONTAINER_MAINTENANCE);
+    _passive->updateLimits(_passive->sizeEstimate()/2);
+  }
+
+  if (Allocator::getUsedMemory()-Allocator::getFreeMemory() < watermark) {
+    return;
+  }
+
+  TimeCounter tc(TC_PASSIVE_CONTAINER_MAINTENANCE);
+  env.statistics->memoryPressureEvictedClauses += _passive->evictHeaviest(_passive->sizeEstimate()/4);
+}
+
+/**
+ * Call @b collectTermGarbage() if the memory in use has grown by the
+ * number of megabytes given by the term_garbage_collection option
+ * since the previous collection.
+ */
+void SaturationAlgorithm::checkTermGarbage()
+{
+  CALL("SaturationAlgorithm::checkTermGarbage");
+
+  if (!_opt.termGarbageCollection()) {
+    return;
+  }
+  size_t inUse = Allocator::getUsedMemory()-Allocator::getFreeMemory();
+  if (inUse < _memoryAfterTermGarbage+static_cast<size_t>(_opt.termGarbageCollection())*1048576) {
+    return;
+  }
+
+  collectTermGarbage();
+
+  _memoryAfterTermGarbage = Allocator::getUsedMemory()-Allocator::getFreeMemory();
+}
+
+/**
+ * Free the shared terms and literals no live clause refers to.
+ *
+ * Must be called when the unprocessed clauses are flushed and no index
+ * retrieval is in progress, so that no index has postponed the removal
+ * of a clause that may already be deleted. The terms are marked from
+ * the active and passive clauses, the premises of clause recipes and the
+ * clauses of the splitter, and when the premises are needed, from all
+ * the units these clauses were derived from. The substitution trees
+ * retain the normalized terms of their entries (see TermSharing::retain()),
+ * and the terms made before saturation are never freed.
+ */
+void SaturationAlgorithm::collectTermGarbage()
+{
+  CALL("SaturationAlgorithm::collectTermGarbage");
+  ASS(clausesFlushed());
+
+  static ClauseStack roots;
+  roots.reset();
+  roots.loadFromIterator(activeClauses());
+  roots.loadFromIterator(_passive->iterator());
+  if (_splitter) {
+    _splitter->collectClauses(roots);
+  }
+
+  static Stack<Unit*> toDo;
+  toDo.reset();
+  while (roots.isNonEmpty()) {
+    toDo.push(roots.pop());
+  }
+  DHMap<unsigned,ClauseRecipe*>::Iterator rit(_recipes);
+  while (rit.hasNext()) {
+    const Inference& inf = rit.next()->inference();
+    Inference::Iterator iit = inf.iterator();
+    while (inf.hasNext(iit)) {
+      toDo.push(inf.next(iit));
+    }
+  }
+
+  bool ancestors = premisesNeeded();
+  DHSet<Unit*> visited;
+  while (toDo.isNonEmpty()) {
+    Unit* u = toDo.pop();
+    if (!visited.insert(u)) {
+      continue;
+    }
+    if (u->isClause()) {
+      Clause* cl = static_cast<Clause*>(u);
+      for (unsigned i = 0; i < cl->length(); i++) {
+        //the literals of clauses spilled by SpillingPassiveClauseContainer are 0
+        if ((*cl)[i]) {
+          env.sharing->mark((*cl)[i]);
+        }
+      }
+    }
+    else {
+      SubformulaIterator sfit(static_cast<FormulaUnit*>(u)->formula());
+      while (sfit.hasNext()) {
+        Formula* f = sfit.next();
+        if (f->connective() == LITERAL) {
+          env.sharing->mark(f->literal());
+        }
+      }
+    }
+    if (ancestors) {
+      Inference& inf = u->inference();
+      Inference::Iterator iit = inf.iterator();
+      while (inf.hasNext(iit)) {
+        toDo.push(inf.next(iit));
+      }
+    }
+  }
+
+  env.sharing->collectGarbage();
+}
+
 void SaturationAlgorithm::handleUnsuccessfulActivation(Clause* cl)
 {
   CALL("SaturationAlgorithm::handleUnsuccessfulActivation");
@@ -1253,6 +1856,71 @@ UnitList* SaturationAlgorithm::collectSaturatedSet()
   return res;
 }
 
+/**
+ * Write the current clause set to the file given by the @b checkpoint_file
+ * option, so that the proof attempt can be resumed by running on the file.
+ *
+ * Must be called when the unprocessed clauses are flushed. The written set
+ * consists of the split-free active and passive clauses, the clauses built
+ * from the components that AVATAR replaced split-free clauses by and the
+ * split-free clauses frozen by conditional reductions. Clauses depending on
+ * splits are not written, as they follow from the split clauses. The file is
+ * first written under a temporary name and then renamed, so that an
+ * interrupted write does not destroy the previous checkpoint. If writing
+ * fails, a warning is printed and the saturation continues.
+ */
+void SaturationAlgorithm::writeCheckpoint()
+{
+  CALL("SaturationAlgorithm::writeCheckpoint");
+  ASS(clausesFlushed());
+
+  RCClauseStack splitClauses;
+  ClauseStack toWrite;
+  toWrite.loadFromIterator(activeClauses());
+  toWrite.loadFromIterator(_passive->iterator());
+  if (_splitter) {
+    _splitter->collectSplitFreeSplitClauses(splitClauses);
+    toWrite.loadFromIterator(RCClauseStack::Iterator(splitClauses));
+    _splitter->collectConditionallyReducedClauses(toWrite);
+  }
+
+  vstring fname = _opt.checkpointFile();
+  vstring tmpName = fname + ".tmp";
+  vstring error;
+  {
+    ofstream out(tmpName.c_str());
+    TPTPPrinter printer(&out);
+    DHSet<Clause*> written;
+    ClauseStack::Iterator cit(toWrite);
+    while (cit.hasNext()) {
+      Clause* cl = cit.next();
+      if (!cl->noSplits() || !written.insert(cl)) {
+        continue;
+      }
+      vstring role = cl->derivedFromGoal() ? "negated_conjecture" : "axiom";
+      printer.printWithRole("c"+Int::toString(cl->number()), role, cl, false);
+    }
+    out.close();
+    if (out.fail()) {
+      error = "cannot write checkpoint file "+tmpName;
+    }
+  }
+  if (error.empty() && std::rename(tmpName.c_str(), fname.c_str())) {
+    error = "cannot rename "+tmpName+" to "+fname;
+  }
+  if (!error.empty()) {
+    std::remove(tmpName.c_str());
+    if (outputAllowed()) {
+      env.beginOutput();
+      addCommentSignForSZS(env.out());
+      env.out() << "WARNING: " << error << endl;
+      env.endOutput();
+    }
+    return;
+  }
+  env.statistics->checkpointsWritten++;
+}
+
 /**
  *
  * This function may throw RefutationFoundException and TimeLimitExceededException.
@@ -1262,6 +1930,17 @@ void SaturationAlgorithm::doOneAlgorithmStep()
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
   doUnprocessedLoop();
+  while (materializeRecipes()) {
+    doUnprocessedLoop();
+  }
+
+  if (_checkpointing && env.timer->elapsedMilliseconds() >= _nextCheckpointTime) {
+    writeCheckpoint();
+    _nextCheckpointTime = env.timer->elapsedMilliseconds() + _opt.checkpointInterval()*1000;
+  }
+
+  checkMemoryPressure();
+  checkTermGarbage();
 
   if (_passive->isEmpty()) {
     MainLoopResult::TerminationReason termReason =
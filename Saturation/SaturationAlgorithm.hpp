@@ -27,6 +27,8 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/BinaryHeap.hpp"
+#include "Lib/Comparison.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Event.hpp"
 #include "Lib/List.hpp"
@@ -87,6 +89,7 @@ public:
 
 
   void addNewClause(Clause* cl);
+  void addClauseRecipe(ClauseRecipe* recipe);
   bool clausesFlushed();
 
   void removeActiveOrPassiveClause(Clause* cl);
@@ -125,14 +128,31 @@ public:
    * to the object; otherwise return zero.
    */
   static SaturationAlgorithm* tryGetInstance() { return s_instance; }
+
+  /**
+   * Fired when the memory usage crosses memory_pressure_watermark,
+   * after the saturation algorithm freed what it could. Components
+   * keeping their own caches can subscribe to release them.
+   */
+  PlainEvent memoryPressureEvent;
   static void tryUpdateFinalClauseCount();
 
   Splitter* getSplitter() { return _splitter; }
 
+  /**
+   * Order of the clauses of one activation by their weights, lengths and
+   * contents, see @b sortGeneratedClauses()
+   */
+  struct GeneratedClauseComparator
+  {
+    bool operator()(Clause* c1, Clause* c2) const;
+  };
+
 protected:
   virtual void init();
   virtual MainLoopResult runImpl();
   void doUnprocessedLoop();
+  void doUnprocessedBatch();
   virtual void handleUnsuccessfulActivation(Clause* c);
   virtual bool handleClauseBeforeActivation(Clause* c);
   void addInputSOSClause(Clause* cl);
@@ -140,8 +160,19 @@ protected:
   void addUnprocessedClause(Clause* cl);
   bool forwardSimplify(Clause* c);
   void backwardSimplify(Clause* c);
+  bool backwardSimplifyBatch();
+  void applyBackwardSimplification(Clause* redundant, Clause* replacement, Clause* premise);
   void addToPassive(Clause* c);
   bool activate(Clause* c);
+  void addGeneratedClause(Clause* c);
+  bool materializeRecipes();
+  void checkMemoryPressure();
+  void checkTermGarbage();
+  void collectTermGarbage();
+  bool premisesNeeded() const;
+  virtual void onMemoryPressure();
+  ClauseIterator sortGeneratedClauses(ClauseIterator generated);
+  void writeCheckpoint();
   virtual void onSOSClauseAdded(Clause* c) {}
   void onActiveAdded(Clause* c);
   virtual void onActiveRemoved(Clause* c);
@@ -170,6 +201,24 @@ private:
   SmartPtr<IndexManager> _imgr;
 
   class TotalSimplificationPerformer;
+
+  /** Selection keys of a clause recipe */
+  struct RecipeKey
+  {
+    unsigned weight;
+    unsigned age;
+    unsigned number;
+  };
+  /** Comparator putting recipes of smaller weight first */
+  struct RecipeWeightComparator
+  {
+    static Comparison compare(const RecipeKey& k1, const RecipeKey& k2);
+  };
+  /** Comparator putting recipes of smaller age first */
+  struct RecipeAgeComparator
+  {
+    static Comparison compare(const RecipeKey& k1, const RecipeKey& k2);
+  };
   class PartialSimplificationPerformer;
 
   static SaturationAlgorithm* s_instance;
@@ -183,6 +232,36 @@ protected:
 
   ClauseStack _postponedClauseRemovals;
 
+  /** Clauses taken from unprocessed by @b doUnprocessedBatch() */
+  ClauseStack _unprocessedBatch;
+  /** Clauses collected by @b backwardSimplify() for @b backwardSimplifyBatch() */
+  RCClauseStack _bwSimplificationBatch;
+  /** Clauses of one activation collected by @b sortGeneratedClauses() */
+  ClauseStack _generatedBuffer;
+
+  /** True if the @b checkpoint_file option is set */
+  bool _checkpointing;
+  /** Elapsed time in milliseconds at which the next checkpoint is due */
+  int _nextCheckpointTime;
+
+  /** Clause recipes that were not materialized yet, by their sequence numbers */
+  DHMap<unsigned,ClauseRecipe*> _recipes;
+  /**
+   * Keys of the recipes in the weight and age orders. Entries whose recipe
+   * is no longer in @b _recipes are skipped.
+   */
+  BinaryHeap<RecipeKey,RecipeWeightComparator> _recipesByWeight;
+  BinaryHeap<RecipeKey,RecipeAgeComparator> _recipesByAge;
+  /** Sequence number of the next recipe */
+  unsigned _nextRecipeNumber;
+
+  /** True if clauses were discarded to free memory, see @b onMemoryPressure() */
+  bool _discardedOnMemoryPressure;
+  /** Memory in use after the last @b onMemoryPressure() call */
+  size_t _memoryAfterPressure;
+  /** Memory in use after the last @b collectTermGarbage() call */
+  size_t _memoryAfterTermGarbage;
+
   UnprocessedClauseContainer* _unprocessed;
   std::unique_ptr<PassiveClauseContainer> _passive;
   ActiveClauseContainer* _active;
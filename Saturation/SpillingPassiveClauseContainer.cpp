@@ -0,0 +1,485 @@
+/*
+ * File SpillingPassiveClauseContainer.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SpillingPassiveClauseContainer.cpp
+ * Implements class SpillingPassiveClauseContainer.
+ */
+
+#include <algorithm>
+#include <cerrno>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "SpillingPassiveClauseContainer.hpp"
+
+namespace Saturation
+{
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * The spill file is compacted only when the parts freed by reloaded
+ * clauses take at least this many bytes, besides taking more than
+ * the spilled clauses.
+ */
+static const long MIN_COMPACTED_SIZE = 65536;
+
+SpillingPassiveClauseContainer::SpillKey::SpillKey(Clause* cl, const Shell::Options& opt)
+  : weight(cl->weightForClauseSelection(opt)), age(cl->age()),
+    inputType(cl->inputType()), number(cl->number())
+{
+}
+
+/**
+ * Compare keys in the order of WeightQueue::lessThan
+ */
+Comparison SpillingPassiveClauseContainer::WeightKeyComparator::compare(const SpillKey& k1, const SpillKey& k2)
+{
+  Comparison res = Int::compare(k1.weight, k2.weight);
+  if (res == EQUAL) {
+    res = Int::compare(k1.age, k2.age);
+  }
+  if (res == EQUAL) {
+    res = Int::compare(static_cast<unsigned>(k2.inputType), static_cast<unsigned>(k1.inputType));
+  }
+  if (res == EQUAL) {
+    res = Int::compare(k1.number, k2.number);
+  }
+  return res;
+}
+
+/**
+ * Compare keys in the order of AgeQueue::lessThan
+ */
+Comparison SpillingPassiveClauseContainer::AgeKeyComparator::compare(const SpillKey& k1, const SpillKey& k2)
+{
+  Comparison res = Int::compare(k1.age, k2.age);
+  if (res == EQUAL) {
+    res = Int::compare(k1.weight, k2.weight);
+  }
+  if (res == EQUAL) {
+    res = Int::compare(static_cast<unsigned>(k2.inputType), static_cast<unsigned>(k1.inputType));
+  }
+  if (res == EQUAL) {
+    res = Int::compare(k1.number, k2.number);
+  }
+  return res;
+}
+
+SpillingPassiveClauseContainer::SpillingPassiveClauseContainer(bool isOutermost, const Shell::Options& opt, vstring name)
+  : AWPassiveClauseContainer(isOutermost, opt, name),
+    _budget(opt.passiveSpillBudget()), _file(0), _fileEnd(0), _spilledSize(0)
+{
+  CALL("SpillingPassiveClauseContainer::SpillingPassiveClauseContainer");
+  ASS_G(_budget, 0);
+}
+
+/**
+ * Read all spilled clauses back, so that they are released in the
+ * same way as the clauses kept in memory.
+ */
+SpillingPassiveClauseContainer::~SpillingPassiveClauseContainer()
+{
+  CALL("SpillingPassiveClauseContainer::~SpillingPassiveClauseContainer");
+
+  Stack<unsigned> numbers;
+  DHMap<unsigned,SpillSlot>::Iterator sit(_spilled);
+  while (sit.hasNext()) {
+    numbers.push(sit.nextKey());
+  }
+  while (numbers.isNonEmpty()) {
+    Clause* cl = reload(numbers.pop());
+    ASS(!_isOutermost || cl->store()==Clause::PASSIVE);
+    cl->setStore(Clause::NONE);
+  }
+  if (_file) {
+    std::fclose(_file);
+  }
+}
+
+void SpillingPassiveClauseContainer::add(Clause* cl)
+{
+  CALL("SpillingPassiveClauseContainer::add");
+  ASS(cl->store() == Clause::PASSIVE);
+
+  if (AWPassiveClauseContainer::sizeEstimate() < _budget || !cl->noSplits()) {
+    AWPassiveClauseContainer::add(cl);
+    return;
+  }
+
+  if (_isOutermost) {
+    addedEvent.fire(cl);
+  }
+  spill(cl);
+}
+
+void SpillingPassiveClauseContainer::remove(Clause* cl)
+{
+  CALL("SpillingPassiveClauseContainer::remove");
+
+  if (!_spilled.find(cl->number())) {
+    AWPassiveClauseContainer::remove(cl);
+    return;
+  }
+  //the clause is complete when it is released
+  reload(cl->number());
+  if (_isOutermost) {
+    removedEvent.fire(cl);
+    ASS(cl->store()!=Clause::PASSIVE);
+  }
+}
+
+/**
+ * Iterate over the clauses in the queues and the spilled clauses, whose
+ * literals are set to 0.
+ */
+ClauseIterator SpillingPassiveClauseContainer::iterator()
+{
+  CALL("SpillingPassiveClauseContainer::iterator");
+
+  static Stack<Clause*> spilled;
+  spilled.reset();
+  DHMap<unsigned,SpillSlot>::Iterator sit(_spilled);
+  while (sit.hasNext()) {
+    spilled.push(sit.next().clause);
+  }
+  return pvi( getConcatenatedIterator(AWPassiveClauseContainer::iterator(), Stack<Clause*>::Iterator(spilled)) );
+}
+
+/**
+ * Remove up to @b cnt clauses that would be selected last by weight,
+ * taking both the clauses in the queues and the spilled ones.
+ */
+unsigned SpillingPassiveClauseContainer::evictHeaviest(unsigned cnt)
+{
+  CALL("SpillingPassiveClauseContainer::evictHeaviest");
+
+  if (!_isOutermost || !_weightRatio || !cnt) {
+    return 0;
+  }
+
+  typedef std::pair<SpillKey,Clause*> Candidate;
+  static Stack<Candidate> candidates;
+  candidates.reset();
+  ClauseQueue::Iterator wit(_weightQueue);
+  while (wit.hasNext()) {
+    Clause* cl = wit.next();
+    candidates.push(Candidate(SpillKey(cl, _opt), cl));
+  }
+  DHMap<unsigned,SpillSlot>::Iterator sit(_spilled);
+  while (sit.hasNext()) {
+    const SpillSlot& slot = sit.next();
+    candidates.push(Candidate(slot.key, slot.clause));
+  }
+  if (cnt > candidates.size()) {
+    cnt = candidates.size();
+  }
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& c1, const Candidate& c2) {
+    return WeightKeyComparator::compare(c1.first, c2.first) == GREATER;
+  });
+
+  for (unsigned i = 0; i < cnt; i++) {
+    env.statistics->discardedNonRedundantClauses++;
+    remove(candidates[i].second);
+  }
+  return cnt;
+}
+
+/**
+ * Append to @b out the encoding of @b t in prefix order, with a variable
+ * encoded as 2*var+1 and a term as 2*functor followed by its arguments.
+ */
+void SpillingPassiveClauseContainer::writeTerm(TermList t, Stack<unsigned>& out)
+{
+  CALL("SpillingPassiveClauseContainer::writeTerm");
+
+  if (t.isVar()) {
+    out.push(2*t.var()+1);
+    return;
+  }
+  Term* trm = t.term();
+  ASS(!trm->isSpecial());
+  out.push(2*trm->functor());
+  for (TermList* arg = trm->args(); !arg->isEmpty(); arg = arg->next()) {
+    writeTerm(*arg, out);
+  }
+}
+
+/**
+ * Read a term written by writeTerm() from @b in and advance @b in past it.
+ */
+TermList SpillingPassiveClauseContainer::readTerm(const unsigned*& in)
+{
+  CALL("SpillingPassiveClauseContainer::readTerm");
+
+  unsigned code = *in++;
+  if (code & 1) {
+    return TermList(code/2, false);
+  }
+  unsigned functor = code/2;
+  unsigned arity = env.signature->getFunction(functor)->arity();
+  Stack<TermList> args(arity);
+  for (unsigned i = 0; i < arity; i++) {
+    args.push(readTerm(in));
+  }
+  return TermList(Term::create(functor, arity, args.begin()));
+}
+
+/**
+ * Write the literals of the clause @b cl to the file and set them to 0.
+ *
+ * The literals are written as term structures, so that the shared terms
+ * need not stay alive while the clause is spilled. The clause object with
+ * its inference stays in memory.
+ */
+void SpillingPassiveClauseContainer::spill(Clause* cl)
+{
+  CALL("SpillingPassiveClauseContainer::spill");
+
+  if (!_file) {
+    _file = std::tmpfile();
+    if (!_file) {
+      SYSTEM_FAIL("Cannot create a file for spilling passive clauses", errno);
+    }
+  }
+
+  //the keys also make the clause cache its weight, which needs the literals
+  SpillKey key(cl, _opt);
+
+  static Stack<unsigned> words;
+  words.reset();
+  unsigned clen = cl->length();
+  for (unsigned i = 0; i < clen; i++) {
+    Literal* lit = (*cl)[i];
+    words.push(2*lit->functor() + (lit->polarity() ? 1 : 0));
+    if (lit->isEquality()) {
+      words.push(SortHelper::getEqualityArgumentSort(lit));
+    }
+    for (TermList* arg = lit->args(); !arg->isEmpty(); arg = arg->next()) {
+      writeTerm(*arg, words);
+    }
+    (*cl)[i] = 0;
+  }
+
+  long freed = _fileEnd-_spilledSize;
+  if (freed > _spilledSize && freed >= MIN_COMPACTED_SIZE) {
+    compact();
+  }
+  writeWords(_fileEnd, words.size(), words.begin());
+
+  if (_weightRatio) {
+    _weightKeys.insert(key);
+  }
+  if (_ageRatio) {
+    _ageKeys.insert(key);
+  }
+  SpillSlot slot;
+  slot.clause = cl;
+  slot.key = key;
+  slot.offset = _fileEnd;
+  slot.size = words.size();
+  ALWAYS(_spilled.insert(cl->number(), slot));
+  _fileEnd += words.size()*sizeof(unsigned);
+  _spilledSize += words.size()*sizeof(unsigned);
+
+  env.statistics->passiveClausesSpilled++;
+}
+
+/**
+ * Read the literals of the spilled clause with number @b number back to
+ * the clause and return it. The clause is not added to the queues.
+ */
+Clause* SpillingPassiveClauseContainer::reload(unsigned number)
+{
+  CALL("SpillingPassiveClauseContainer::reload");
+
+  SpillSlot slot;
+  ALWAYS(_spilled.pop(number, slot));
+
+  static DArray<unsigned> words;
+  words.ensure(slot.size);
+  readWords(slot.offset, slot.size, words.begin());
+  _spilledSize -= slot.size*sizeof(unsigned);
+
+  Clause* cl = slot.clause;
+  const unsigned* in = words.begin();
+  unsigned clen = cl->length();
+  for (unsigned i = 0; i < clen; i++) {
+    ASS_EQ((*cl)[i], 0);
+    unsigned header = *in++;
+    unsigned pred = header/2;
+    bool polarity = header & 1;
+    if (pred == 0) {
+      unsigned sort = *in++;
+      TermList lhs = readTerm(in);
+      TermList rhs = readTerm(in);
+      (*cl)[i] = Literal::createEquality(polarity, lhs, rhs, sort);
+      continue;
+    }
+    unsigned arity = env.signature->getPredicate(pred)->arity();
+    Stack<TermList> args(arity);
+    for (unsigned j = 0; j < arity; j++) {
+      args.push(readTerm(in));
+    }
+    (*cl)[i] = Literal::create(pred, arity, polarity, false, args.begin());
+  }
+  ASS_EQ(in, words.begin()+slot.size);
+
+  if (_spilled.isEmpty()) {
+    //nothing in the file is needed any more and all keys are stale
+    ASS_EQ(_spilledSize, 0);
+    _fileEnd = 0;
+    _weightKeys.reset();
+    _ageKeys.reset();
+  }
+  return cl;
+}
+
+/**
+ * Move the literals of the spilled clauses to the beginning of the file,
+ * over the parts of the clauses reloaded meanwhile, so that the next
+ * clauses are written there.
+ */
+void SpillingPassiveClauseContainer::compact()
+{
+  CALL("SpillingPassiveClauseContainer::compact");
+
+  static Stack<SpillSlot*> slots;
+  slots.reset();
+  DHMap<unsigned,SpillSlot>::Iterator sit(_spilled);
+  while (sit.hasNext()) {
+    slots.push(&_spilled.get(sit.nextKey()));
+  }
+  std::sort(slots.begin(), slots.end(), [](SpillSlot* s1, SpillSlot* s2) {
+    return s1->offset < s2->offset;
+  });
+
+  //every slot moves towards the beginning, so it does not overwrite
+  //a slot that has not been moved yet
+  static DArray<unsigned> words;
+  long end = 0;
+  for (unsigned i = 0; i < slots.size(); i++) {
+    SpillSlot* slot = slots[i];
+    if (slot->offset != end) {
+      words.ensure(slot->size);
+      readWords(slot->offset, slot->size, words.begin());
+      writeWords(end, slot->size, words.begin());
+      slot->offset = end;
+    }
+    end += slot->size*sizeof(unsigned);
+  }
+  ASS_EQ(end, _spilledSize);
+  _fileEnd = end;
+  env.statistics->spillFileCompactions++;
+}
+
+/**
+ * Read @b size words at @b offset of the file to @b out.
+ */
+void SpillingPassiveClauseContainer::readWords(long offset, unsigned size, unsigned* out)
+{
+  CALL("SpillingPassiveClauseContainer::readWords");
+
+  if (std::fflush(_file) || std::fseek(_file, offset, SEEK_SET) || std::fread(out, sizeof(unsigned), size, _file) != size) {
+    SYSTEM_FAIL("Cannot read a passive clause from the spill file", errno);
+  }
+}
+
+/**
+ * Write @b size words from @b in at @b offset of the file.
+ */
+void SpillingPassiveClauseContainer::writeWords(long offset, unsigned size, const unsigned* in)
+{
+  CALL("SpillingPassiveClauseContainer::writeWords");
+
+  if (std::fseek(_file, offset, SEEK_SET) || std::fwrite(in, sizeof(unsigned), size, _file) != size) {
+    SYSTEM_FAIL("Cannot write a passive clause to the spill file", errno);
+  }
+}
+
+/**
+ * Return the key of the best clause spilled in the weight or in the
+ * age order, dropping keys of clauses that were already reloaded.
+ * There must be a spilled clause.
+ */
+SpillingPassiveClauseContainer::SpillKey SpillingPassiveClauseContainer::topKey(bool byWeight)
+{
+  CALL("SpillingPassiveClauseContainer::topKey");
+  ASS(!_spilled.isEmpty());
+
+  if (byWeight) {
+    while (!_spilled.find(_weightKeys.top().number)) {
+      _weightKeys.pop();
+    }
+    return _weightKeys.top();
+  }
+  while (!_spilled.find(_ageKeys.top().number)) {
+    _ageKeys.pop();
+  }
+  return _ageKeys.top();
+}
+
+/**
+ * If the best spilled clause in the order used for the coming selection
+ * precedes the head of the corresponding queue, read it back and put it
+ * to the queues, so that it is the one selected.
+ */
+void SpillingPassiveClauseContainer::prepareSelection(bool byWeight)
+{
+  CALL("SpillingPassiveClauseContainer::prepareSelection");
+
+  if (_spilled.isEmpty()) {
+    return;
+  }
+  SpillKey best = topKey(byWeight);
+
+  ClauseQueue& queue = byWeight ? static_cast<ClauseQueue&>(_weightQueue) : static_cast<ClauseQueue&>(_ageQueue);
+  if (!queue.isEmpty()) {
+    ClauseQueue::Iterator qit(queue);
+    SpillKey head(qit.next(), _opt);
+    Comparison cmp = byWeight ? WeightKeyComparator::compare(best, head) : AgeKeyComparator::compare(best, head);
+    if (cmp != LESS) {
+      return;
+    }
+  }
+
+  Clause* cl = reload(best.number);
+  env.statistics->passiveClausesReloaded++;
+  if (_ageRatio) {
+    _ageQueue.insert(cl);
+  }
+  if (_weightRatio) {
+    _weightQueue.insert(cl);
+  }
+  _size++;
+}
+
+}
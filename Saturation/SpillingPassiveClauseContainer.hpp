@@ -0,0 +1,154 @@
+/*
+ * File SpillingPassiveClauseContainer.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SpillingPassiveClauseContainer.hpp
+ * Defines the class SpillingPassiveClauseContainer
+ */
+
+#ifndef __SpillingPassiveClauseContainer__
+#define __SpillingPassiveClauseContainer__
+
+#include <cstdio>
+
+#include "Lib/BinaryHeap.hpp"
+#include "Lib/Comparison.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Inference.hpp"
+
+#include "AWPassiveClauseContainer.hpp"
+
+namespace Saturation {
+
+using namespace Kernel;
+
+/**
+ * Age-weight passive container that keeps at most a given number of
+ * clauses in its queues.
+ *
+ * When the budget is exceeded, the literals of newly added clauses are
+ * written to a temporary file, the literals of the clause objects are set
+ * to 0, and only the selection keys of the clauses are kept in heaps. The
+ * clause objects themselves stay valid, so the pointers to them and their
+ * inferences remain usable, and @b iterator() returns them, with the
+ * literals set to 0. Their literals are not kept alive by them, so the term
+ * garbage collection may free them, which is why the options require it. A spilled clause is read back just
+ * before it would be selected, so the order of selection is the same as in
+ * the AWPassiveClauseContainer. The parts of the file freed by reloaded
+ * clauses are reused by moving the remaining literals to the beginning
+ * of the file when the freed parts take more than the remaining ones.
+ *
+ * Only clauses that do not depend on splits are spilled, because the
+ * Splitter inspects the other ones. For the same reason the container
+ * must not be used when passive clauses are indexed, which is the case
+ * in Otter and LRS.
+ */
+class SpillingPassiveClauseContainer
+: public AWPassiveClauseContainer
+{
+public:
+  CLASS_NAME(SpillingPassiveClauseContainer);
+  USE_ALLOCATOR(SpillingPassiveClauseContainer);
+
+  SpillingPassiveClauseContainer(bool isOutermost, const Shell::Options& opt, vstring name);
+  ~SpillingPassiveClauseContainer();
+
+  void add(Clause* cl) override;
+  void remove(Clause* cl) override;
+
+  /** True if there are no passive clauses */
+  bool isEmpty() const override
+  { return AWPassiveClauseContainer::isEmpty() && _spilled.isEmpty(); }
+
+  unsigned sizeEstimate() const override
+  { return AWPassiveClauseContainer::sizeEstimate() + _spilled.size(); }
+
+  ClauseIterator iterator() override;
+  unsigned evictHeaviest(unsigned cnt) override;
+
+protected:
+  void prepareSelection(bool byWeight) override;
+
+private:
+  /** Selection keys of a spilled clause, see AgeQueue and WeightQueue */
+  struct SpillKey
+  {
+    SpillKey() : weight(0), age(0), inputType(UnitInputType::AXIOM), number(0) {}
+    SpillKey(Clause* cl, const Shell::Options& opt);
+
+    unsigned weight;
+    unsigned age;
+    UnitInputType inputType;
+    unsigned number;
+  };
+  /** Comparator for a BinaryHeap ordered as the WeightQueue */
+  struct WeightKeyComparator
+  {
+    static Comparison compare(const SpillKey& k1, const SpillKey& k2);
+  };
+  /** Comparator for a BinaryHeap ordered as the AgeQueue */
+  struct AgeKeyComparator
+  {
+    static Comparison compare(const SpillKey& k1, const SpillKey& k2);
+  };
+  /** A spilled clause and the position of its literals in the file */
+  struct SpillSlot
+  {
+    SpillSlot() : clause(0), offset(0), size(0) {}
+
+    Clause* clause;
+    SpillKey key;
+    long offset;
+    /** Number of words the literals take in the file */
+    unsigned size;
+  };
+
+  void spill(Clause* cl);
+  Clause* reload(unsigned number);
+  void compact();
+  void readWords(long offset, unsigned size, unsigned* out);
+  void writeWords(long offset, unsigned size, const unsigned* in);
+  SpillKey topKey(bool byWeight);
+
+  static void writeTerm(TermList t, Stack<unsigned>& out);
+  static TermList readTerm(const unsigned*& in);
+
+  /** Maximal number of clauses kept in memory */
+  unsigned _budget;
+  /**
+   * Keys of spilled clauses in the weight and age orders. An entry whose
+   * clause is no longer in @b _spilled has been reloaded through the other
+   * heap (or evicted) and is skipped.
+   */
+  BinaryHeap<SpillKey,WeightKeyComparator> _weightKeys;
+  BinaryHeap<SpillKey,AgeKeyComparator> _ageKeys;
+  /** Spilled clauses by their number */
+  DHMap<unsigned,SpillSlot> _spilled;
+
+  /** The temporary file, created on the first spill */
+  std::FILE* _file;
+  /** Offset where the next clause is written */
+  long _fileEnd;
+  /** Number of bytes of the file taken by the literals of the spilled clauses */
+  long _spilledSize;
+}; // class SpillingPassiveClauseContainer
+
+};
+
+#endif /* __SpillingPassiveClauseContainer__ */
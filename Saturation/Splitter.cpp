@@ -36,6 +36,7 @@
 #include "Kernel/Clause.hpp"
 #include "Kernel/Inference.hpp"
 #include "Kernel/RCClauseStack.hpp"
+#include "Kernel/SubstHelper.hpp"
 #include "Kernel/TermIterators.hpp"
 #include "Kernel/Formula.hpp"
 #include "Kernel/FormulaUnit.hpp"
@@ -654,7 +655,7 @@ vstring Splitter::splPrefix = "";
 
 Splitter::Splitter()
 : _deleteDeactivated(Options::SplittingDeleteDeactivated::ON), _branchSelector(*this),
-  _clausesAdded(false), _haveBranchRefutation(false)
+  _clausesAdded(false), _haveBranchRefutation(false), _recordSplitFreeSplits(false)
 {
   CALL("Splitter::Splitter");
   if(env.options->proof()==Options::Proof::TPTP){
@@ -716,8 +717,11 @@ void Splitter::init(SaturationAlgorithm* sa)
 
   _fastRestart = opts.splittingFastRestart();
   _deleteDeactivated = opts.splittingDeleteDeactivated();
+  _recordSplitFreeSplits = !opts.checkpointFile().empty();
 
-  if (opts.useHashingVariantIndex()) {
+  if (opts.useFingerprintVariantIndex()) {
+    _componentIdx = new FingerprintClauseVariantIndex();
+  } else if (opts.useHashingVariantIndex()) {
     _componentIdx = new HashingClauseVariantIndex();
   } else {
     _componentIdx = new SubstitutionTreeClauseVariantIndex();
@@ -963,6 +967,10 @@ bool Splitter::handleNonSplittable(Clause* cl)
 
     SATClause* nsClause = SATClause::fromStack(satLits);
 
+    if (_recordSplitFreeSplits && cl->noSplits()) {
+      _splitFreeSplits.insert(SplitSet::getSingleton(compName));
+    }
+
     UnitList* ps = 0;
 
     FormulaList* resLst=0;
@@ -1118,6 +1126,9 @@ bool Splitter::doSplitting(Clause* cl)
   // Add literals for existing constraints 
   collectDependenceLits(cl->splits(), satClauseLits);
 
+  static SplitLevelStack compNames;
+  compNames.reset();
+
   UnitList* ps = 0;
   FormulaList* resLst=0;
 
@@ -1128,6 +1139,7 @@ bool Splitter::doSplitting(Clause* cl)
     SplitLevel compName = tryGetComponentNameOrAddNew(comp, cl, compCl);
     SATLiteral nameLit = getLiteralFromName(compName);
     satClauseLits.push(nameLit);
+    compNames.push(compName);
 
     UnitList::push(getDefinitionFromName(compName),ps);
     FormulaList::push(new NamedFormula(getFormulaStringFromName(compName)),resLst);
@@ -1156,6 +1168,10 @@ bool Splitter::doSplitting(Clause* cl)
 
   splitClause->setInference(new FOConversionInference(scl));
 
+  if (_recordSplitFreeSplits && cl->noSplits()) {
+    _splitFreeSplits.insert(SplitSet::getFromArray(compNames.begin(), compNames.size()));
+  }
+
   addSatClauseToSolver(splitClause, false);
 
   env.statistics->satSplits++;
@@ -1800,6 +1816,114 @@ void Splitter::removeComponents(const SplitLevelStack& toRemove)
   }
 }
 
+/**
+ * Push on @b acc the clauses that are currently frozen, i.e. that were
+ * only conditionally reduced and would be put back on backtracking
+ * (see @b removeComponents()).
+ *
+ * A clause may appear more than once.
+ */
+void Splitter::collectConditionallyReducedClauses(ClauseStack& acc)
+{
+  CALL("Splitter::collectConditionallyReducedClauses");
+
+  for (SplitLevel lvl = 0; lvl < _db.size(); lvl++) {
+    SplitRecord* sr = _db[lvl];
+    if (!sr) {
+      continue;
+    }
+    Stack<ReductionRecord>::Iterator rit(sr->reduced);
+    while (rit.hasNext()) {
+      ReductionRecord rrec = rit.next();
+      if (rrec.clause->validReductionRecord(rrec.timestamp)) {
+        acc.push(rrec.clause);
+      }
+    }
+  }
+}
+
+/**
+ * Push on @b acc the clauses the splitter refers to: the components,
+ * the clauses depending on them, the reduced clauses (whether or not
+ * their reductions are still valid) and the clauses waiting to be added.
+ *
+ * Used to find the terms that are still in use, see
+ * SaturationAlgorithm::collectTermGarbage(). A clause may appear more
+ * than once.
+ */
+void Splitter::collectClauses(ClauseStack& acc)
+{
+  CALL("Splitter::collectClauses");
+
+  for (SplitLevel lvl = 0; lvl < _db.size(); lvl++) {
+    SplitRecord* sr = _db[lvl];
+    if (!sr) {
+      continue;
+    }
+    acc.push(sr->component);
+    acc.loadFromIterator(RCClauseStack::Iterator(sr->children));
+    Stack<ReductionRecord>::Iterator rit(sr->reduced);
+    while (rit.hasNext()) {
+      acc.push(rit.next().clause);
+    }
+  }
+  acc.loadFromIterator(RCClauseStack::Iterator(_fastClauses));
+}
+
+/** Renames the variables of a component apart from those of the previous ones */
+struct VariableShifter
+{
+  VariableShifter(unsigned offset) : offset(offset) {}
+  TermList apply(unsigned var) { return TermList(var+offset, false); }
+  unsigned offset;
+};
+
+/**
+ * Push on @b acc the split-free clauses this splitter took over: the
+ * clauses waiting for a fast restart, and for each set of components
+ * that split-free clauses were replaced by, the clause made of these
+ * components with their variables renamed apart.
+ *
+ * A set of components stands for all the clauses split into it, which
+ * are variants of each other, so the clauses themselves need not be
+ * kept. The sets are only recorded if checkpoints are written.
+ */
+void Splitter::collectSplitFreeSplitClauses(RCClauseStack& acc)
+{
+  CALL("Splitter::collectSplitFreeSplitClauses");
+  ASS(_recordSplitFreeSplits);
+
+  RCClauseStack::Iterator fit(_fastClauses);
+  while (fit.hasNext()) {
+    Clause* cl = fit.next();
+    if (cl->noSplits()) {
+      acc.push(cl);
+    }
+  }
+
+  static LiteralStack lits;
+  DHSet<SplitSet*>::Iterator sit(_splitFreeSplits);
+  while (sit.hasNext()) {
+    SplitSet* names = sit.next();
+    lits.reset();
+    unsigned offset = 0;
+    bool fromGoal = false;
+    SplitSet::Iterator nit(*names);
+    while (nit.hasNext()) {
+      Clause* comp = getComponentClause(nit.next());
+      fromGoal |= comp->derivedFromGoal();
+      VariableShifter shifter(offset);
+      for (unsigned i = 0; i < comp->length(); i++) {
+        lits.push(SubstHelper::apply((*comp)[i], shifter));
+      }
+      offset += comp->maxVar()+1;
+    }
+    Clause* cl = Clause::fromStack(lits, NonspecificInference0(
+        fromGoal ? UnitInputType::NEGATED_CONJECTURE : UnitInputType::AXIOM, InferenceRule::AVATAR_SPLIT_CLAUSE));
+    acc.push(cl);
+  }
+}
+
 /**
  * Given a set of clauses (as obtained by saturation)
  * turn them into formulas capturing the semantics of splitting assertions.
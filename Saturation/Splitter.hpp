@@ -29,6 +29,7 @@
 #include "Lib/Allocator.hpp"
 #include "Lib/ArrayMap.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/ScopedPtr.hpp"
 
@@ -220,6 +221,9 @@ public:
   SAT2FO& satNaming() { return _sat2fo; }
 
   UnitList* explicateAssertionsForSaturatedClauseSet(UnitList* clauses);
+  void collectConditionallyReducedClauses(ClauseStack& acc);
+  void collectClauses(ClauseStack& acc);
+  void collectSplitFreeSplitClauses(RCClauseStack& acc);
   static bool getComponents(Clause* cl, Stack<LiteralStack>& acc);
 private:
   friend class SplittingBranchSelector;
@@ -304,6 +308,14 @@ private:
    * and will invariably change the SAT model.
    */
   RCClauseStack _fastClauses;
+
+  /** True if @b _splitFreeSplits is kept, which is done when checkpoints are written */
+  bool _recordSplitFreeSplits;
+  /**
+   * Sets of names of components that split-free clauses were replaced by,
+   * see @b collectSplitFreeSplitClauses()
+   */
+  DHSet<SplitSet*> _splitFreeSplits;
   
   SaturationAlgorithm* _sa;
 
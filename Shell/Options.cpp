@@ -324,6 +324,13 @@ void Options::Options::init()
     _lookup.insert(&_statistics);
     _statistics.tag(OptionTag::OUTPUT);
 
+    _indexStatistics = ChoiceOptionValue<IndexStatistics>("index_statistics","istat",IndexStatistics::OFF,{"off","text","json"});
+    _indexStatistics.description="Collect retrieval statistics of each index used by saturation (queries, candidates returned, "
+      "candidates accepted by the inference, query latencies and memory per clause) and report them with the other statistics, "
+      "either as text or as one JSON object per index. Timing the queries slows the retrievals down.";
+    _lookup.insert(&_indexStatistics);
+    _indexStatistics.tag(OptionTag::OUTPUT);
+
     _testId = StringOptionValue("test_id","","unspecified_test");
     _testId.description="";
     _lookup.insert(&_testId);
@@ -1004,6 +1011,190 @@ void Options::Options::init()
     _positiveLiteralSplitQueueLayeredArrangement.tag(OptionTag::SATURATION);
     _positiveLiteralSplitQueueLayeredArrangement.setExperimental();
 
+    _forwardSimplificationBatch = UnsignedOptionValue("forward_simplification_batch","fsb",1);
+    _forwardSimplificationBatch.description = "Number of unprocessed clauses that are forward simplified together. "
+      "All clauses of a batch are simplified against the simplifying clauses as they were when the batch was taken "
+      "and the retained ones are then moved to passive in the order in which they were taken from unprocessed. "
+      "1 means that every clause enters passive before the next one is simplified.";
+    _lookup.insert(&_forwardSimplificationBatch);
+    _forwardSimplificationBatch.tag(OptionTag::SATURATION);
+    _forwardSimplificationBatch.addConstraint(greaterThan(0u));
+    _forwardSimplificationBatch.setExperimental();
+
+    _backwardSimplificationBatch = UnsignedOptionValue("backward_simplification_batch","bsb",1);
+    _backwardSimplificationBatch.description = "Number of retained clauses collected before backward simplification "
+      "is done with all of them together, which lets backward demodulation traverse the index once for unit equalities "
+      "whose left-hand sides share the top symbol. The collected clauses are also processed whenever unprocessed "
+      "becomes empty. 1 means that every retained clause is used for backward simplification immediately. "
+      "Only for otter and lrs: discount uses a clause for backward simplification right before activating it, "
+      "so a batch would hold just that clause and be processed only after its inferences were generated.";
+    _lookup.insert(&_backwardSimplificationBatch);
+    _backwardSimplificationBatch.tag(OptionTag::SATURATION);
+    _backwardSimplificationBatch.addConstraint(greaterThan(0u));
+    _backwardSimplificationBatch.addHardConstraint(If(greaterThan(1u)).then(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::DISCOUNT))));
+    _backwardSimplificationBatch.setExperimental();
+
+    _memoryPressureWatermark = UnsignedOptionValue("memory_pressure_watermark","mpw",0);
+    _memoryPressureWatermark.description = "Percentage of the memory limit at which saturation starts freeing memory "
+      "instead of running into the limit: it releases the inference records when no proof is output, switches off "
+      "backward simplification, and then tightens the passive limits and evicts the heaviest passive clauses "
+      "(which makes the proof search incomplete). 0 means never. The memory in use is measured by Vampire's own "
+      "allocator, so the option has no effect in builds with USE_SYSTEM_ALLOCATION.";
+    _lookup.insert(&_memoryPressureWatermark);
+    _memoryPressureWatermark.tag(OptionTag::SATURATION);
+    _memoryPressureWatermark.addConstraint(lessThan(100u));
+    _memoryPressureWatermark.setExperimental();
+
+    _reclaimDeletedClauses = BoolOptionValue("reclaim_deleted_clauses","rdc",false);
+    _reclaimDeletedClauses.description = "Forget the premises of every clause that enters passive, so that deleted clauses "
+      "are freed as soon as nothing else refers to them instead of being kept for the proof. "
+      "Requires the proof output to be off.";
+    _lookup.insert(&_reclaimDeletedClauses);
+    _reclaimDeletedClauses.tag(OptionTag::SATURATION);
+    _reclaimDeletedClauses.addHardConstraint(If(equal(true)).then(_proof.is(equal(Proof::OFF))));
+    _reclaimDeletedClauses.setExperimental();
+
+    _compactSubstitutionTrees = ChoiceOptionValue<CompactSubstitutionTrees>("compact_substitution_trees","cst",
+        CompactSubstitutionTrees::OFF,{"off","generating","simplifying","all"});
+    _compactSubstitutionTrees.description = "Use substitution trees with nodes stored in arrays for the literal and term "
+      "indexes of generating inferences, of simplifications, or of both. "
+      "Indexes with unification with abstraction always use the usual substitution trees.";
+    _lookup.insert(&_compactSubstitutionTrees);
+    _compactSubstitutionTrees.tag(OptionTag::SATURATION);
+    _compactSubstitutionTrees.setExperimental();
+
+    _featureVectorSubsumption = BoolOptionValue("feature_vector_subsumption","fvs",false);
+    _featureVectorSubsumption.description = "Retrieve the candidates of forward and backward subsumption by non-unit clauses "
+      "from a feature vector index instead of the literal indexes. The numbers of candidates are reported in the statistics, "
+      "so the two indexes can be compared.";
+    _lookup.insert(&_featureVectorSubsumption);
+    _featureVectorSubsumption.tag(OptionTag::SATURATION);
+    _featureVectorSubsumption.setExperimental();
+
+    _fingerprintIndexing = ChoiceOptionValue<FingerprintIndexing>("fingerprint_indexing","fpi",
+        FingerprintIndexing::OFF,{"off","superposition","demodulation","all"});
+    _fingerprintIndexing.description = "Use fingerprint indexes instead of substitution trees for the subterms of "
+      "clauses retrieved by superposition, by backward demodulation, or by both. The numbers of retrieved candidates and "
+      "of those that passed the unification or matching check are reported in the statistics.";
+    _lookup.insert(&_fingerprintIndexing);
+    _fingerprintIndexing.tag(OptionTag::SATURATION);
+    _fingerprintIndexing.setExperimental();
+
+    _demodulationLHSIndex = ChoiceOptionValue<DemodulationLHSIndex>("demodulation_lhs_index","dli",
+        DemodulationLHSIndex::DISCRIMINATION_TREE,{"code_tree","discrimination_tree"});
+    _demodulationLHSIndex.description = "The index of the left-hand sides of unit equalities used by forward demodulation: "
+      "a code tree, or a perfect discrimination tree traversing the flattened query term.";
+    _lookup.insert(&_demodulationLHSIndex);
+    _demodulationLHSIndex.tag(OptionTag::SATURATION);
+    _demodulationLHSIndex.setExperimental();
+
+    _threadedCodeTrees = BoolOptionValue("threaded_code_trees","tct",false);
+    _threadedCodeTrees.description = "Execute the code of code trees (used by forward subsumption and demodulation) with "
+      "an interpreter where each operation jumps directly to the next one, instead of one with a switch in a loop.";
+    _lookup.insert(&_threadedCodeTrees);
+    _threadedCodeTrees.tag(OptionTag::SATURATION);
+    _threadedCodeTrees.setExperimental();
+
+    _codeTreeCompactionRatio = FloatOptionValue("code_tree_compaction_ratio","ctcr",0.25);
+    _codeTreeCompactionRatio.description = "Remove the code left unreachable by removals from code trees (used by forward "
+      "subsumption and demodulation) once the ratio of their blocks with such code to the other blocks exceeds this value. "
+      "The code is removed in small steps done after removals. 0 means never.";
+    _lookup.insert(&_codeTreeCompactionRatio);
+    _codeTreeCompactionRatio.tag(OptionTag::SATURATION);
+    _codeTreeCompactionRatio.addConstraint(greaterThanEq(0.0f));
+    _codeTreeCompactionRatio.setExperimental();
+
+    _orderingCacheBits = UnsignedOptionValue("ordering_cache_bits","ocb",14);
+    _orderingCacheBits.description = "Keep the results of the last comparisons of terms by the term ordering "
+      "in a cache of 2 to the power of this many entries, where each new result replaces the one at its position. "
+      "0 means no cache.";
+    _lookup.insert(&_orderingCacheBits);
+    _orderingCacheBits.tag(OptionTag::SATURATION);
+    _orderingCacheBits.addConstraint(lessThan(25u));
+    _orderingCacheBits.setExperimental();
+
+    _termGarbageCollection = UnsignedOptionValue("term_garbage_collection","tgc",0);
+    _termGarbageCollection.description = "Free the shared terms and literals created during saturation that no live clause "
+      "refers to whenever the memory in use has grown by this many megabytes since the previous collection. "
+      "0 means never. "
+      "Requires the proof output to be off and the features that keep terms of their own (global subsumption, "
+      "induction, instantiation, question answering, AVATAR congruence closure and InstGen) to be off.";
+    _lookup.insert(&_termGarbageCollection);
+    _termGarbageCollection.tag(OptionTag::SATURATION);
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_proof.is(equal(Proof::OFF))));
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_globalSubsumption.is(equal(false))));
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_induction.is(equal(Induction::NONE))));
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_instantiation.is(equal(Instantiation::OFF))));
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_questionAnswering.is(equal(QuestionAnsweringMode::OFF))));
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::INST_GEN))));
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_splittingCongruenceClosure.is(equal(SplittingCongruenceClosure::OFF))));
+#if VZ3
+    _termGarbageCollection.addHardConstraint(If(greaterThan(0u)).then(_theoryInstAndSimp.is(equal(TheoryInstSimp::OFF))));
+#endif
+    _termGarbageCollection.setExperimental();
+
+    _sortGeneratedClauses = BoolOptionValue("sort_generated_clauses","sgc",false);
+    _sortGeneratedClauses.description = "Collect all clauses generated by one activation and pass them on sorted by weight "
+      "(and then by length and literals), so that the lightest ones are forward simplified and can simplify the rest first. "
+      "The order in which the generating inferences and their index retrievals run then does not affect the result.";
+    _lookup.insert(&_sortGeneratedClauses);
+    _sortGeneratedClauses.tag(OptionTag::SATURATION);
+    _sortGeneratedClauses.setExperimental();
+
+    _checkpointFile = StringOptionValue("checkpoint_file","","");
+    _checkpointFile.description = "If non-empty, periodically write the current clause set (active and passive clauses "
+      "together with the clauses AVATAR depends on) to this file in TPTP syntax. An interrupted proof attempt can then be "
+      "resumed by running vampire on the file. The file is replaced atomically, so it always holds a complete checkpoint.";
+    _lookup.insert(&_checkpointFile);
+    _checkpointFile.tag(OptionTag::SATURATION);
+    _checkpointFile.setExperimental();
+
+    _checkpointInterval = UnsignedOptionValue("checkpoint_interval","",60);
+    _checkpointInterval.description = "Number of seconds between two checkpoints written to checkpoint_file. "
+      "0 means a checkpoint is written after every clause selection (only useful for debugging). "
+      "With AVATAR, each checkpoint builds Clause objects for the clauses the splitting depends on, which use up "
+      "clause numbers, so the clauses of a run with checkpoints are numbered differently than without them.";
+    _lookup.insert(&_checkpointInterval);
+    _checkpointInterval.tag(OptionTag::SATURATION);
+    _checkpointInterval.setExperimental();
+    _checkpointInterval.reliesOn(_checkpointFile.is(notEqual(vstring(""))));
+
+    _passiveSpillBudget = UnsignedOptionValue("passive_spill_budget","",0);
+    _passiveSpillBudget.description = "Maximal number of passive clauses kept in memory by each age-weight queue. "
+      "The literals of further clauses that do not depend on splits are written to a temporary file, so that the "
+      "terms only they use can be freed by term_garbage_collection; the literals are read back when the clause is about "
+      "to be selected. 0 means no limit. "
+      "Only supported with the discount saturation algorithm, where passive clauses are not indexed, and with "
+      "term_garbage_collection, without which the spilled literals stay in memory.";
+    _lookup.insert(&_passiveSpillBudget);
+    _passiveSpillBudget.tag(OptionTag::SATURATION);
+    _passiveSpillBudget.setExperimental();
+    _passiveSpillBudget.addHardConstraint(If(greaterThan(0u)).then(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT))));
+    _passiveSpillBudget.addHardConstraint(If(greaterThan(0u)).then(_checkpointFile.is(equal(vstring("")))));
+    _passiveSpillBudget.addHardConstraint(If(greaterThan(0u)).then(_termGarbageCollection.is(notEqual(0u))));
+    _passiveSpillBudget.addHardConstraint(If(greaterThan(0u)).then(_proof.is(equal(Proof::OFF))));
+
+    _lazyClauseMaterialization = BoolOptionValue("lazy_clause_materialization","lzcm",false);
+    _lazyClauseMaterialization.description = "Instead of building the conclusions of superposition and binary resolution, "
+      "keep their premises and build a conclusion only when it could be selected from passive, "
+      "which is judged by its age and an estimate of its weight. "
+      "Conclusions whose premises stopped being active are never built.";
+    _lookup.insert(&_lazyClauseMaterialization);
+    _lazyClauseMaterialization.tag(OptionTag::SATURATION);
+    _lazyClauseMaterialization.setExperimental();
+    _lazyClauseMaterialization.addHardConstraint(If(equal(true)).then(_checkpointFile.is(equal(vstring("")))));
+
+    _passiveQueue = ChoiceOptionValue<PassiveQueue>("passive_queue","pq",PassiveQueue::SKIP_LIST,{"skip_list","heap"});
+    _passiveQueue.description = "Data structure of the age and weight queues of passive clauses. "
+      "The heap caches the selection keys of clauses and removes clauses lazily; "
+      "it does not support LRS limits and changing the age-weight ratio.";
+    _lookup.insert(&_passiveQueue);
+    _passiveQueue.tag(OptionTag::SATURATION);
+    _passiveQueue.setExperimental();
+    _passiveQueue.addHardConstraint(If(equal(PassiveQueue::HEAP)).then(_saturationAlgorithm.is(notEqual(SaturationAlgorithm::LRS))));
+    _passiveQueue.addHardConstraint(If(equal(PassiveQueue::HEAP)).then(_ageWeightRatioShape.is(equal(AgeWeightRatioShape::CONSTANT))));
+    _passiveQueue.addHardConstraint(If(equal(PassiveQueue::HEAP)).then(_passiveSpillBudget.is(equal(0u))));
+
 	    _literalMaximalityAftercheck = BoolOptionValue("literal_maximality_aftercheck","lma",false);
 	    _lookup.insert(&_literalMaximalityAftercheck);
 	    _literalMaximalityAftercheck.tag(OptionTag::SATURATION);
@@ -1023,6 +1214,17 @@ void Options::Options::init()
       _lookup.insert(&_lrsWeightLimitOnly);
       _lrsWeightLimitOnly.tag(OptionTag::LRS);
 
+      _lrsEstimator = ChoiceOptionValue<LrsEstimator>("lrs_estimator","lrse",LrsEstimator::LINEAR,{"linear","throughput"});
+      _lrsEstimator.description=
+      "How the LRS algorithm estimates the number of clauses it can still activate. "
+      "linear assumes the average activation rate of the whole run stays the same. "
+      "throughput measures the recent time spent on generating and on simplifying per activation, "
+      "extrapolates the growth of the simplification time, and also takes into account "
+      "the recent memory use per activation and the memory limit.";
+      _lookup.insert(&_lrsEstimator);
+      _lrsEstimator.tag(OptionTag::LRS);
+      _lrsEstimator.setExperimental();
+
       _simulatedTimeLimit = TimeLimitOptionValue("simulated_time_limit","stl",0);
       _simulatedTimeLimit.description=
       "Time limit in seconds for the purpose of reachability estimations of the LRS saturation algorithm (if 0, the actual time limit is used)";
@@ -1527,6 +1729,14 @@ void Options::Options::init()
     _useHashingVariantIndex.setExperimental();
     _useHashingVariantIndex.setRandomChoices({"on","off"});
 
+    _useFingerprintVariantIndex = BoolOptionValue("use_fingerprint_clause_variant_index","ufcvi",false);
+    _useFingerprintVariantIndex.description= "Use clause variant index based on 64-bit fingerprints stored in an open-addressing "
+      "hash table for clause variant detection (affects inst_gen and avatar). Takes precedence over use_hashing_clause_variant_index.";
+    _lookup.insert(&_useFingerprintVariantIndex);
+    _useFingerprintVariantIndex.tag(OptionTag::OTHER);
+    _useFingerprintVariantIndex.setExperimental();
+    _useFingerprintVariantIndex.setRandomChoices({"on","off"});
+
     /*
     _use_dm = BoolOptionValue("use_dismatching","dm",false);
     _use_dm.description="Use dismatching constraints.";
@@ -1904,6 +2114,7 @@ void Options::Options::init()
                                                                   {"answer_literal","from_proof","off"});
     _questionAnswering.description="Determines whether (and how) we attempt to answer questions";
     _questionAnswering.addHardConstraint(If(notEqual(QuestionAnsweringMode::OFF)).then(_splitting.is(notEqual(true))));
+    _questionAnswering.addHardConstraint(If(notEqual(QuestionAnsweringMode::OFF)).then(_reclaimDeletedClauses.is(notEqual(true))));
     _lookup.insert(&_questionAnswering);
     _questionAnswering.tag(OptionTag::OTHER);
 
@@ -503,6 +503,12 @@ public:
     NONE = 2
   };
 
+  enum class IndexStatistics : unsigned int {
+    OFF,
+    TEXT,
+    JSON
+  };
+
   /** how much we want vampire talking and in what language */
   enum class Output : unsigned int {
     SMTCOMP,
@@ -759,6 +765,35 @@ public:
     CONVERGE
   };
 
+  enum class PassiveQueue {
+    SKIP_LIST,
+    HEAP
+  };
+
+  enum class LrsEstimator {
+    LINEAR,
+    THROUGHPUT
+  };
+
+  enum class CompactSubstitutionTrees {
+    OFF,
+    GENERATING,
+    SIMPLIFYING,
+    ALL
+  };
+
+  enum class FingerprintIndexing {
+    OFF,
+    SUPERPOSITION,
+    DEMODULATION,
+    ALL
+  };
+
+  enum class DemodulationLHSIndex {
+    CODE_TREE,
+    DISCRIMINATION_TREE
+  };
+
     //==========================================================
     // The Internals
     //==========================================================
@@ -1838,6 +1873,7 @@ public:
   vstring protectedPrefix() const { return _protectedPrefix.actualValue; }
   Statistics statistics() const { return _statistics.actualValue; }
   void setStatistics(Statistics newVal) { _statistics.actualValue=newVal; }
+  IndexStatistics indexStatistics() const { return _indexStatistics.actualValue; }
   Proof proof() const { return _proof.actualValue; }
   bool minimizeSatProofs() const { return _minimizeSatProofs.actualValue; }
   ProofExtra proofExtra() const { return _proofExtra.actualValue; }
@@ -1964,9 +2000,28 @@ public:
   bool backwardSubsumptionDemodulation() const { return _backwardSubsumptionDemodulation.actualValue; }
   unsigned backwardSubsumptionDemodulationMaxMatches() const { return _backwardSubsumptionDemodulationMaxMatches.actualValue; }
   bool forwardSubsumption() const { return _forwardSubsumption.actualValue; }
+  unsigned forwardSimplificationBatch() const { return _forwardSimplificationBatch.actualValue; }
+  unsigned backwardSimplificationBatch() const { return _backwardSimplificationBatch.actualValue; }
+  unsigned memoryPressureWatermark() const { return _memoryPressureWatermark.actualValue; }
+  bool reclaimDeletedClauses() const { return _reclaimDeletedClauses.actualValue; }
+  CompactSubstitutionTrees compactSubstitutionTrees() const { return _compactSubstitutionTrees.actualValue; }
+  bool featureVectorSubsumption() const { return _featureVectorSubsumption.actualValue; }
+  FingerprintIndexing fingerprintIndexing() const { return _fingerprintIndexing.actualValue; }
+  DemodulationLHSIndex demodulationLHSIndex() const { return _demodulationLHSIndex.actualValue; }
+  bool threadedCodeTrees() const { return _threadedCodeTrees.actualValue; }
+  float codeTreeCompactionRatio() const { return _codeTreeCompactionRatio.actualValue; }
+  unsigned orderingCacheBits() const { return _orderingCacheBits.actualValue; }
+  unsigned termGarbageCollection() const { return _termGarbageCollection.actualValue; }
+  bool sortGeneratedClauses() const { return _sortGeneratedClauses.actualValue; }
+  vstring checkpointFile() const { return _checkpointFile.actualValue; }
+  unsigned checkpointInterval() const { return _checkpointInterval.actualValue; }
+  unsigned passiveSpillBudget() const { return _passiveSpillBudget.actualValue; }
+  bool lazyClauseMaterialization() const { return _lazyClauseMaterialization.actualValue; }
+  PassiveQueue passiveQueue() const { return _passiveQueue.actualValue; }
   bool forwardLiteralRewriting() const { return _forwardLiteralRewriting.actualValue; }
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
+  LrsEstimator lrsEstimator() const { return _lrsEstimator.actualValue; }
   int lookaheadDelay() const { return _lookaheadDelay.actualValue; }
   int simulatedTimeLimit() const { return _simulatedTimeLimit.actualValue; }
   void setSimulatedTimeLimit(int newVal) { _simulatedTimeLimit.actualValue = newVal; }
@@ -2092,6 +2147,7 @@ public:
   int instGenSelection() const { return _instGenSelection.actualValue; }
   bool instGenWithResolution() const { return _instGenWithResolution.actualValue; }
   bool useHashingVariantIndex() const { return _useHashingVariantIndex.actualValue; }
+  bool useFingerprintVariantIndex() const { return _useFingerprintVariantIndex.actualValue; }
 
   float satClauseActivityDecay() const { return _satClauseActivityDecay.actualValue; }
   SatClauseDisposer satClauseDisposer() const { return _satClauseDisposer.actualValue; }
@@ -2345,6 +2401,24 @@ private:
   BoolOptionValue _forwardSubsumptionResolution;
   BoolOptionValue _forwardSubsumptionDemodulation;
   UnsignedOptionValue _forwardSubsumptionDemodulationMaxMatches;
+  UnsignedOptionValue _forwardSimplificationBatch;
+  UnsignedOptionValue _backwardSimplificationBatch;
+  UnsignedOptionValue _memoryPressureWatermark;
+  BoolOptionValue _reclaimDeletedClauses;
+  ChoiceOptionValue<CompactSubstitutionTrees> _compactSubstitutionTrees;
+  BoolOptionValue _featureVectorSubsumption;
+  ChoiceOptionValue<FingerprintIndexing> _fingerprintIndexing;
+  ChoiceOptionValue<DemodulationLHSIndex> _demodulationLHSIndex;
+  BoolOptionValue _threadedCodeTrees;
+  FloatOptionValue _codeTreeCompactionRatio;
+  UnsignedOptionValue _orderingCacheBits;
+  UnsignedOptionValue _termGarbageCollection;
+  BoolOptionValue _sortGeneratedClauses;
+  StringOptionValue _checkpointFile;
+  UnsignedOptionValue _checkpointInterval;
+  UnsignedOptionValue _passiveSpillBudget;
+  BoolOptionValue _lazyClauseMaterialization;
+  ChoiceOptionValue<PassiveQueue> _passiveQueue;
   ChoiceOptionValue<FunctionDefinitionElimination> _functionDefinitionElimination;
   IntOptionValue _functionNumber;
   
@@ -2385,6 +2459,7 @@ private:
   FloatOptionValue _instGenRestartPeriodQuotient;
   BoolOptionValue _instGenWithResolution;
   BoolOptionValue _useHashingVariantIndex;
+  BoolOptionValue _useFingerprintVariantIndex;
   BoolOptionValue _interpretedSimplification;
 
   ChoiceOptionValue<Induction> _induction;
@@ -2406,6 +2481,7 @@ private:
   IntOptionValue _lookaheadDelay;
   IntOptionValue _lrsFirstTimeCheck;
   BoolOptionValue _lrsWeightLimitOnly;
+  ChoiceOptionValue<LrsEstimator> _lrsEstimator;
   ChoiceOptionValue<LTBLearning> _ltbLearning;
   StringOptionValue _ltbDirectory;
 
@@ -2520,6 +2596,7 @@ private:
   BoolOptionValue _splittingBufferedSolver;
 
   ChoiceOptionValue<Statistics> _statistics;
+  ChoiceOptionValue<IndexStatistics> _indexStatistics;
   BoolOptionValue _superpositionFromVariables;
   ChoiceOptionValue<TermOrdering> _termOrdering;
   ChoiceOptionValue<SymbolPrecedence> _symbolPrecedence;
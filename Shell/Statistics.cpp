@@ -32,6 +32,9 @@
 #include "Lib/TimeCounter.hpp"
 #include "Lib/Timer.hpp"
 
+#include "Indexing/IndexStatistics.hpp"
+#include "Indexing/TermSharing.hpp"
+
 #include "Shell/UIHelper.hpp"
 
 #include "Saturation/SaturationAlgorithm.hpp"
@@ -46,6 +49,7 @@
 
 
 using namespace Lib;
+using namespace Indexing;
 using namespace Saturation;
 using namespace Shell;
 
@@ -113,6 +117,8 @@ Statistics::Statistics()
     equationalTautologies(0),
     forwardSubsumed(0),
     backwardSubsumed(0),
+    forwardSubsumptionCandidates(0),
+    backwardSubsumptionCandidates(0),
     taDistinctnessSimplifications(0),
     taDistinctnessTautologyDeletions(0),
     taInjectivitySimplifications(0),
@@ -123,6 +129,30 @@ Statistics::Statistics()
     activeClauses(0),
     extensionalityClauses(0),
     discardedNonRedundantClauses(0),
+    checkpointsWritten(0),
+    passiveClausesSpilled(0),
+    passiveClausesReloaded(0),
+    spillFileCompactions(0),
+    clauseRecipes(0),
+    materializedRecipes(0),
+    backwardSimplificationBatches(0),
+    memoryPressureEvents(0),
+    memoryPressureReleasedInferences(0),
+    memoryPressureDroppedSimplifiers(0),
+    memoryPressureEvictedClauses(0),
+    reclaimedClauseMemory(0),
+    fingerprintIndexCandidates(0),
+    fingerprintIndexHits(0),
+    codeTreeBlocks(0),
+    codeTreeDeadBlocks(0),
+    codeTreeCompactedBlocks(0),
+    codeTreeCompactions(0),
+    orderingCacheHits(0),
+    orderingCacheMisses(0),
+    kboComparisonsWithoutTraversal(0),
+    termGcCollections(0),
+    termGcFreedTerms(0),
+    termGcFreedLiterals(0),
     inferencesBlockedForOrderingAftercheck(0),
     smtReturnedUnknown(false),
     smtDidNotEvaluate(false),
@@ -164,6 +194,69 @@ Statistics::Statistics()
 {
 } // Statistics::Statistics
 
+Statistics::~Statistics()
+{
+  while (indexStatistics.isNonEmpty()) {
+    delete indexStatistics.pop();
+  }
+}
+
+/**
+ * Print the retrieval statistics of the indexes, as text or as a JSON
+ * object per line, as chosen by the option index_statistics
+ */
+void Statistics::printIndexStatistics(ostream& out)
+{
+  bool json = env.options->indexStatistics()==Options::IndexStatistics::JSON;
+  if (!json) {
+    addCommentSignForSZS(out);
+    out << ">>> Index statistics" << endl;
+  }
+  for (unsigned i=0; i<indexStatistics.size(); i++) {
+    IndexStatistics* is = indexStatistics[i];
+    addCommentSignForSZS(out);
+    if (json) {
+      out << "{\"index\":\"" << is->name << "\",\"queries\":" << is->queries
+          << ",\"candidates\":" << is->candidates << ",\"accepted\":" << is->accepted
+          << ",\"clauses\":" << is->clauses << ",\"max_clauses\":" << is->maxClauses
+          << ",\"bytes_per_clause\":" << is->bytesPerClause() << ",\"latency_log2_ns\":[";
+      for (unsigned j=0; j<IndexStatistics::LATENCY_BUCKETS; j++) {
+        out << (j ? "," : "") << is->latencies[j];
+      }
+      out << "]}" << endl;
+      continue;
+    }
+    out << is->name << ": " << is->queries << " queries, " << is->candidates << " candidates, "
+        << is->accepted << " accepted" << endl;
+    addCommentSignForSZS(out);
+    out << is->name << ": " << is->clauses << " clauses (at most " << is->maxClauses << ")";
+    if (is->bytesPerClause()) {
+      out << ", " << is->bytesPerClause() << " bytes per clause";
+    }
+    out << endl;
+    if (!is->queries) {
+      continue;
+    }
+    addCommentSignForSZS(out);
+    out << is->name << ": query latencies [ns]:";
+    for (unsigned j=0; j<IndexStatistics::LATENCY_BUCKETS; j++) {
+      if (!is->latencies[j]) {
+        continue;
+      }
+      if (j+1<IndexStatistics::LATENCY_BUCKETS) {
+        out << " <" << (2ull<<j);
+      }
+      else {
+        out << " >=" << (1ull<<j);
+      }
+      out << ": " << is->latencies[j];
+    }
+    out << endl;
+  }
+  addCommentSignForSZS(out);
+  out << endl;
+}
+
 void Statistics::explainRefutationNotFound(ostream& out)
 {
   // should be a one-liner for each case!
@@ -267,7 +360,9 @@ void Statistics::print(ostream& out)
 
   HEADING("Saturation",activeClauses+passiveClauses+extensionalityClauses+
       generatedClauses+finalActiveClauses+finalPassiveClauses+finalExtensionalityClauses+
-      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck);
+      discardedNonRedundantClauses+inferencesSkippedDueToColors+inferencesBlockedForOrderingAftercheck+
+      checkpointsWritten+passiveClausesSpilled+clauseRecipes+backwardSimplificationBatches+memoryPressureEvents+reclaimedClauseMemory/1024+
+      fingerprintIndexCandidates);
   COND_OUT("Initial clauses", initialClauses);
   COND_OUT("Generated clauses", generatedClauses);
   COND_OUT("Active clauses", activeClauses);
@@ -280,6 +375,36 @@ void Statistics::print(ostream& out)
   COND_OUT("Discarded non-redundant clauses", discardedNonRedundantClauses);
   COND_OUT("Inferences skipped due to colors", inferencesSkippedDueToColors);
   COND_OUT("Inferences blocked due to ordering aftercheck", inferencesBlockedForOrderingAftercheck);
+  COND_OUT("Checkpoints written", checkpointsWritten);
+  COND_OUT("Spilled passive clauses", passiveClausesSpilled);
+  COND_OUT("Reloaded passive clauses", passiveClausesReloaded);
+  COND_OUT("Spill file compactions", spillFileCompactions);
+  COND_OUT("Clause recipes", clauseRecipes);
+  COND_OUT("Materialized clause recipes", materializedRecipes);
+  COND_OUT("Backward simplification batches", backwardSimplificationBatches);
+  COND_OUT("Memory pressure events", memoryPressureEvents);
+  COND_OUT("Inferences released on memory pressure", memoryPressureReleasedInferences);
+  COND_OUT("Simplifiers dropped on memory pressure", memoryPressureDroppedSimplifiers);
+  COND_OUT("Clauses evicted on memory pressure", memoryPressureEvictedClauses);
+  COND_OUT("Reclaimed memory of deleted clauses [KB]", reclaimedClauseMemory/1024);
+  COND_OUT("Fingerprint index candidates", fingerprintIndexCandidates);
+  COND_OUT("Fingerprint index hits", fingerprintIndexHits);
+  COND_OUT("Fingerprint index hit ratio [%]", fingerprintIndexCandidates ? fingerprintIndexHits*100/fingerprintIndexCandidates : 0);
+  COND_OUT("Live code tree blocks", codeTreeBlocks-codeTreeDeadBlocks);
+  COND_OUT("Dead code tree blocks", codeTreeDeadBlocks);
+  COND_OUT("Compacted code tree blocks", codeTreeCompactedBlocks);
+  COND_OUT("Code tree compactions", codeTreeCompactions);
+  COND_OUT("Ordering cache hits", orderingCacheHits);
+  COND_OUT("Ordering cache misses", orderingCacheMisses);
+  COND_OUT("KBO comparisons without traversal", kboComparisonsWithoutTraversal);
+  COND_OUT("Term garbage collections", termGcCollections);
+  COND_OUT("Terms freed by garbage collection", termGcFreedTerms);
+  COND_OUT("Literals freed by garbage collection", termGcFreedLiterals);
+  if (env.sharing) {
+    COND_OUT("Term sharing table resizes", env.sharing->tableResizes());
+    COND_OUT("Term sharing table resize steps", env.sharing->tableResizeSteps());
+    COND_OUT("Longest term sharing table resize step [ns]", env.sharing->maxTablePause());
+  }
   SEPARATOR;
 
 
@@ -305,7 +430,8 @@ void Statistics::print(ostream& out)
   SEPARATOR;
 
   HEADING("Deletion Inferences",simpleTautologies+equationalTautologies+
-      forwardSubsumed+backwardSubsumed+forwardDemodulationsToEqTaut+
+      forwardSubsumed+backwardSubsumed+forwardSubsumptionCandidates+backwardSubsumptionCandidates+
+      forwardDemodulationsToEqTaut+
       forwardSubsumptionDemodulationsToEqTaut+backwardSubsumptionDemodulationsToEqTaut+
       backwardDemodulationsToEqTaut+innerRewritesToEqTaut);
   COND_OUT("Simple tautologies", simpleTautologies);
@@ -313,6 +439,8 @@ void Statistics::print(ostream& out)
   COND_OUT("Deep equational tautologies", deepEquationalTautologies);
   COND_OUT("Forward subsumptions", forwardSubsumed);
   COND_OUT("Backward subsumptions", backwardSubsumed);
+  COND_OUT("Forward subsumption candidates", forwardSubsumptionCandidates);
+  COND_OUT("Backward subsumption candidates", backwardSubsumptionCandidates);
   COND_OUT("Fw demodulations to eq. taut.", forwardDemodulationsToEqTaut);
   COND_OUT("Bw demodulations to eq. taut.", backwardDemodulationsToEqTaut);
   COND_OUT("Fw subsumption demodulations to eq. taut.", forwardSubsumptionDemodulationsToEqTaut);
@@ -401,6 +529,10 @@ void Statistics::print(ostream& out)
 
   }
 
+  if (env.options->indexStatistics()!=Options::IndexStatistics::OFF) {
+    printIndexStatistics(out);
+  }
+
   COND_OUT("Memory used [KB]", Allocator::getUsedMemory()/1024);
 
   addCommentSignForSZS(out);
@@ -32,6 +32,7 @@
 
 #include "Lib/RCPtr.hpp"
 #include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
 
 #include "Lib/Allocator.hpp"
 
@@ -58,6 +59,7 @@ public:
   USE_ALLOCATOR(Statistics);
 
   Statistics();
+  ~Statistics();
 
   void print(ostream& out);
   void explainRefutationNotFound(ostream& out);
@@ -189,6 +191,10 @@ public:
   unsigned forwardSubsumed;
   /** number of backward subsumed clauses */
   unsigned backwardSubsumed;
+  /** number of non-unit clauses checked by forward subsumption */
+  unsigned forwardSubsumptionCandidates;
+  /** number of clauses checked by backward subsumption with non-unit clauses */
+  unsigned backwardSubsumptionCandidates;
 
   /** statistics of term algebra rules */
   unsigned taDistinctnessSimplifications;
@@ -208,6 +214,56 @@ public:
   unsigned extensionalityClauses;
 
   unsigned discardedNonRedundantClauses;
+  /** number of checkpoints written to the checkpoint_file */
+  unsigned checkpointsWritten;
+  /** passive clauses written to the spill file */
+  unsigned passiveClausesSpilled;
+  /** spilled passive clauses read back before their selection */
+  unsigned passiveClausesReloaded;
+  /** compactions of the spill file */
+  unsigned spillFileCompactions;
+  /** generated clauses stored as recipes by lazy_clause_materialization */
+  unsigned clauseRecipes;
+  /** clause recipes that were built */
+  unsigned materializedRecipes;
+  /** batches of retained clauses used together for backward simplification */
+  unsigned backwardSimplificationBatches;
+  /** times the memory usage crossed memory_pressure_watermark */
+  unsigned memoryPressureEvents;
+  /** clauses whose premises were forgotten to free memory */
+  unsigned memoryPressureReleasedInferences;
+  /** backward simplification engines switched off to free memory */
+  unsigned memoryPressureDroppedSimplifiers;
+  /** passive clauses evicted to free memory */
+  unsigned memoryPressureEvictedClauses;
+  /** bytes of the destroyed clauses some conclusion of which forgot its premises (see Inference::removePremises()) */
+  size_t reclaimedClauseMemory;
+  /** number of entries of fingerprint indexes checked by unification or matching */
+  size_t fingerprintIndexCandidates;
+  /** number of entries of fingerprint indexes that passed the check */
+  size_t fingerprintIndexHits;
+  /** blocks of code in all code trees */
+  unsigned codeTreeBlocks;
+  /** blocks of code trees with operations left unreachable by removals */
+  unsigned codeTreeDeadBlocks;
+  /** blocks whose unreachable operations were released by code tree compaction */
+  unsigned codeTreeCompactedBlocks;
+  /** completed passes of code tree compaction */
+  unsigned codeTreeCompactions;
+  /** term comparisons found in the cache of the ordering */
+  size_t orderingCacheHits;
+  /** term comparisons of shared terms not found in the cache of the ordering */
+  size_t orderingCacheMisses;
+  /** term comparisons KBO decided from weights and variable masks without traversing the terms */
+  size_t kboComparisonsWithoutTraversal;
+  /** garbage collections of shared terms */
+  unsigned termGcCollections;
+  /** shared terms freed by garbage collection */
+  size_t termGcFreedTerms;
+  /** shared literals freed by garbage collection */
+  size_t termGcFreedLiterals;
+  /** retrieval statistics of the indexes created with the option index_statistics */
+  Lib::Stack<Indexing::IndexStatistics*> indexStatistics;
 
   unsigned inferencesBlockedForOrderingAftercheck;
 
@@ -421,6 +477,7 @@ public:
 
 private:
   static const char* phaseToString(ExecutionPhase p);
+  void printIndexStatistics(ostream& out);
 }; // class Statistics
 
 }
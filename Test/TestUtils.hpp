@@ -26,6 +26,20 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/Index.hpp"
+
 #include "Api/FormulaBuilder.hpp"
 #include "Api/Problem.hpp"
 
@@ -41,8 +55,166 @@ public:
    * The ... are len of integers, positive -- positive polarity, negative -- negative polarity.
    */
   static SAT::SATClause* buildSATClause(unsigned len,...);
+
+  static unsigned addFunction(const vstring& name, unsigned arity);
+  static unsigned addPredicate(const vstring& name, unsigned arity);
+
+  static Kernel::TermList randomTerm(unsigned depth, const vstring& suffix = "", unsigned vars = 4, bool allowVar = true);
+  static Kernel::Literal* randomLiteral(unsigned depth, const vstring& suffix = "");
+  static Kernel::Clause* clause(Lib::Stack<Kernel::Literal*>& lits);
+  static Kernel::Clause* unitClause(Kernel::Literal* lit);
+
+  /** Number of times each result was returned, see @b count() */
+  typedef Lib::DHMap<vstring,int> ResultCounts;
+  static void count(ResultCounts& counts, Indexing::TermQueryResultIterator it, int diff);
+  static void count(ResultCounts& counts, Indexing::SLQueryResultIterator it, int diff);
+  static void checkSame(ResultCounts& counts);
 };
 
+/**
+ * Add the function symbol @b name of arity @b arity with all arguments
+ * and the result of the default sort, unless it exists, and return it
+ */
+inline unsigned TestUtils::addFunction(const vstring& name, unsigned arity)
+{
+  using namespace Kernel;
+
+  bool added;
+  unsigned f = env.signature->addFunction(name, arity, added);
+  if (added) {
+    env.signature->getFunction(f)->setType(
+        OperatorType::getFunctionTypeTypeUniformRange(arity, Sorts::SRT_DEFAULT, Sorts::SRT_DEFAULT));
+  }
+  return f;
+}
+
+/**
+ * Add the predicate symbol @b name of arity @b arity with all arguments
+ * of the default sort, unless it exists, and return it
+ */
+inline unsigned TestUtils::addPredicate(const vstring& name, unsigned arity)
+{
+  using namespace Kernel;
+
+  bool added;
+  unsigned p = env.signature->addPredicate(name, arity, added);
+  if (added) {
+    env.signature->getPredicate(p)->setType(
+        OperatorType::getPredicateTypeUniformRange(arity, Sorts::SRT_DEFAULT));
+  }
+  return p;
+}
+
+/**
+ * Random term of depth at most @b depth over the symbols f/2, g/1, a and b,
+ * whose names are followed by @b suffix, and the variables X0 to X(vars-1).
+ * If @b allowVar is false, the term is not a variable (its arguments may be).
+ */
+inline Kernel::TermList TestUtils::randomTerm(unsigned depth, const vstring& suffix, unsigned vars, bool allowVar)
+{
+  using namespace Kernel;
+
+  unsigned f = addFunction("f"+suffix, 2);
+  unsigned g = addFunction("g"+suffix, 1);
+  unsigned a = addFunction("a"+suffix, 0);
+  unsigned b = addFunction("b"+suffix, 0);
+
+  unsigned choice = allowVar ? Lib::Random::getInteger(depth ? 6 : 3) : 1+Lib::Random::getInteger(depth ? 5 : 2);
+  switch (choice) {
+  case 0:
+    return TermList(Lib::Random::getInteger(vars), false);
+  case 1:
+    return TermList(Term::createConstant(a));
+  case 2:
+    return TermList(Term::createConstant(b));
+  case 3:
+  {
+    TermList arg = randomTerm(depth-1, suffix, vars);
+    return TermList(Term::create(g, 1, &arg));
+  }
+  default:
+  {
+    TermList args[2] = { randomTerm(depth-1, suffix, vars), randomTerm(depth-1, suffix, vars) };
+    return TermList(Term::create(f, 2, args));
+  }
+  }
+}
+
+/**
+ * Random equality or literal with the predicate p/2, whose name is followed
+ * by @b suffix, with arguments made by @b randomTerm(depth,suffix)
+ */
+inline Kernel::Literal* TestUtils::randomLiteral(unsigned depth, const vstring& suffix)
+{
+  using namespace Kernel;
+
+  unsigned p = addPredicate("p"+suffix, 2);
+  TermList args[2] = { randomTerm(depth, suffix), randomTerm(depth, suffix) };
+  bool polarity = Lib::Random::getInteger(2);
+  if (Lib::Random::getInteger(2)) {
+    return Literal::createEquality(polarity, args[0], args[1], Sorts::SRT_DEFAULT);
+  }
+  return Literal::create(p, 2, polarity, false, args);
+}
+
+/** Input clause with the literals @b lits */
+inline Kernel::Clause* TestUtils::clause(Lib::Stack<Kernel::Literal*>& lits)
+{
+  using namespace Kernel;
+
+  Clause* cl = new(lits.size()) Clause(lits.size(), NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT));
+  for (unsigned i = 0; i < lits.size(); i++) {
+    (*cl)[i] = lits[i];
+  }
+  return cl;
+}
+
+/** Input clause with the only literal @b lit */
+inline Kernel::Clause* TestUtils::unitClause(Kernel::Literal* lit)
+{
+  using namespace Kernel;
+
+  Clause* cl = new(1) Clause(1, NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT));
+  (*cl)[0] = lit;
+  return cl;
+}
+
+/**
+ * Add @b diff to the counts of the results of @b it, so that the results
+ * of two retrievals can be compared by @b checkSame()
+ */
+inline void TestUtils::count(ResultCounts& counts, Indexing::TermQueryResultIterator it, int diff)
+{
+  while (it.hasNext()) {
+    Indexing::TermQueryResult qr = it.next();
+    vstring key = qr.term.toString() + " in " + Lib::Int::toString(qr.clause->number());
+    int* cnt;
+    counts.getValuePtr(key, cnt, 0);
+    *cnt += diff;
+  }
+}
+
+inline void TestUtils::count(ResultCounts& counts, Indexing::SLQueryResultIterator it, int diff)
+{
+  while (it.hasNext()) {
+    Indexing::SLQueryResult qr = it.next();
+    vstring key = qr.literal->toString() + " in " + Lib::Int::toString(qr.clause->number());
+    int* cnt;
+    counts.getValuePtr(key, cnt, 0);
+    *cnt += diff;
+  }
+}
+
+/** Check that all counts are 0 and reset them */
+inline void TestUtils::checkSame(ResultCounts& counts)
+{
+  ResultCounts::Iterator it(counts);
+  while (it.hasNext()) {
+    ASS_EQ(it.next(), 0);
+  }
+  counts.reset();
+}
+
 }
 
 #endif // __TestUtils__
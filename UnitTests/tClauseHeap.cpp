@@ -0,0 +1,154 @@
+/*
+ * File tClauseHeap.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <ctime>
+#include <iostream>
+
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/ClauseHeap.hpp"
+#include "Kernel/ClauseQueue.hpp"
+#include "Kernel/Inference.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID clauseheap
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+
+static Clause* newClause()
+{
+  return new(0) Clause(0, Inference(NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT)));
+}
+
+/** Pseudo-random key of a test clause, computed from its number */
+static ClauseHeap::Key keyOf(Clause* cl)
+{
+  return ClauseHeap::Key((cl->number()*2654435761u)%1000, 0, 0, cl->number());
+}
+
+/** ClauseQueue ordered in the same way as the ClauseHeap using keyOf() */
+class KeyQueue
+: public ClauseQueue
+{
+protected:
+  bool lessThan(Clause* c1, Clause* c2) override
+  { return keyOf(c1) < keyOf(c2); }
+};
+
+static void makeClauses(Stack<Clause*>& clauses, unsigned cnt)
+{
+  for (unsigned i = 0; i < cnt; i++) {
+    clauses.push(newClause());
+  }
+}
+
+static void destroyClauses(Stack<Clause*>& clauses)
+{
+  while (clauses.isNonEmpty()) {
+    clauses.pop()->destroy();
+  }
+}
+
+TEST_FUN(clauseheap1)
+{
+  Stack<Clause*> clauses;
+  makeClauses(clauses, 10000);
+
+  ClauseHeap heap;
+  for (unsigned i = 0; i < clauses.size(); i++) {
+    heap.insert(clauses[i], keyOf(clauses[i]));
+  }
+  //remove every third clause and put every ninth one back
+  for (unsigned i = 0; i < clauses.size(); i += 3) {
+    ASS(heap.remove(clauses[i]));
+    ASS(!heap.remove(clauses[i]));
+  }
+  for (unsigned i = 0; i < clauses.size(); i += 9) {
+    heap.insert(clauses[i], keyOf(clauses[i]));
+  }
+  ASS_EQ(heap.size(), clauses.size() - (clauses.size()+2)/3 + (clauses.size()+8)/9);
+
+  unsigned popped = 0;
+  Clause* prev = 0;
+  while (!heap.isEmpty()) {
+    Clause* cl = heap.pop();
+    unsigned idx = cl->number() - clauses[0]->number();
+    ASS(idx%3 != 0 || idx%9 == 0);
+    ASS(!prev || keyOf(prev) < keyOf(cl));
+    prev = cl;
+    popped++;
+  }
+  ASS_EQ(popped, clauses.size() - (clauses.size()+2)/3 + (clauses.size()+8)/9);
+
+  destroyClauses(clauses);
+}
+
+/**
+ * Compare the ClauseQueue and the ClauseHeap on the pattern of passive
+ * container operations: clauses are inserted, some are removed by
+ * backward simplification, and the best one is popped.
+ */
+TEST_FUN(clauseheapBenchmark)
+{
+  const unsigned cnt = 200000;
+
+  Stack<Clause*> clauses;
+  makeClauses(clauses, cnt);
+
+  clock_t start = clock();
+  {
+    KeyQueue queue;
+    for (unsigned i = 0; i < cnt; i++) {
+      queue.insert(clauses[i]);
+      if (i%4 == 3) {
+        queue.remove(clauses[i-2]);
+        queue.pop();
+      }
+    }
+    while (!queue.isEmpty()) {
+      queue.pop();
+    }
+  }
+  clock_t queueTime = clock() - start;
+
+  start = clock();
+  {
+    ClauseHeap heap;
+    for (unsigned i = 0; i < cnt; i++) {
+      heap.insert(clauses[i], keyOf(clauses[i]));
+      if (i%4 == 3) {
+        heap.remove(clauses[i-2]);
+        heap.pop();
+      }
+    }
+    while (!heap.isEmpty()) {
+      heap.pop();
+    }
+  }
+  clock_t heapTime = clock() - start;
+
+  cout << endl << "ClauseQueue: " << (queueTime*1000/CLOCKS_PER_SEC) << " ms" << endl;
+  cout << "ClauseHeap: " << (heapTime*1000/CLOCKS_PER_SEC) << " ms" << endl;
+
+  destroyClauses(clauses);
+}
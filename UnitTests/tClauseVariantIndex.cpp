@@ -0,0 +1,196 @@
+/*
+ * File tClauseVariantIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <chrono>
+
+#include "Lib/Metaiterators.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Renaming.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/ClauseVariantIndex.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID clauseVariantIndex
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+/** Random literal with p/2, q/1 or equality */
+static Literal* randomLiteral()
+{
+  static unsigned p = TestUtils::addPredicate("p", 2);
+  static unsigned q = TestUtils::addPredicate("q", 1);
+
+  TermList args[2] = { TestUtils::randomTerm(2), TestUtils::randomTerm(2) };
+  bool polarity = Random::getInteger(2);
+  switch (Random::getInteger(4)) {
+  case 0:
+    return Literal::createEquality(polarity, args[0], args[1], Sorts::SRT_DEFAULT);
+  case 1:
+    return Literal::create(q, 1, polarity, false, args);
+  default:
+    return Literal::create(p, 2, polarity, false, args);
+  }
+}
+
+static Clause* randomClause()
+{
+  Stack<Literal*> lits;
+  unsigned length = 1+Random::getInteger(3);
+  for (unsigned i = 0; i < length; i++) {
+    lits.push(randomLiteral());
+  }
+  return TestUtils::clause(lits);
+}
+
+/** Renames variable Xi to X(10-i) */
+struct ReversingRenaming
+{
+  TermList apply(unsigned var) { return TermList(10-var, false); }
+};
+
+/**
+ * Return a variant of @b cl with the variables renamed, the literals
+ * in the reverse order and the arguments of equalities swapped
+ */
+static Clause* variant(Clause* cl)
+{
+  ReversingRenaming renaming;
+  Stack<Literal*> lits;
+  for (int i = cl->length()-1; i >= 0; i--) {
+    Literal* lit = SubstHelper::apply((*cl)[i], renaming);
+    if (lit->isEquality()) {
+      lit = Literal::createEquality(lit->polarity(), *lit->nthArgument(1), *lit->nthArgument(0), Sorts::SRT_DEFAULT);
+    }
+    lits.push(lit);
+  }
+  return TestUtils::clause(lits);
+}
+
+static unsigned variantCount(ClauseVariantIndex& index, Clause* cl)
+{
+  return countIteratorElements(index.retrieveVariants(cl));
+}
+
+static long long now()
+{
+  return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TEST_FUN(fingerprintOfVariants)
+{
+  Random::setSeed(4);
+
+  for (unsigned i = 0; i < 1000; i++) {
+    Clause* cl = randomClause();
+    Clause* var = variant(cl);
+    ASS_EQ(FingerprintClauseVariantIndex::fingerprint(cl->literals(), cl->length()),
+        FingerprintClauseVariantIndex::fingerprint(var->literals(), var->length()));
+  }
+}
+
+/**
+ * Variants of unit equalities that have the arguments swapped, and whose
+ * normalized literals differ as the variables get numbered from the other
+ * argument, must be found by both the fingerprint and the substitution
+ * tree index
+ */
+TEST_FUN(swappedEqualityVariants)
+{
+  Random::setSeed(6);
+
+  FingerprintClauseVariantIndex fingerprints;
+  SubstitutionTreeClauseVariantIndex trees;
+
+  Stack<Clause*> queries;
+  while (queries.size() < 100) {
+    TermList args[2] = { TestUtils::randomTerm(2), TestUtils::randomTerm(2) };
+    Stack<Literal*> lits;
+    lits.push(Literal::createEquality(true, args[0], args[1], Sorts::SRT_DEFAULT));
+    Clause* cl = TestUtils::clause(lits);
+    Clause* var = variant(cl);
+    if (Renaming::normalize((*cl)[0]) == Renaming::normalize((*var)[0])) {
+      continue;
+    }
+    trees.insert(cl);
+    fingerprints.insert(cl);
+    queries.push(var);
+  }
+
+  for (unsigned i = 0; i < queries.size(); i++) {
+    unsigned fingerprintCnt = variantCount(fingerprints, queries[i]);
+    ASS_G(fingerprintCnt, 0);
+    ASS_EQ(variantCount(trees, queries[i]), fingerprintCnt);
+  }
+}
+
+/**
+ * The fingerprint index must find the same variants as the hashing and
+ * the substitution tree one; the times of all three are printed.
+ */
+TEST_FUN(fingerprintVariantRetrieval)
+{
+  Random::setSeed(5);
+
+  FingerprintClauseVariantIndex fingerprints;
+  SubstitutionTreeClauseVariantIndex trees;
+  HashingClauseVariantIndex hashes;
+
+  Stack<Clause*> queries;
+  for (unsigned i = 0; i < 20000; i++) {
+    Clause* cl = randomClause();
+    if (!variantCount(trees, cl)) {
+      trees.insert(cl);
+      hashes.insert(cl);
+      fingerprints.insert(cl);
+    }
+    queries.push(Random::getInteger(2) ? variant(cl) : randomClause());
+  }
+
+  unsigned treeCnt = 0, hashCnt = 0, fingerprintCnt = 0;
+  long long treeTime = 0, hashTime = 0, fingerprintTime = 0;
+  for (unsigned i = 0; i < queries.size(); i++) {
+    long long start = now();
+    treeCnt += variantCount(trees, queries[i]);
+    treeTime += now()-start;
+    start = now();
+    hashCnt += variantCount(hashes, queries[i]);
+    hashTime += now()-start;
+    start = now();
+    fingerprintCnt += variantCount(fingerprints, queries[i]);
+    fingerprintTime += now()-start;
+    ASS_EQ(treeCnt, fingerprintCnt);
+    ASS_EQ(hashCnt, fingerprintCnt);
+  }
+
+  ASS_G(fingerprintCnt, queries.size()/2);
+  cout << endl << "clause variant index: " << fingerprintCnt << " variants, substitution tree " << treeTime
+       << " us, hashing " << hashTime << " us, fingerprints " << fingerprintTime << " us" << endl;
+}
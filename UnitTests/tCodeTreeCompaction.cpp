@@ -0,0 +1,210 @@
+/*
+ * File tCodeTreeCompaction.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/ClauseCodeTree.hpp"
+#include "Indexing/CodeTreeInterfaces.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID codeTreeCompaction
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+static Clause* randomClause(unsigned length)
+{
+  static unsigned p = TestUtils::addPredicate("p", 2);
+  static unsigned q = TestUtils::addPredicate("q", 1);
+
+  Clause* cl = new(length) Clause(length, NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT));
+  for (unsigned i = 0; i < length; i++) {
+    TermList args[2] = { TestUtils::randomTerm(2), TestUtils::randomTerm(2) };
+    bool polarity = Random::getInteger(2);
+    (*cl)[i] = Random::getInteger(2) ? Literal::create(p, 2, polarity, false, args)
+        : Literal::create(q, 1, polarity, false, args);
+  }
+  return cl;
+}
+
+/**
+ * Create the indexing structure with compaction if @b compact is true,
+ * and without it otherwise
+ */
+template<class T>
+static T* createTree(bool compact)
+{
+  env.options->set("code_tree_compaction_ratio", compact ? "0.1" : "0");
+  T* res = new T();
+  env.options->set("code_tree_compaction_ratio", "0.25");
+  return res;
+}
+
+/** Take a random 90 percent of @b items out of it and return them */
+template<class T>
+static Stack<T> itemsToRemove(Stack<T>& items)
+{
+  Stack<T> res;
+  Stack<T> kept;
+  for (unsigned i = 0; i < items.size(); i++) {
+    if (Random::getInteger(10)) {
+      res.push(items[i]);
+    } else {
+      kept.push(items[i]);
+    }
+  }
+  items = kept;
+  return res;
+}
+
+static unsigned generalizationCount(CodeTreeTIS& index, Stack<TermList>& queries)
+{
+  unsigned res = 0;
+  for (unsigned i = 0; i < queries.size(); i++) {
+    TermQueryResultIterator it = index.getGeneralizations(queries[i], false);
+    while (it.hasNext()) {
+      it.next();
+      res++;
+    }
+  }
+  return res;
+}
+
+TEST_FUN(termCodeTreeCompaction)
+{
+  Random::setSeed(3);
+
+  unsigned compactions = env.statistics->codeTreeCompactions;
+  CodeTreeTIS* compacted = createTree<CodeTreeTIS>(true);
+  CodeTreeTIS* plain = createTree<CodeTreeTIS>(false);
+
+  Stack<TermList> terms;
+  for (unsigned i = 0; i < 20000; i++) {
+    TermList t = TestUtils::randomTerm(4, "", 4, false);
+    compacted->insert(t, 0, 0);
+    plain->insert(t, 0, 0);
+    terms.push(t);
+  }
+  Stack<TermList> removed = itemsToRemove(terms);
+  Stack<TermList> queries;
+  for (unsigned i = 0; i < 2000; i++) {
+    queries.push(TestUtils::randomTerm(3, "", 4, false));
+  }
+
+  for (unsigned i = 0; i < removed.size(); i++) {
+    compacted->remove(removed[i], 0, 0);
+    plain->remove(removed[i], 0, 0);
+    if (i % 1000 == 0) {
+      ASS_EQ(generalizationCount(*compacted, queries), generalizationCount(*plain, queries));
+    }
+  }
+
+  unsigned cnt = generalizationCount(*compacted, queries);
+  ASS_EQ(cnt, generalizationCount(*plain, queries));
+  ASS_G(cnt, 0);
+  ASS_G(env.statistics->codeTreeCompactions, compactions);
+  ASS_L(compacted->memoryUsage(), plain->memoryUsage());
+  cout << endl << "term code tree: " << compacted->memoryUsage() << " bytes compacted, "
+       << plain->memoryUsage() << " bytes plain" << endl;
+
+  for (unsigned i = 0; i < terms.size(); i++) {
+    compacted->remove(terms[i], 0, 0);
+    plain->remove(terms[i], 0, 0);
+  }
+
+  delete compacted;
+  delete plain;
+}
+
+/** Return the number of clauses in @b tree subsuming some of @b queries */
+static unsigned subsumerCount(ClauseCodeTree& tree, Stack<Clause*>& queries)
+{
+  static ClauseCodeTree::ClauseMatcher cm;
+
+  unsigned res = 0;
+  for (unsigned i = 0; i < queries.size(); i++) {
+    cm.init(&tree, queries[i], true);
+    int resolvedLit;
+    while (cm.next(resolvedLit)) {
+      res++;
+    }
+    cm.deinit();
+  }
+  return res;
+}
+
+TEST_FUN(clauseCodeTreeCompaction)
+{
+  Random::setSeed(4);
+
+  unsigned compactions = env.statistics->codeTreeCompactions;
+  ClauseCodeTree* compacted = createTree<ClauseCodeTree>(true);
+  ClauseCodeTree* plain = createTree<ClauseCodeTree>(false);
+
+  Stack<Clause*> clauses;
+  for (unsigned i = 0; i < 5000; i++) {
+    Clause* cl = randomClause(1+Random::getInteger(3));
+    compacted->insert(cl);
+    plain->insert(cl);
+    clauses.push(cl);
+  }
+  Stack<Clause*> removed = itemsToRemove(clauses);
+  Stack<Clause*> queries;
+  for (unsigned i = 0; i < 1000; i++) {
+    queries.push(randomClause(3+Random::getInteger(3)));
+  }
+
+  for (unsigned i = 0; i < removed.size(); i++) {
+    compacted->remove(removed[i]);
+    plain->remove(removed[i]);
+    if (i % 500 == 0) {
+      ASS_EQ(subsumerCount(*compacted, queries), subsumerCount(*plain, queries));
+    }
+  }
+
+  unsigned cnt = subsumerCount(*compacted, queries);
+  ASS_EQ(cnt, subsumerCount(*plain, queries));
+  ASS_G(cnt, 0);
+  ASS_G(env.statistics->codeTreeCompactions, compactions);
+  ASS_L(compacted->memoryUsage(), plain->memoryUsage());
+  cout << "clause code tree: " << compacted->memoryUsage() << " bytes compacted, "
+       << plain->memoryUsage() << " bytes plain" << endl;
+
+  for (unsigned i = 0; i < clauses.size(); i++) {
+    compacted->remove(clauses[i]);
+    plain->remove(clauses[i]);
+  }
+
+  delete compacted;
+  delete plain;
+}
@@ -0,0 +1,193 @@
+/*
+ * File tCodeTreeDispatch.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <chrono>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/ClauseCodeTree.hpp"
+#include "Indexing/CodeTreeInterfaces.hpp"
+
+#include "Shell/Options.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID codeTreeDispatch
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+static TermList randomNonVarTerm(unsigned depth)
+{
+  TermList res;
+  do {
+    res = TestUtils::randomTerm(depth);
+  } while (res.isVar());
+  return res;
+}
+
+static Clause* randomClause(unsigned length)
+{
+  static unsigned p = TestUtils::addPredicate("p", 2);
+  static unsigned q = TestUtils::addPredicate("q", 1);
+
+  Clause* cl = new(length) Clause(length, NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT));
+  for (unsigned i = 0; i < length; i++) {
+    TermList args[2] = { TestUtils::randomTerm(2), TestUtils::randomTerm(2) };
+    bool polarity = Random::getInteger(2);
+    (*cl)[i] = Random::getInteger(2) ? Literal::create(p, 2, polarity, false, args)
+        : Literal::create(q, 1, polarity, false, args);
+  }
+  return cl;
+}
+
+/** Number of times the queries are timed with each interpreter */
+static const unsigned ROUNDS = 5;
+
+static long long now()
+{
+  return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Create the indexing structure by @b create with the threaded interpreter
+ * if @b threaded is true, and with the switch one otherwise
+ */
+template<class T>
+static T* createTree(bool threaded)
+{
+  env.options->set("threaded_code_trees", threaded ? "on" : "off");
+  T* res = new T();
+  env.options->set("threaded_code_trees", "on");
+  return res;
+}
+
+static unsigned generalizationCount(CodeTreeTIS& index, Stack<TermList>& queries)
+{
+  unsigned res = 0;
+  for (unsigned i = 0; i < queries.size(); i++) {
+    TermQueryResultIterator it = index.getGeneralizations(queries[i], false);
+    while (it.hasNext()) {
+      it.next();
+      res++;
+    }
+  }
+  return res;
+}
+
+TEST_FUN(termCodeTreeDispatch)
+{
+  Random::setSeed(1);
+
+  CodeTreeTIS* threaded = createTree<CodeTreeTIS>(true);
+  CodeTreeTIS* switched = createTree<CodeTreeTIS>(false);
+
+  for (unsigned i = 0; i < 20000; i++) {
+    TermList t = randomNonVarTerm(4);
+    threaded->insert(t, 0, 0);
+    switched->insert(t, 0, 0);
+  }
+  Stack<TermList> queries;
+  for (unsigned i = 0; i < 2000; i++) {
+    queries.push(randomNonVarTerm(3));
+  }
+
+  unsigned switchedCnt = 0, threadedCnt = 0;
+  long long switchedTime = 0, threadedTime = 0;
+  for (unsigned round = 0; round < ROUNDS; round++) {
+    long long start = now();
+    switchedCnt = generalizationCount(*switched, queries);
+    switchedTime += now()-start;
+    start = now();
+    threadedCnt = generalizationCount(*threaded, queries);
+    threadedTime += now()-start;
+  }
+
+  ASS_EQ(threadedCnt, switchedCnt);
+  ASS_G(threadedCnt, 0);
+  cout << endl << "term code tree: " << threadedCnt << " generalizations, switch " << switchedTime
+       << " us, threaded " << threadedTime << " us" << endl;
+
+  delete threaded;
+  delete switched;
+}
+
+/** Return the number of clauses in @b tree subsuming some of @b queries */
+static unsigned subsumerCount(ClauseCodeTree& tree, Stack<Clause*>& queries)
+{
+  static ClauseCodeTree::ClauseMatcher cm;
+
+  unsigned res = 0;
+  for (unsigned i = 0; i < queries.size(); i++) {
+    cm.init(&tree, queries[i], true);
+    int resolvedLit;
+    while (cm.next(resolvedLit)) {
+      res++;
+    }
+    cm.deinit();
+  }
+  return res;
+}
+
+TEST_FUN(clauseCodeTreeDispatch)
+{
+  Random::setSeed(2);
+
+  ClauseCodeTree* threaded = createTree<ClauseCodeTree>(true);
+  ClauseCodeTree* switched = createTree<ClauseCodeTree>(false);
+
+  for (unsigned i = 0; i < 2000; i++) {
+    Clause* cl = randomClause(1+Random::getInteger(3));
+    threaded->insert(cl);
+    switched->insert(cl);
+  }
+  Stack<Clause*> queries;
+  for (unsigned i = 0; i < 2000; i++) {
+    queries.push(randomClause(3+Random::getInteger(3)));
+  }
+
+  unsigned switchedCnt = 0, threadedCnt = 0;
+  long long switchedTime = 0, threadedTime = 0;
+  for (unsigned round = 0; round < ROUNDS; round++) {
+    long long start = now();
+    switchedCnt = subsumerCount(*switched, queries);
+    switchedTime += now()-start;
+    start = now();
+    threadedCnt = subsumerCount(*threaded, queries);
+    threadedTime += now()-start;
+  }
+
+  ASS_EQ(threadedCnt, switchedCnt);
+  ASS_G(threadedCnt, 0);
+  cout << "clause code tree: " << threadedCnt << " subsumers and resolvers, switch " << switchedTime
+       << " us, threaded " << threadedTime << " us" << endl;
+
+  delete threaded;
+  delete switched;
+}
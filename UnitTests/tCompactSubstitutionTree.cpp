@@ -0,0 +1,132 @@
+/*
+ * File tCompactSubstitutionTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/CompactSubstitutionTree.hpp"
+#include "Indexing/LiteralSubstitutionTree.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID compactSubstitutionTree
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+/**
+ * The compact substitution tree must return the same results as the
+ * TermSubstitutionTree, also after removals.
+ */
+TEST_FUN(compactTermRetrieval)
+{
+  Random::setSeed(1);
+
+  TermSubstitutionTree tree;
+  CompactTermSubstitutionTree compact;
+
+  Stack<Clause*> clauses;
+  for (unsigned i = 0; i < 400; i++) {
+    Literal* lit = TestUtils::randomLiteral(3);
+    Clause* cl = TestUtils::unitClause(lit);
+    clauses.push(cl);
+    TermList t = *lit->nthArgument(0);
+    tree.insert(t, lit, cl);
+    compact.insert(t, lit, cl);
+  }
+  for (unsigned i = 0; i < clauses.size(); i += 3) {
+    Literal* lit = (*clauses[i])[0];
+    TermList t = *lit->nthArgument(0);
+    tree.remove(t, lit, clauses[i]);
+    compact.remove(t, lit, clauses[i]);
+  }
+
+  TestUtils::ResultCounts counts;
+  for (unsigned i = 0; i < 200; i++) {
+    TermList q = TestUtils::randomTerm(3);
+
+    TestUtils::count(counts, tree.getUnifications(q, true), 1);
+    TestUtils::count(counts, compact.getUnifications(q, true), -1);
+    TestUtils::checkSame(counts);
+
+    TestUtils::count(counts, tree.getGeneralizations(q, true), 1);
+    TestUtils::count(counts, compact.getGeneralizations(q, true), -1);
+    TestUtils::checkSame(counts);
+
+    TestUtils::count(counts, tree.getInstances(q, false), 1);
+    TestUtils::count(counts, compact.getInstances(q, false), -1);
+    TestUtils::checkSame(counts);
+
+    ASS_EQ(tree.generalizationExists(q), compact.generalizationExists(q));
+  }
+}
+
+/**
+ * The same as compactTermRetrieval for literals, including
+ * complementary queries and equalities.
+ */
+TEST_FUN(compactLiteralRetrieval)
+{
+  Random::setSeed(2);
+
+  LiteralSubstitutionTree tree;
+  CompactLiteralSubstitutionTree compact;
+
+  Stack<Clause*> clauses;
+  for (unsigned i = 0; i < 400; i++) {
+    Literal* lit = TestUtils::randomLiteral(3);
+    Clause* cl = TestUtils::unitClause(lit);
+    clauses.push(cl);
+    tree.insert(lit, cl);
+    compact.insert(lit, cl);
+  }
+  for (unsigned i = 0; i < clauses.size(); i += 3) {
+    tree.remove((*clauses[i])[0], clauses[i]);
+    compact.remove((*clauses[i])[0], clauses[i]);
+  }
+
+  TestUtils::ResultCounts counts;
+  TestUtils::count(counts, tree.getAll(), 1);
+  TestUtils::count(counts, compact.getAll(), -1);
+  TestUtils::checkSame(counts);
+
+  for (unsigned i = 0; i < 200; i++) {
+    Literal* q = TestUtils::randomLiteral(3);
+    bool complementary = Random::getInteger(2);
+
+    TestUtils::count(counts, tree.getUnifications(q, complementary, true), 1);
+    TestUtils::count(counts, compact.getUnifications(q, complementary, true), -1);
+    TestUtils::checkSame(counts);
+
+    TestUtils::count(counts, tree.getGeneralizations(q, complementary, true), 1);
+    TestUtils::count(counts, compact.getGeneralizations(q, complementary, true), -1);
+    TestUtils::checkSame(counts);
+
+    TestUtils::count(counts, tree.getInstances(q, complementary, false), 1);
+    TestUtils::count(counts, compact.getInstances(q, complementary, false), -1);
+    TestUtils::checkSame(counts);
+  }
+}
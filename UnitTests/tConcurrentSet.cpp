@@ -0,0 +1,271 @@
+/*
+ * File tConcurrentSet.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <chrono>
+
+#include <pthread.h>
+
+#include "Lib/ConcurrentSet.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Set.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID concurrentSet
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+
+namespace {
+
+/** A hash-consed object, equal to the other ones with the same key */
+struct Item
+{
+  unsigned key;
+};
+
+/** Hashing for sets of items, which does not use the CALL macro */
+struct ItemHash
+{
+  static unsigned hash(const Item* it)
+  {
+    unsigned h=it->key*0x9e3779b1u;
+    return h^(h>>16);
+  }
+  static bool equals(const Item* it1, const Item* it2) { return it1->key==it2->key; }
+};
+
+typedef ConcurrentSet<Item*,ItemHash> ItemSet;
+
+/** Number of distinct items, enough for several moves to larger tables */
+const unsigned KEY_CNT=300000;
+const unsigned THREAD_CNT=4;
+
+/** Items of one thread, one for each key, inserted in a random order */
+struct ThreadData
+{
+  DArray<Item> items;
+  DArray<unsigned> order;
+  /** The items the set returned, indexed by key */
+  DArray<Item*> results;
+
+  void init()
+  {
+    set=0;
+    items.ensure(KEY_CNT);
+    order.ensure(KEY_CNT);
+    results.ensure(KEY_CNT);
+    for(unsigned i=0;i<KEY_CNT;i++) {
+      items[i].key=i;
+      order[i]=i;
+    }
+    for(unsigned i=KEY_CNT-1;i>0;i--) {
+      swap(order[i], order[Random::getInteger(i+1)]);
+    }
+  }
+
+  ItemSet* set;
+
+  void insertAll()
+  {
+    for(unsigned i=0;i<KEY_CNT;i++) {
+      unsigned key=order[i];
+      results[key]=set->insert(&items[key]);
+    }
+  }
+};
+
+void* insertAll(void* data)
+{
+  static_cast<ThreadData*>(data)->insertAll();
+  return 0;
+}
+
+long long now()
+{
+  return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+/**
+ * Threads insert equal items in different orders at the same time, and
+ * all of them must get the same item back for each key
+ *
+ * The threads are started by pthread_create() rather than as std::thread
+ * objects, whose states are allocated and released by the global new and
+ * delete, and so by Allocator, which is not thread-safe.
+ */
+TEST_FUN(concurrentInsertion)
+{
+  Random::setSeed(1);
+
+  for(unsigned round=0;round<5;round++) {
+    ThreadData data[THREAD_CNT];
+    for(unsigned t=0;t<THREAD_CNT;t++) {
+      data[t].init();
+    }
+
+    ItemSet* set=new ItemSet();
+    pthread_t threads[THREAD_CNT];
+    for(unsigned t=0;t<THREAD_CNT;t++) {
+      data[t].set=set;
+      ALWAYS(!pthread_create(&threads[t], 0, insertAll, &data[t]));
+    }
+    for(unsigned t=0;t<THREAD_CNT;t++) {
+      ALWAYS(!pthread_join(threads[t], 0));
+    }
+
+    ASS_EQ(set->size(), KEY_CNT);
+    for(unsigned key=0;key<KEY_CNT;key++) {
+      Item* res=data[0].results[key];
+      ASS_EQ(res->key, key);
+      Item* found;
+      ALWAYS(set->find(res, found));
+      ASS_EQ(found, res);
+      for(unsigned t=1;t<THREAD_CNT;t++) {
+        ASS_EQ(data[t].results[key], res);
+      }
+    }
+    delete set;
+  }
+}
+
+/**
+ * Values inserted while the set is being resized must be found both in
+ * the old and in the new table, and the resizes must take many steps
+ */
+TEST_FUN(incrementalResize)
+{
+  Random::setSeed(3);
+
+  ThreadData data;
+  data.init();
+
+  ItemSet* set=new ItemSet();
+  for(unsigned i=0;i<KEY_CNT;i++) {
+    Item* it=&data.items[data.order[i]];
+    ASS_EQ(set->insert(it), it);
+    ASS_EQ(set->size(), i+1);
+    Item* found;
+    ALWAYS(set->find(it, found));
+    ASS_EQ(found, it);
+    Item* old=&data.items[data.order[Random::getInteger(i+1)]];
+    ASS_EQ(set->insert(old), old);
+  }
+  ASS_G(set->resizes(), 8);
+  ASS_G(set->resizeSteps(), 8*set->resizes());
+
+  unsigned cnt=0;
+  ItemSet::Iterator iit(*set);
+  while(iit.hasNext()) {
+    Item* it=iit.next();
+    ASS_EQ(it, &data.items[it->key]);
+    cnt++;
+  }
+  ASS_EQ(cnt, KEY_CNT);
+  delete set;
+}
+
+/**
+ * After the items with keys of a random residue are removed, the others
+ * must still be found and the removed ones must be missing until they
+ * are inserted again
+ */
+TEST_FUN(removal)
+{
+  Random::setSeed(4);
+
+  ThreadData data;
+  data.init();
+
+  ItemSet* set=new ItemSet();
+  for(unsigned i=0;i<KEY_CNT;i++) {
+    set->insert(&data.items[data.order[i]]);
+  }
+
+  for(unsigned residue=0;residue<3;residue++) {
+    unsigned calls=0;
+    size_t removed=set->removeIf([&](Item* it) {
+      calls++;
+      return it->key%3==residue;
+    });
+    ASS_EQ(calls, KEY_CNT);
+    ASS_EQ(removed, (KEY_CNT+2-residue)/3);
+    ASS_EQ(set->size(), KEY_CNT-removed);
+
+    for(unsigned key=0;key<KEY_CNT;key++) {
+      Item* found;
+      ASS_EQ(set->find(&data.items[key], found), key%3!=residue);
+    }
+    for(unsigned key=residue;key<KEY_CNT;key+=3) {
+      ASS_EQ(set->insert(&data.items[key]), &data.items[key]);
+    }
+    ASS_EQ(set->size(), KEY_CNT);
+  }
+  delete set;
+}
+
+/**
+ * Single-threaded insertions of new and of already present items,
+ * timed for ConcurrentSet and for Set
+ */
+TEST_FUN(concurrentSetBenchmark)
+{
+  Random::setSeed(2);
+
+  ThreadData fresh;
+  ThreadData duplicates;
+  fresh.init();
+  duplicates.init();
+
+  long long start=now();
+  ItemSet* concurrent=new ItemSet();
+  for(unsigned i=0;i<KEY_CNT;i++) {
+    concurrent->insert(&fresh.items[fresh.order[i]]);
+  }
+  long long concurrentFresh=now()-start;
+  start=now();
+  for(unsigned i=0;i<KEY_CNT;i++) {
+    ASS_EQ(concurrent->insert(&duplicates.items[duplicates.order[i]])->key, duplicates.order[i]);
+  }
+  long long concurrentDuplicates=now()-start;
+
+  start=now();
+  Set<Item*,ItemHash>* plain=new Set<Item*,ItemHash>();
+  for(unsigned i=0;i<KEY_CNT;i++) {
+    plain->insert(&fresh.items[fresh.order[i]]);
+  }
+  long long plainFresh=now()-start;
+  start=now();
+  for(unsigned i=0;i<KEY_CNT;i++) {
+    ASS_EQ(plain->insert(&duplicates.items[duplicates.order[i]])->key, duplicates.order[i]);
+  }
+  long long plainDuplicates=now()-start;
+
+  ASS_EQ(concurrent->size(), KEY_CNT);
+  cout << endl << "new items: ConcurrentSet " << concurrentFresh << " us, Set " << plainFresh << " us" << endl;
+  cout << "present items: ConcurrentSet " << concurrentDuplicates << " us, Set " << plainDuplicates << " us" << endl;
+  cout << "ConcurrentSet resizes: " << concurrent->resizes() << " in " << concurrent->resizeSteps()
+       << " steps, the longest one " << concurrent->maxPause() << " ns" << endl;
+
+  delete concurrent;
+  delete plain;
+}
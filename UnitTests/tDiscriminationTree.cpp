@@ -0,0 +1,88 @@
+/*
+ * File tDiscriminationTree.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/DiscriminationTree.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID discriminationTree
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+/**
+ * The discrimination tree must return the same generalizations as the
+ * TermSubstitutionTree, also after removals, and their substitutions
+ * must instantiate them to the query.
+ */
+TEST_FUN(discriminationTreeGeneralizations)
+{
+  Random::setSeed(5);
+
+  TermSubstitutionTree tree;
+  DiscriminationTree index;
+
+  Stack<Clause*> clauses;
+  for (unsigned i = 0; i < 400; i++) {
+    Literal* lit = TestUtils::randomLiteral(3, "d");
+    Clause* cl = TestUtils::unitClause(lit);
+    clauses.push(cl);
+    TermList t = *lit->nthArgument(0);
+    tree.insert(t, lit, cl);
+    index.insert(t, lit, cl);
+  }
+  for (unsigned i = 0; i < clauses.size(); i += 3) {
+    Literal* lit = (*clauses[i])[0];
+    TermList t = *lit->nthArgument(0);
+    tree.remove(t, lit, clauses[i]);
+    index.remove(t, lit, clauses[i]);
+  }
+
+  TestUtils::ResultCounts counts;
+  unsigned found = 0;
+  for (unsigned i = 0; i < 300; i++) {
+    TermList q = TestUtils::randomTerm(3, "d");
+
+    TestUtils::count(counts, tree.getGeneralizations(q, false), 1);
+    TestUtils::count(counts, index.getGeneralizations(q, false), -1);
+    TestUtils::checkSame(counts);
+
+    TermQueryResultIterator it = index.getGeneralizations(q, true);
+    while (it.hasNext()) {
+      TermQueryResult qr = it.next();
+      ASS(qr.substitution->isIdentityOnQueryWhenResultBound());
+      ASS_EQ(qr.substitution->applyToBoundResult(qr.term), q);
+      found++;
+    }
+
+    ASS_EQ(tree.generalizationExists(q), index.generalizationExists(q));
+  }
+  //the test is meaningful only if there are generalizations
+  ASS_G(found, 0);
+}
@@ -0,0 +1,197 @@
+/*
+ * File tFeatureVectorIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/DHSet.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Matcher.hpp"
+#include "Kernel/MLMatcher.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/SubstHelper.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/FeatureVectorIndex.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID featureVectorIndex
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+static Literal* randomLiteral()
+{
+  static unsigned p = TestUtils::addPredicate("pv", 2);
+  static unsigned q = TestUtils::addPredicate("qv", 1);
+
+  TermList args[2] = { TestUtils::randomTerm(2, "v"), TestUtils::randomTerm(2, "v") };
+  bool polarity = Random::getInteger(2);
+  switch (Random::getInteger(3)) {
+  case 0:
+    return Literal::createEquality(polarity, args[0], args[1], Sorts::SRT_DEFAULT);
+  case 1:
+    return Literal::create(p, 2, polarity, false, args);
+  default:
+    return Literal::create(q, 1, polarity, false, args);
+  }
+}
+
+static Clause* randomClause()
+{
+  Stack<Literal*> lits;
+  unsigned len = 2 + Random::getInteger(2);
+  while (lits.size() < len) {
+    Literal* lit = randomLiteral();
+    if (!lits.find(lit)) {
+      lits.push(lit);
+    }
+  }
+  return TestUtils::clause(lits);
+}
+
+struct RandomInstantiator
+{
+  RandomInstantiator() { for (unsigned i = 0; i < 4; i++) { _terms[i] = TestUtils::randomTerm(1, "v"); } }
+  TermList apply(unsigned var) { return var < 4 ? _terms[var] : TermList(var, false); }
+  TermList _terms[4];
+};
+
+/** A random instance of @b cl without duplicate literals, possibly with an additional literal */
+static Clause* randomInstance(Clause* cl)
+{
+  RandomInstantiator inst;
+  Stack<Literal*> lits;
+  for (unsigned i = 0; i < cl->length(); i++) {
+    Literal* lit = SubstHelper::apply((*cl)[i], inst);
+    if (!lits.find(lit)) {
+      lits.push(lit);
+    }
+  }
+  if (Random::getInteger(2)) {
+    Literal* lit = randomLiteral();
+    if (!lits.find(lit)) {
+      lits.push(lit);
+    }
+  }
+  return TestUtils::clause(lits);
+}
+
+static bool subsumes(Clause* base, Clause* instance)
+{
+  unsigned blen = base->length();
+  unsigned ilen = instance->length();
+  DArray<LiteralList*> matches(blen);
+  bool res = true;
+  for (unsigned bi = 0; bi < blen; bi++) {
+    matches[bi] = 0;
+    for (unsigned ii = 0; ii < ilen; ii++) {
+      if (MatchingUtils::match((*base)[bi], (*instance)[ii], false)) {
+        LiteralList::push((*instance)[ii], matches[bi]);
+      }
+    }
+    res = res && matches[bi];
+  }
+  res = res && MLMatcher::canBeMatched(base, instance, matches.array(), 0);
+  for (unsigned bi = 0; bi < blen; bi++) {
+    LiteralList::destroy(matches[bi]);
+  }
+  return res;
+}
+
+/** Feature vector index filled directly instead of through a clause container */
+class TestFeatureVectorIndex
+: public FeatureVectorIndex
+{
+public:
+  void add(Clause* cl) { handleClause(cl, true); }
+  void remove(Clause* cl) { handleClause(cl, false); }
+};
+
+static void collect(ClauseIterator it, DHSet<Clause*>& res)
+{
+  res.reset();
+  while (it.hasNext()) {
+    //each clause is returned once
+    ALWAYS(res.insert(it.next()));
+  }
+}
+
+/**
+ * The candidates of the index must contain all indexed clauses that
+ * subsume the query or are subsumed by it.
+ */
+TEST_FUN(featureVectorCandidates)
+{
+  Random::setSeed(3);
+  randomLiteral();
+
+  TestFeatureVectorIndex index;
+
+  Stack<Clause*> clauses;
+  for (unsigned i = 0; i < 300; i++) {
+    Clause* cl = randomClause();
+    clauses.push(cl);
+    index.add(cl);
+    if (i%2) {
+      cl = randomInstance(cl);
+      clauses.push(cl);
+      index.add(cl);
+    }
+  }
+  DHSet<Clause*> removed;
+  for (unsigned i = 0; i < clauses.size(); i += 5) {
+    index.remove(clauses[i]);
+    removed.insert(clauses[i]);
+  }
+
+  DHSet<Clause*> subsuming;
+  DHSet<Clause*> subsumed;
+  unsigned hits = 0;
+  for (unsigned qi = 0; qi < clauses.size(); qi += 3) {
+    Clause* query = clauses[qi];
+    collect(index.getSubsumingCandidates(query), subsuming);
+    collect(index.getSubsumedCandidates(query), subsumed);
+
+    for (unsigned i = 0; i < clauses.size(); i++) {
+      Clause* cl = clauses[i];
+      //neither removed nor unit clauses are in the index
+      if (removed.find(cl) || cl->length() < 2) {
+        ASS(!subsuming.find(cl));
+        ASS(!subsumed.find(cl));
+        continue;
+      }
+      if (subsumes(cl, query)) {
+        ASS(subsuming.find(cl));
+        hits++;
+      }
+      if (subsumes(query, cl)) {
+        ASS(subsumed.find(cl));
+        hits++;
+      }
+    }
+  }
+  //the test is meaningful only if there are subsumptions besides the query itself
+  ASS_G(hits, clauses.size()/3);
+}
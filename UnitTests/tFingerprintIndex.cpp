@@ -0,0 +1,84 @@
+/*
+ * File tFingerprintIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/FingerprintIndex.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID fingerprintIndex
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+/**
+ * The fingerprint index must return the same results as the
+ * TermSubstitutionTree, also after removals.
+ */
+TEST_FUN(fingerprintRetrieval)
+{
+  Random::setSeed(4);
+
+  TermSubstitutionTree tree;
+  FingerprintIndex index;
+
+  Stack<Clause*> clauses;
+  for (unsigned i = 0; i < 400; i++) {
+    Literal* lit = TestUtils::randomLiteral(3);
+    Clause* cl = TestUtils::unitClause(lit);
+    clauses.push(cl);
+    TermList t = *lit->nthArgument(0);
+    tree.insert(t, lit, cl);
+    index.insert(t, lit, cl);
+  }
+  for (unsigned i = 0; i < clauses.size(); i += 3) {
+    Literal* lit = (*clauses[i])[0];
+    TermList t = *lit->nthArgument(0);
+    tree.remove(t, lit, clauses[i]);
+    index.remove(t, lit, clauses[i]);
+  }
+
+  TestUtils::ResultCounts counts;
+  for (unsigned i = 0; i < 200; i++) {
+    TermList q = TestUtils::randomTerm(3);
+
+    TestUtils::count(counts, tree.getUnifications(q, true), 1);
+    TestUtils::count(counts, index.getUnifications(q, true), -1);
+    TestUtils::checkSame(counts);
+
+    TestUtils::count(counts, tree.getGeneralizations(q, true), 1);
+    TestUtils::count(counts, index.getGeneralizations(q, true), -1);
+    TestUtils::checkSame(counts);
+
+    TestUtils::count(counts, tree.getInstances(q, false), 1);
+    TestUtils::count(counts, index.getInstances(q, false), -1);
+    TestUtils::checkSame(counts);
+
+    ASS_EQ(tree.generalizationExists(q), index.generalizationExists(q));
+  }
+}
@@ -0,0 +1,148 @@
+/*
+ * File tGeneratedClauseOrder.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <algorithm>
+
+#include "Lib/Random.hpp"
+#include "Lib/SharedSet.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Saturation/SaturationAlgorithm.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID generatedClauseOrder
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Saturation;
+using namespace Test;
+
+/** Random literal with gco_p/1 or equality */
+static Literal* randomLiteral()
+{
+  static unsigned p = TestUtils::addPredicate("gco_p", 1);
+
+  TermList args[2] = { TestUtils::randomTerm(2, "gco", 3), TestUtils::randomTerm(2, "gco", 3) };
+  bool polarity = Random::getInteger(2);
+  if (Random::getInteger(2)) {
+    return Literal::createEquality(polarity, args[0], args[1], Sorts::SRT_DEFAULT);
+  }
+  return Literal::create(p, 1, polarity, false, args);
+}
+
+static void shuffle(Stack<Clause*>& clauses)
+{
+  for (unsigned i = clauses.size(); i > 1; i--) {
+    swap(clauses[i-1], clauses[Random::getInteger(i)]);
+  }
+}
+
+/** True if the clauses at the same positions have the same literals */
+static bool sameContents(Stack<Clause*>& clauses1, Stack<Clause*>& clauses2)
+{
+  if (clauses1.size() != clauses2.size()) {
+    return false;
+  }
+  for (unsigned i = 0; i < clauses1.size(); i++) {
+    Clause* c1 = clauses1[i];
+    Clause* c2 = clauses2[i];
+    if (c1->length() != c2->length()) {
+      return false;
+    }
+    for (unsigned j = 0; j < c1->length(); j++) {
+      if ((*c1)[j] != (*c2)[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Clauses with the same literals, generated in shuffled orders and so
+ * numbered differently, must come out of the sort in the same order
+ */
+TEST_FUN(orderDoesNotDependOnGeneration)
+{
+  Random::setSeed(7);
+
+  Stack<Stack<Literal*> > contents;
+  for (unsigned i = 0; i < 500; i++) {
+    contents.push(Stack<Literal*>());
+    unsigned length = 1+Random::getInteger(3);
+    for (unsigned j = 0; j < length; j++) {
+      contents.top().push(randomLiteral());
+    }
+  }
+
+  Stack<Clause*> sorted;
+  for (unsigned i = 0; i < contents.size(); i++) {
+    sorted.push(TestUtils::clause(contents[i]));
+  }
+  sort(sorted.begin(), sorted.end(), SaturationAlgorithm::GeneratedClauseComparator());
+
+  for (unsigned round = 0; round < 5; round++) {
+    Stack<unsigned> order;
+    for (unsigned i = 0; i < contents.size(); i++) {
+      order.push(i);
+    }
+    for (unsigned i = order.size(); i > 1; i--) {
+      swap(order[i-1], order[Random::getInteger(i)]);
+    }
+    Stack<Clause*> generated;
+    for (unsigned i = 0; i < order.size(); i++) {
+      generated.push(TestUtils::clause(contents[order[i]]));
+    }
+    shuffle(generated);
+    sort(generated.begin(), generated.end(), SaturationAlgorithm::GeneratedClauseComparator());
+    ASS(sameContents(sorted, generated));
+  }
+}
+
+/**
+ * The splitter sets the split sets of the generated clauses after they
+ * are sorted, which requires their weights not to be cached yet
+ */
+TEST_FUN(splitsCanBeSetAfterSort)
+{
+  Random::setSeed(11);
+
+  Stack<Clause*> generated;
+  for (unsigned i = 0; i < 100; i++) {
+    Stack<Literal*> lits;
+    unsigned length = 1+Random::getInteger(3);
+    for (unsigned j = 0; j < length; j++) {
+      lits.push(randomLiteral());
+    }
+    generated.push(TestUtils::clause(lits));
+  }
+  sort(generated.begin(), generated.end(), SaturationAlgorithm::GeneratedClauseComparator());
+
+  for (unsigned i = 0; i < generated.size(); i++) {
+    generated[i]->setSplits(SplitSet::getEmpty());
+    ASS_EQ(generated[i]->weight(), generated[i]->computeWeight());
+  }
+}
@@ -0,0 +1,182 @@
+/*
+ * File tIndexReaders.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/DHSet.hpp"
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/CodeTreeInterfaces.hpp"
+#include "Indexing/LiteralSubstitutionTree.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID indexReaders
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+static unsigned addFunction(vstring name, unsigned arity)
+{
+  bool added;
+  unsigned f = env.signature->addFunction(name, arity, added);
+  if (added) {
+    env.signature->getFunction(f)->setType(
+        OperatorType::getFunctionTypeTypeUniformRange(arity, Sorts::SRT_DEFAULT, Sorts::SRT_DEFAULT));
+  }
+  return f;
+}
+
+static unsigned addPredicate(vstring name, unsigned arity)
+{
+  bool added;
+  unsigned p = env.signature->addPredicate(name, arity, added);
+  if (added) {
+    env.signature->getPredicate(p)->setType(
+        OperatorType::getPredicateTypeUniformRange(arity, Sorts::SRT_DEFAULT));
+  }
+  return p;
+}
+
+static TermList constant(vstring name)
+{
+  return TermList(Term::createConstant(addFunction(name, 0)));
+}
+
+static TermList term(vstring name, TermList arg1, TermList arg2)
+{
+  TermList args[2] = { arg1, arg2 };
+  return TermList(Term::create(addFunction(name, 2), 2, args));
+}
+
+static Literal* literal(vstring name, TermList arg1, TermList arg2)
+{
+  TermList args[2] = { arg1, arg2 };
+  return Literal::create(addPredicate(name, 2), 2, true, false, args);
+}
+
+static void collect(TermQueryResultIterator it, DHSet<Term*>& res)
+{
+  res.reset();
+  while (it.hasNext()) {
+    res.insert(it.next().term.term());
+  }
+}
+
+static void collect(SLQueryResultIterator it, DHSet<Literal*>& res)
+{
+  res.reset();
+  while (it.hasNext()) {
+    res.insert(it.next().literal);
+  }
+}
+
+/**
+ * Modify @b index while iterators over generalizations of f(a,a) are
+ * alive, and check that they see the index as it was when they were
+ * created, while the later retrievals see the modifications.
+ */
+static void testTermIndex(TermIndexingStructure& index)
+{
+  TermList a = constant("ar");
+  TermList x(0, false);
+  TermList fxa = term("fr", x, a);
+  TermList fax = term("fr", a, x);
+  TermList faa = term("fr", a, a);
+  TermList gxa = term("gr", x, a);
+
+  index.insert(fxa, 0, 0);
+  index.insert(faa, 0, 0);
+  index.insert(gxa, 0, 0);
+
+  DHSet<Term*> res;
+  {
+    TermQueryResultIterator it1 = index.getGeneralizations(faa, true);
+    ASS(it1.hasNext());
+    index.insert(fax, 0, 0);
+    index.remove(fxa, 0, 0);
+    {
+      TermQueryResultIterator it2 = index.getGeneralizations(faa, false);
+      index.remove(faa, 0, 0);
+      collect(it2, res);
+      ASS_EQ(res.size(), 2);
+      ASS(res.find(fxa.term()));
+      ASS(res.find(faa.term()));
+    }
+    collect(it1, res);
+    ASS_EQ(res.size(), 2);
+    ASS(res.find(fxa.term()));
+    ASS(res.find(faa.term()));
+  }
+
+  collect(index.getGeneralizations(faa, false), res);
+  ASS_EQ(res.size(), 1);
+  ASS(res.find(fax.term()));
+
+  index.remove(fax, 0, 0);
+  index.remove(gxa, 0, 0);
+}
+
+TEST_FUN(termSubstitutionTreeReaders)
+{
+  TermSubstitutionTree index;
+  testTermIndex(index);
+}
+
+TEST_FUN(codeTreeReaders)
+{
+  CodeTreeTIS index;
+  testTermIndex(index);
+}
+
+TEST_FUN(literalSubstitutionTreeReaders)
+{
+  TermList a = constant("ar");
+  TermList x(0, false);
+  Literal* pxa = literal("pr", x, a);
+  Literal* pax = literal("pr", a, x);
+  Literal* paa = literal("pr", a, a);
+
+  LiteralSubstitutionTree index;
+  index.insert(pxa, 0);
+  index.insert(paa, 0);
+
+  DHSet<Literal*> res;
+  {
+    SLQueryResultIterator it = index.getGeneralizations(paa, false, true);
+    ASS(it.hasNext());
+    index.insert(pax, 0);
+    index.remove(pxa, 0);
+    index.remove(paa, 0);
+    collect(it, res);
+    ASS_EQ(res.size(), 2);
+    ASS(res.find(pxa));
+    ASS(res.find(paa));
+  }
+
+  collect(index.getGeneralizations(paa, false, false), res);
+  ASS_EQ(res.size(), 1);
+  ASS(res.find(pax));
+
+  index.remove(pax, 0);
+}
@@ -0,0 +1,131 @@
+/*
+ * File tIndexStatistics.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Metaiterators.hpp"
+
+#include "Kernel/Signature.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/IndexStatistics.hpp"
+#include "Indexing/TermSubstitutionTree.hpp"
+
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID indexStatistics
+UT_CREATE;
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+
+static TermList term(vstring name, unsigned arity, TermList* args)
+{
+  bool added;
+  unsigned f = env.signature->addFunction(name, arity, added);
+  if (added) {
+    env.signature->getFunction(f)->setType(
+        OperatorType::getFunctionTypeTypeUniformRange(arity, Sorts::SRT_DEFAULT, Sorts::SRT_DEFAULT));
+  }
+  return TermList(Term::create(f, arity, args));
+}
+
+static Literal* literal(vstring name, TermList arg)
+{
+  bool added;
+  unsigned p = env.signature->addPredicate(name, 1, added);
+  if (added) {
+    env.signature->getPredicate(p)->setType(
+        OperatorType::getPredicateTypeUniformRange(1, Sorts::SRT_DEFAULT));
+  }
+  return Literal::create(p, 1, true, false, &arg);
+}
+
+TEST_FUN(latencyBuckets)
+{
+  IndexStatistics stats("test");
+  stats.recordQuery(0);
+  stats.recordQuery(1);
+  stats.recordQuery(2);
+  stats.recordQuery(3);
+  stats.recordQuery(1000);
+  stats.recordQuery(1ll<<40);
+
+  ASS_EQ(stats.queries, 6);
+  ASS_EQ(stats.latencies[0], 2);
+  ASS_EQ(stats.latencies[1], 2);
+  ASS_EQ(stats.latencies[9], 1);
+  ASS_EQ(stats.latencies[IndexStatistics::LATENCY_BUCKETS-1], 1);
+}
+
+TEST_FUN(monitoredQueries)
+{
+  TermList a = term("as", 0, 0);
+  TermList x(0, false);
+  TermList fa = term("fs", 1, &a);
+  TermList fx = term("fs", 1, &x);
+
+  TermSubstitutionTree index;
+  index.insert(fx, 0, 0);
+  index.insert(fa, 0, 0);
+
+  IndexStatistics stats("test");
+  {
+    TermQueryResultIterator it = stats.monitor(index.getGeneralizations(fa, false), IndexStatistics::now());
+    ASS_EQ(countIteratorElements(it), 2);
+    ASS_EQ(stats.queries, 0);
+  }
+  stats.monitor(index.getGeneralizations(fx, false), IndexStatistics::now());
+
+  ASS_EQ(stats.queries, 2);
+  ASS_EQ(stats.candidates, 2);
+
+  index.remove(fx, 0, 0);
+  index.remove(fa, 0, 0);
+}
+
+TEST_FUN(memoryUsage)
+{
+  TermSubstitutionTree index;
+  ASS_EQ(index.memoryUsage(), 0);
+
+  IndexStatistics stats("test");
+  stats.recordMemoryUsage(index.memoryUsage());
+  ASS_EQ(stats.bytesPerClause(), 0);
+
+  //enough entries of one term for its leaf to become a skip list
+  TermList a = term("as", 0, 0);
+  Literal* lits[10];
+  for (unsigned i = 0; i < 10; i++) {
+    lits[i] = literal("ps"+Int::toString(i), a);
+    index.insert(a, lits[i], 0);
+  }
+  size_t mem = index.memoryUsage();
+  ASS_G(mem, 10*sizeof(void*));
+
+  stats.clauses = 10;
+  stats.recordMemoryUsage(mem);
+  ASS_EQ(stats.bytesPerClause(), mem/10);
+
+  for (unsigned i = 0; i < 10; i++) {
+    index.remove(a, lits[i], 0);
+  }
+  ASS_EQ(index.memoryUsage(), 0);
+}
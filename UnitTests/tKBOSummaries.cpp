@@ -0,0 +1,99 @@
+/*
+ * File tKBOSummaries.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/KBO.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID kboSummaries
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+using namespace Test;
+
+static TermList f(TermList t1, TermList t2)
+{
+  static unsigned f = TestUtils::addFunction("ks_f", 2);
+  TermList args[2] = { t1, t2 };
+  return TermList(Term::create(f, 2, args));
+}
+
+static TermList g(TermList t)
+{
+  static unsigned g = TestUtils::addFunction("ks_g", 1);
+  return TermList(Term::create(g, 1, &t));
+}
+
+static TermList a()
+{
+  static unsigned a = TestUtils::addFunction("ks_a", 0);
+  return TermList(Term::createConstant(a));
+}
+
+static TermList x(unsigned var)
+{
+  return TermList(var, false);
+}
+
+/**
+ * Terms with different variable masks or with a ground lighter one are
+ * compared without traversal, the others are traversed, including those
+ * whose variables differ only in numbers equal modulo 32
+ */
+TEST_FUN(decisionsWithoutTraversal)
+{
+  TermList fx0a = f(x(0),a());
+  TermList gx32 = g(x(32));
+  TermList fx0x0 = f(x(0),x(0));
+  TermList gx1 = g(x(1));
+  TermList fga = f(g(a()),a());
+  TermList ga = g(a());
+  TermList fx0x1 = f(x(0),x(1));
+  TermList ggx0 = g(g(x(0)));
+
+  ASS_EQ(gx32.term()->varMask(), fx0a.term()->varMask());
+  ASS_EQ(fx0x1.term()->varMask(), Term::varMaskBit(0) | Term::varMaskBit(1));
+
+  Problem prb;
+  Options opt;
+  opt.set("ordering_cache_bits", "0");
+  KBO kbo(prb, opt);
+
+  size_t decided = env.statistics->kboComparisonsWithoutTraversal;
+  ASS_EQ(kbo.compare(fx0x0, gx1), Ordering::INCOMPARABLE);
+  ASS_EQ(kbo.compare(fga, ga), Ordering::GREATER);
+  ASS_EQ(kbo.compare(ga, fga), Ordering::LESS);
+  ASS_EQ(kbo.compare(fx0x1, ga), Ordering::GREATER);
+  ASS_EQ(env.statistics->kboComparisonsWithoutTraversal, decided+4);
+
+  ASS_EQ(kbo.compare(fx0a, gx32), Ordering::INCOMPARABLE);
+  ASS_EQ(kbo.compare(fx0x1, f(x(1),x(0))), Ordering::INCOMPARABLE);
+  ASS_EQ(kbo.compare(f(x(0),g(x(1))), ggx0), Ordering::GREATER);
+  ASS_EQ(env.statistics->kboComparisonsWithoutTraversal, decided+4);
+}
@@ -0,0 +1,140 @@
+/*
+ * File tLiteralBatchQueries.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include <chrono>
+
+#include "Lib/DArray.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Indexing/LiteralSubstitutionTree.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID literalBatchQueries
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+/** Random literal with p/2, q/1, the proposition r or equality */
+static Literal* randomLiteral(unsigned depth)
+{
+  static unsigned p = TestUtils::addPredicate("p", 2);
+  static unsigned q = TestUtils::addPredicate("q", 1);
+  static unsigned r = TestUtils::addPredicate("r", 0);
+
+  TermList args[2] = { TestUtils::randomTerm(depth), TestUtils::randomTerm(depth) };
+  bool polarity = Random::getInteger(2);
+  switch (Random::getInteger(8)) {
+  case 0:
+    return Literal::create(r, 0, polarity, false, args);
+  case 1:
+    return Literal::createEquality(polarity, args[0], args[1], Sorts::SRT_DEFAULT);
+  case 2:
+  case 3:
+    return Literal::create(q, 1, polarity, false, args);
+  default:
+    return Literal::create(p, 2, polarity, false, args);
+  }
+}
+
+static Clause* randomClause(unsigned length, unsigned depth)
+{
+  Clause* cl = new(length) Clause(length, NonspecificInference0(UnitInputType::AXIOM, InferenceRule::INPUT));
+  for (unsigned i = 0; i < length; i++) {
+    (*cl)[i] = randomLiteral(depth);
+  }
+  return cl;
+}
+
+static long long now()
+{
+  return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TEST_FUN(batchGeneralizations)
+{
+  Random::setSeed(3);
+
+  LiteralSubstitutionTree index;
+  Stack<Clause*> indexed;
+  for (unsigned i = 0; i < 5000; i++) {
+    Clause* cl = randomClause(1+Random::getInteger(3), 3);
+    for (unsigned j = 0; j < cl->length(); j++) {
+      index.insert((*cl)[j], cl);
+    }
+    indexed.push(cl);
+  }
+  Stack<Clause*> queries;
+  for (unsigned i = 0; i < 1000; i++) {
+    queries.push(randomClause(2+Random::getInteger(5), 2));
+  }
+
+  DArray<Stack<SLQueryResult> > results;
+  long long singleTime = 0, batchTime = 0;
+  unsigned resultCnt = 0;
+  for (unsigned complementary = 0; complementary < 2; complementary++) {
+    for (unsigned i = 0; i < queries.size(); i++) {
+      Clause* cl = queries[i];
+      Stack<SLQueryResult> single;
+      long long start = now();
+      for (unsigned j = 0; j < cl->length(); j++) {
+        single.loadFromIterator(index.getGeneralizations((*cl)[j], complementary, false));
+      }
+      singleTime += now()-start;
+
+      start = now();
+      index.getGeneralizations(cl, complementary, results);
+      batchTime += now()-start;
+
+      ASS_EQ(results.size(), cl->length());
+      unsigned pos = 0;
+      for (unsigned j = 0; j < cl->length(); j++) {
+        for (unsigned k = 0; k < results[j].size(); k++) {
+          ASS_L(pos, single.size());
+          ASS_EQ(results[j][k].clause, single[pos].clause);
+          ASS_EQ(results[j][k].literal, single[pos].literal);
+          pos++;
+        }
+      }
+      ASS_EQ(pos, single.size());
+      resultCnt += pos;
+    }
+  }
+
+  ASS_G(resultCnt, 0);
+  cout << endl << "literal substitution tree: " << resultCnt << " generalizations, single " << singleTime
+       << " us, batch " << batchTime << " us" << endl;
+
+  for (unsigned i = 0; i < indexed.size(); i++) {
+    Clause* cl = indexed[i];
+    for (unsigned j = 0; j < cl->length(); j++) {
+      index.remove((*cl)[j], cl);
+    }
+  }
+}
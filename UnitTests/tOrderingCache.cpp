@@ -0,0 +1,106 @@
+/*
+ * File tOrderingCache.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Kernel/KBO.hpp"
+#include "Kernel/LPO.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID orderingCache
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Shell;
+using namespace Test;
+
+/**
+ * All terms of depth at most 3 built from oc_f, oc_g, oc_a and two
+ * variables, with the arguments of oc_f limited to keep their number small
+ */
+static void makeTerms(Stack<TermList>& terms)
+{
+  unsigned f = TestUtils::addFunction("oc_f", 2);
+  unsigned g = TestUtils::addFunction("oc_g", 1);
+  unsigned a = TestUtils::addFunction("oc_a", 0);
+
+  terms.push(TermList(0, false));
+  terms.push(TermList(1, false));
+  terms.push(TermList(Term::createConstant(a)));
+  for(unsigned depth=0;depth<2;depth++) {
+    unsigned cnt = terms.size();
+    for(unsigned i=0;i<cnt;i++) {
+      TermList gArg = terms[i];
+      terms.push(TermList(Term::create(g, 1, &gArg)));
+      for(unsigned j=0;j<cnt && j<6;j++) {
+        TermList fArgs[2] = { terms[i], terms[j] };
+        terms.push(TermList(Term::create(f, 2, fArgs)));
+      }
+    }
+  }
+}
+
+/**
+ * An ordering with a small cache, so that comparisons replace one another
+ * in it, gives the same results as one without a cache
+ */
+static void checkCachedOrdering(bool lpo)
+{
+  Stack<TermList> terms;
+  makeTerms(terms);
+
+  Problem prb;
+  Options uncachedOpt;
+  uncachedOpt.set("ordering_cache_bits", "0");
+  Options cachedOpt;
+  cachedOpt.set("ordering_cache_bits", "6");
+  ScopedPtr<Ordering> uncached(lpo ? static_cast<Ordering*>(new LPO(prb, uncachedOpt)) : new KBO(prb, uncachedOpt));
+  ScopedPtr<Ordering> cached(lpo ? static_cast<Ordering*>(new LPO(prb, cachedOpt)) : new KBO(prb, cachedOpt));
+
+  size_t hits = env.statistics->orderingCacheHits;
+  for(unsigned round=0;round<2;round++) {
+    for(unsigned i=0;i<terms.size();i++) {
+      for(unsigned j=0;j<terms.size();j+=1+i%3) {
+        ASS_EQ(cached->compare(terms[i], terms[j]), uncached->compare(terms[i], terms[j]));
+        ASS_EQ(cached->compare(terms[j], terms[i]), uncached->compare(terms[j], terms[i]));
+      }
+    }
+  }
+  ASS_G(env.statistics->orderingCacheHits, hits);
+}
+
+TEST_FUN(kboCache)
+{
+  checkCachedOrdering(false);
+}
+
+TEST_FUN(lpoCache)
+{
+  checkCachedOrdering(true);
+}
@@ -0,0 +1,146 @@
+/*
+ * File tTermGarbageCollection.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+
+#include "Lib/Environment.hpp"
+
+#include "Kernel/Term.hpp"
+
+#include "Indexing/TermSharing.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "Test/TestUtils.hpp"
+#include "Test/UnitTesting.hpp"
+
+#define UNIT_ID termGarbageCollection
+UT_CREATE;
+
+using namespace std;
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Test;
+
+static TermList f(TermList t1, TermList t2)
+{
+  static unsigned f = TestUtils::addFunction("gc_f", 2);
+  TermList args[2] = { t1, t2 };
+  return TermList(Term::create(f, 2, args));
+}
+
+static TermList g(TermList t)
+{
+  static unsigned g = TestUtils::addFunction("gc_g", 1);
+  return TermList(Term::create(g, 1, &t));
+}
+
+static TermList h(TermList t)
+{
+  static unsigned h = TestUtils::addFunction("gc_h", 1);
+  return TermList(Term::create(h, 1, &t));
+}
+
+static TermList a()
+{
+  static unsigned a = TestUtils::addFunction("gc_a", 0);
+  return TermList(Term::createConstant(a));
+}
+
+static Literal* p(TermList t)
+{
+  static unsigned p = TestUtils::addPredicate("gc_p", 1);
+  return Literal::create(p, 1, true, false, &t);
+}
+
+static Literal* q(TermList t)
+{
+  static unsigned q = TestUtils::addPredicate("gc_q", 1);
+  return Literal::create(q, 1, true, false, &t);
+}
+
+/**
+ * Of the terms made after the garbage collection starts, those that are
+ * neither marked nor pinned nor constants are freed, and the marks are
+ * cleared by the collection
+ */
+TEST_FUN(markedAndPinnedTermsSurvive)
+{
+  a();
+  env.sharing->startGarbageCollection();
+
+  Term* marked = g(f(a(),a())).term();
+  Literal* pinned = p(f(g(a()),a()));
+  env.sharing->pin(pinned);
+  f(g(g(a())),a());
+  q(g(g(g(a()))));
+
+  size_t freedTerms = env.statistics->termGcFreedTerms;
+  size_t freedLiterals = env.statistics->termGcFreedLiterals;
+  unsigned collections = env.statistics->termGcCollections;
+
+  env.sharing->mark(marked);
+  env.sharing->collectGarbage();
+
+  //g(g(a)), f(g(g(a)),a) and g(g(g(a))) with q(g(g(g(a))))
+  ASS_EQ(env.statistics->termGcCollections, collections+1);
+  ASS_EQ(env.statistics->termGcFreedTerms, freedTerms+3);
+  ASS_EQ(env.statistics->termGcFreedLiterals, freedLiterals+1);
+  ASS_EQ(g(f(a(),a())).term(), marked);
+  ASS_EQ(p(f(g(a()),a())), pinned);
+
+  //the freed terms can be made again
+  Term* remade = f(g(g(a())),a()).term();
+  ASS(remade->shared());
+  ASS_EQ(f(g(g(a())),a()).term(), remade);
+
+  //unmarked now, so g(f(a,a)) and f(a,a) go together with the remade terms
+  env.sharing->collectGarbage();
+  ASS_EQ(env.statistics->termGcFreedTerms, freedTerms+3+4);
+  ASS_EQ(env.statistics->termGcFreedLiterals, freedLiterals+1);
+  ASS_EQ(p(f(g(a()),a())), pinned);
+}
+
+/**
+ * A retained literal survives the collections until it is released as
+ * many times as it was retained
+ */
+TEST_FUN(retainedTermsSurviveUntilReleased)
+{
+  a();
+  env.sharing->startGarbageCollection();
+
+  Literal* retained = q(h(h(a())));
+  env.sharing->retain(retained);
+  env.sharing->retain(retained);
+
+  size_t freedTerms = env.statistics->termGcFreedTerms;
+  size_t freedLiterals = env.statistics->termGcFreedLiterals;
+
+  env.sharing->collectGarbage();
+  env.sharing->release(retained);
+  env.sharing->collectGarbage();
+  ASS_EQ(env.statistics->termGcFreedTerms, freedTerms);
+  ASS_EQ(env.statistics->termGcFreedLiterals, freedLiterals);
+  ASS_EQ(q(h(h(a()))), retained);
+
+  //h(a), h(h(a)) and q(h(h(a)))
+  env.sharing->release(retained);
+  env.sharing->collectGarbage();
+  ASS_EQ(env.statistics->termGcFreedTerms, freedTerms+2);
+  ASS_EQ(env.statistics->termGcFreedLiterals, freedLiterals+1);
+}
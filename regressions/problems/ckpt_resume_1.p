@@ -0,0 +1,18 @@
+% res: unsat
+
+% A checkpoint written after the sixth selection on the problem of
+% ckpt_write_1.p (with --checkpoint_interval 0 -al 6), from which the
+% proof search is resumed.
+
+tff(c34, axiom, ![X3,X4,X5]: (mult(X3,mult(X4,mult(X3,mult(X4,X5)))) = X5)).
+tff(c28, axiom, ![X3,X4,X5]: (mult(mult(X3,X4),mult(X3,mult(X4,X5))) = X5)).
+tff(c19, axiom, ![X0,X1]: (e = mult(X0,mult(X1,mult(X0,X1))))).
+tff(c22, axiom, ![X4,X5]: (mult(inv(X4),mult(X4,X5)) = X5)).
+tff(c27, axiom, ![X2]: (mult(inv(X2),e) = X2)).
+tff(c26, axiom, ![X1]: (mult(X1,e) = X1)).
+tff(c12, axiom, ![X0]: (e = mult(inv(X0),X0))).
+tff(c13, axiom, ![X0]: (e = mult(X0,X0))).
+tff(c21, axiom, ![X2,X3]: (mult(X2,mult(X2,X3)) = X3)).
+tff(c10, axiom, ![X0,X1,X2]: (mult(mult(X0,X1),X2) = mult(X0,mult(X1,X2)))).
+tff(c11, axiom, ![X0]: (mult(e,X0) = X0)).
+tff(c14, negated_conjecture, mult(sK0,sK1) != mult(sK1,sK0)).
@@ -0,0 +1,12 @@
+% params: --checkpoint_file /tmp/vampire_ckpt_write_1.p --checkpoint_interval 0 -stat full
+% res: unsat
+% grep: Checkpoints written
+
+% A checkpoint is written after every clause selection and the proof
+% search goes on as without them.
+
+fof(a1,axiom,![X,Y,Z]:(mult(mult(X,Y),Z)=mult(X,mult(Y,Z)))).
+fof(a2,axiom,![X]:(mult(e,X)=X)).
+fof(a3,axiom,![X]:(mult(inv(X),X)=e)).
+fof(a4,axiom,![X]:(mult(X,X)=e)).
+fof(c,conjecture,![X,Y]:(mult(X,Y)=mult(Y,X))).
@@ -0,0 +1,11 @@
+% params: -p off -rdc on
+% res: unsat
+
+% Reclaiming the premises of passive clauses used to cut the derivation
+% of the empty clause from the input, so the refutation was rejected.
+
+fof(a1,axiom,![X,Y,Z]:(mult(mult(X,Y),Z)=mult(X,mult(Y,Z)))).
+fof(a2,axiom,![X]:(mult(e,X)=X)).
+fof(a3,axiom,![X]:(mult(inv(X),X)=e)).
+fof(a4,axiom,![X]:(mult(X,X)=e)).
+fof(c,conjecture,![X,Y]:(mult(X,Y)=mult(Y,X))).
@@ -0,0 +1,14 @@
+% params: -sgc on -av on
+% res: unsat
+
+% Sorting the generated clauses cached their weights before AVATAR
+% assigned their split sets, which violated an assertion of
+% Clause::setSplits() in debug builds.
+
+fof(a1,axiom,![X,Y,Z]:(mult(mult(X,Y),Z)=mult(X,mult(Y,Z)))).
+fof(a2,axiom,![X]:(mult(e,X)=X)).
+fof(a3,axiom,![X]:(mult(inv(X),X)=e)).
+fof(a4,axiom,![X]:(mult(X,X)=e)).
+fof(a5,axiom,![X,Y]:(p(X)|q(Y)|r(mult(X,Y)))).
+fof(a6,axiom,![X]:(~p(X)|r(inv(X)))).
+fof(c,conjecture,![X,Y,Z]:(mult(X,mult(Y,Z))=mult(Z,mult(Y,X)))).
@@ -0,0 +1,14 @@
+% params: -sa discount -p off -tgc 1 --passive_spill_budget 20 -stat full
+% res: unsat
+% grep: Term garbage collections
+
+% The term garbage collection used to free the literals of passive
+% clauses spilled to disk.
+
+fof(a1,axiom,![X,Y,Z]:(mult(mult(X,Y),Z)=mult(X,mult(Y,Z)))).
+fof(a2,axiom,![X]:(mult(e,X)=X)).
+fof(a3,axiom,![X]:(mult(inv(X),X)=e)).
+fof(a4,axiom,![X]:(mult(X,X)=e)).
+fof(a5,axiom,![X,Y]:(p(X)|q(Y)|r(mult(X,Y)))).
+fof(a6,axiom,![X]:(~p(X)|r(inv(X)))).
+fof(c,conjecture,![X,Y,Z]:(mult(X,mult(Y,Z))=mult(Z,mult(Y,X)))).
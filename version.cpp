@@ -0,0 +1,2 @@
+//Automatically generated file, see Makefile for details
+const char* VERSION_STRING = "Vampire 4.5.0 (commit 915af14 on 2026-10-16 12:26:20 +0000)";